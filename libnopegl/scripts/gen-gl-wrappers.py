@@ -35,6 +35,10 @@ cmds_optional = [
     "glBindBufferBase",
     "glBindBufferRange",
     "glBufferStorage",
+    # Program binary
+    "glGetProgramBinary",
+    "glProgramBinary",
+    "glProgramParameteri",
     # Compute shaders
     "glDispatchCompute",
     # Shaders
@@ -214,6 +218,7 @@ cmds = [
     "glFenceSync",
     "glWaitSync",
     "glClientWaitSync",
+    "glDeleteSync",
     # Read/Draw Buffer
     "glReadBuffer",
     "glDrawBuffer",
@@ -25,27 +25,22 @@
 #include "math_utils.h"
 #include "nopegl.h"
 #include "internal.h"
+#include "timeindex.h"
 
-static size_t get_kf_id(struct ngl_node * const *animkf, size_t nb_animkf, size_t start, double t)
+static size_t get_kf_id(struct ngl_node * const *animkf, size_t nb_animkf, size_t hint, double t)
 {
-    size_t ret = SIZE_MAX;
-
-    for (size_t i = start; i < nb_animkf; i++) {
-        const struct animkeyframe_opts *kf = animkf[i]->opts;
-        if (kf->time > t)
-            break;
-        ret = i;
-    }
+#define KF_TIME(i) ((const struct animkeyframe_opts *)animkf[i]->opts)->time
+    size_t ret;
+    NGLI_TIMEINDEX_SEARCH(ret, KF_TIME, nb_animkf, hint, t);
     return ret;
+#undef KF_TIME
 }
 
 int ngli_animation_evaluate(struct animation *s, void *dst, double t)
 {
     struct ngl_node * const *animkf = s->kfs;
     const size_t nb_animkf = s->nb_kfs;
-    size_t kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id == SIZE_MAX)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const size_t kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id != SIZE_MAX && kf_id < nb_animkf - 1) {
         const struct animkeyframe_priv *kf1_priv = animkf[kf_id + 1]->priv_data;
         const struct animkeyframe_opts *kf0 = animkf[kf_id    ]->opts;
@@ -75,9 +70,7 @@ int ngli_animation_derivate(struct animation *s, void *dst, double t)
 {
     struct ngl_node * const *animkf = s->kfs;
     const size_t nb_animkf = s->nb_kfs;
-    size_t kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id == SIZE_MAX)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const size_t kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id != SIZE_MAX && kf_id < nb_animkf - 1) {
         const struct animkeyframe_priv *kf1_priv = animkf[kf_id + 1]->priv_data;
         const struct animkeyframe_opts *kf0 = animkf[kf_id    ]->opts;
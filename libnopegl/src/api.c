@@ -121,6 +121,7 @@ static void reset_scene(struct ngl_ctx *s, int action)
         if (action == NGLI_ACTION_UNREF_SCENE)
             ngl_scene_freep(&s->scene);
     }
+    ngli_drawlist_reset(&s->drawlist);
     ngli_rnode_reset(&s->rnode);
 }
 
@@ -145,6 +146,7 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
     s->rnode_pos = &s->rnode;
     s->rnode_pos->graphics_state = NGLI_GRAPHICS_STATE_DEFAULTS;
     s->rnode_pos->rendertarget_layout = *ngli_gpu_ctx_get_default_rendertarget_layout(s->gpu_ctx);
+    ngli_drawlist_init(&s->drawlist, s);
 
     if (scene) {
         if (!scene->root) {
@@ -153,7 +155,7 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
             goto fail;
         }
 
-        int ret = ngli_node_attach_ctx(scene->root, s);
+        ret = ngli_node_attach_ctx(scene->root, s);
         if (ret < 0) {
             ngli_node_detach_ctx(scene->root, s);
             return ret;
@@ -163,6 +165,10 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
             ret = NGL_ERROR_MEMORY;
             goto fail;
         }
+
+        ret = ngli_drawlist_record(&s->drawlist, scene->root);
+        if (ret < 0)
+            goto fail;
     }
 
     const struct ngl_config *config = &s->config;
@@ -198,7 +204,11 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
 #endif
     ngli_atlas_freep(&s->font_atlas); // allocated by the first node text
     memset(s->char_map, 0, sizeof(s->char_map));
+    ngli_glyphcache_freep(&s->glyphcache); // allocated by the first external text
+    ngli_glyphcache_freep(&s->sdf_glyphcache); // allocated by the first distance field text
+    ngli_texturepool_freep(&s->transient_textures); // allocated by the first render to texture
     ngli_pgcache_reset(&s->pgcache);
+    ngli_threadpool_freep(&s->update_pool);
     ngli_gpu_ctx_freep(&s->gpu_ctx);
     ngli_config_reset(&s->config);
 }
@@ -227,6 +237,20 @@ int ngli_ctx_configure(struct ngl_ctx *s, const struct ngl_config *config)
     if (ret < 0)
         goto fail;
 
+    if (config->nb_update_threads < 0) {
+        LOG(ERROR, "invalid number of update threads: %d", config->nb_update_threads);
+        ret = NGL_ERROR_INVALID_ARG;
+        goto fail;
+    }
+
+    if (config->nb_update_threads > 1) {
+        s->update_pool = ngli_threadpool_create(config->nb_update_threads);
+        if (!s->update_pool) {
+            ret = NGL_ERROR_MEMORY;
+            goto fail;
+        }
+    }
+
 #if defined(HAVE_VAAPI)
     ret = ngli_vaapi_ctx_init(s->gpu_ctx, &s->vaapi_ctx);
     if (ret < 0)
@@ -288,6 +312,9 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
 {
     const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
 
+    ngli_glyphcache_collect(s->glyphcache);
+    ngli_glyphcache_collect(s->sdf_glyphcache);
+
     int ret = ngli_gpu_ctx_begin_update(s->gpu_ctx, t);
     if (ret < 0)
         return ret;
@@ -304,6 +331,12 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
+    if (s->update_pool) {
+        ret = ngli_node_update_prepare_parallel(s, t);
+        if (ret < 0)
+            return ret;
+    }
+
     ret = ngli_node_update(root, t);
     if (ret < 0)
         return ret;
@@ -317,7 +350,7 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     return 0;
 }
 
-int ngli_ctx_draw(struct ngl_ctx *s, double t)
+static int draw_scene(struct ngl_ctx *s, double t)
 {
     int ret = ngli_ctx_prepare_draw(s, t);
     if (ret < 0)
@@ -339,7 +372,7 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     struct ngl_scene *scene = s->scene;
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->root->label, t);
-        ngli_node_draw(scene->root);
+        ngli_drawlist_replay(&s->drawlist);
     }
 
     if (!s->render_pass_started) {
@@ -365,9 +398,38 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
         s->render_pass_started = 0;
     }
 
+    return 0;
+}
+
+int ngli_ctx_draw(struct ngl_ctx *s, double t)
+{
+    int ret = draw_scene(s, t);
+    if (ret < 0)
+        return ret;
+
     return ngli_gpu_ctx_end_draw(s->gpu_ctx, t);
 }
 
+int ngli_ctx_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp)
+{
+    const struct ngl_config *config = &s->config;
+    if (!config->offscreen || config->capture_buffer_type != NGL_CAPTURE_BUFFER_TYPE_CPU) {
+        LOG(ERROR, "asynchronous drawing requires an offscreen context with a CPU capture buffer type");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    int ret = draw_scene(s, t);
+    if (ret < 0)
+        return ret;
+
+    return ngli_gpu_ctx_end_draw_async(s->gpu_ctx, t, ticketp);
+}
+
+int ngli_ctx_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp)
+{
+    return ngli_gpu_ctx_capture_acquire(s->gpu_ctx, ticket, bufp);
+}
+
 int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
 {
     pthread_mutex_lock(&s->lock);
@@ -595,6 +657,7 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->update_prepare_nodes, sizeof(struct ngl_node *), 0);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     if (!ngli_darray_push(&s->modelview_matrix_stack, id_matrix) ||
@@ -714,6 +777,57 @@ int ngl_draw(struct ngl_ctx *s, double t)
     return s->api_impl->draw(s, t);
 }
 
+int ngl_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return s->api_impl->draw_async(s, t, ticketp);
+}
+
+int ngl_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before acquiring a capture");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return s->api_impl->capture_acquire(s, ticket, bufp);
+}
+
+struct timeline_hint {
+    double t0;
+    double dt;
+    int32_t nb_frames;
+};
+
+static int cmd_hint_timeline(struct ngl_ctx *s, void *arg)
+{
+    const struct timeline_hint *hint = arg;
+    s->hint_t0 = hint->t0;
+    s->hint_dt = hint->dt;
+    s->hint_nb_frames = hint->nb_frames;
+    return 0;
+}
+
+int ngl_hint_timeline(struct ngl_ctx *s, double t0, double dt, int32_t nb_frames)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before hinting the timeline");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (nb_frames < 0 || (nb_frames && !(dt > 0.))) {
+        LOG(ERROR, "invalid timeline hint: %d frames every %g seconds", nb_frames, dt);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    struct timeline_hint hint = {.t0 = t0, .dt = dt, .nb_frames = nb_frames};
+    return ngli_ctx_dispatch_cmd(s, cmd_hint_timeline, &hint);
+}
+
 int ngl_gl_wrap_framebuffer(struct ngl_ctx *s, uint32_t framebuffer)
 {
     if (!s->configured) {
@@ -764,6 +878,7 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_darray_reset(&s->update_prepare_nodes);
     ngli_freep(ss);
 }
 
@@ -184,6 +184,58 @@ static int glw_draw(struct ngl_ctx *s, double t)
     return ret;
 }
 
+struct draw_async_params {
+    double t;
+    uint64_t *ticketp;
+};
+
+static int cmd_draw_async(struct ngl_ctx *s, void *arg)
+{
+    const struct draw_async_params *params = arg;
+    return ngli_ctx_draw_async(s, params->t, params->ticketp);
+}
+
+static int gl_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp)
+{
+    struct draw_async_params params = {
+        .t = t,
+        .ticketp = ticketp,
+    };
+    return ngli_ctx_dispatch_cmd(s, cmd_draw_async, &params);
+}
+
+static int glw_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp)
+{
+    LOG(ERROR, "asynchronous drawing is not supported by external OpenGL context");
+    return NGL_ERROR_UNSUPPORTED;
+}
+
+struct capture_acquire_params {
+    uint64_t ticket;
+    const uint8_t **bufp;
+};
+
+static int cmd_capture_acquire(struct ngl_ctx *s, void *arg)
+{
+    const struct capture_acquire_params *params = arg;
+    return ngli_ctx_capture_acquire(s, params->ticket, params->bufp);
+}
+
+static int gl_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp)
+{
+    struct capture_acquire_params params = {
+        .ticket = ticket,
+        .bufp = bufp,
+    };
+    return ngli_ctx_dispatch_cmd(s, cmd_capture_acquire, &params);
+}
+
+static int glw_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp)
+{
+    LOG(ERROR, "capture acquisition is not supported by external OpenGL context");
+    return NGL_ERROR_UNSUPPORTED;
+}
+
 static int cmd_reset(struct ngl_ctx *s, void *arg)
 {
     const int action = *(int *)arg;
@@ -258,6 +310,16 @@ static int glv_draw(struct ngl_ctx *s, double t)
     return is_glw(&s->config) ? glw_draw(s, t) : gl_draw(s, t);
 }
 
+static int glv_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp)
+{
+    return is_glw(&s->config) ? glw_draw_async(s, t, ticketp) : gl_draw_async(s, t, ticketp);
+}
+
+static int glv_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp)
+{
+    return is_glw(&s->config) ? glw_capture_acquire(s, ticket, bufp) : gl_capture_acquire(s, ticket, bufp);
+}
+
 static void glv_reset(struct ngl_ctx *s, int action)
 {
     is_glw(&s->config) ? glw_reset(s, action) : gl_reset(s, action);
@@ -275,6 +337,8 @@ const struct api_impl api_gl = {
     .set_scene           = glv_set_scene,
     .prepare_draw        = glv_prepare_draw,
     .draw                = glv_draw,
+    .draw_async          = glv_draw_async,
+    .capture_acquire     = glv_capture_acquire,
     .reset               = glv_reset,
     .gl_wrap_framebuffer = glv_wrap_framebuffer,
 };
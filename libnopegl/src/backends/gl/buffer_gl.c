@@ -138,6 +138,7 @@ void ngli_buffer_gl_freep(struct buffer **sp)
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
     struct buffer_gl *s_priv = (struct buffer_gl *)s;
+    ngli_glstate_invalidate_buffer(&gpu_ctx_gl->glstate, s_priv->id);
     ngli_glDeleteBuffers(gl, 1, &s_priv->id);
     ngli_freep(sp);
 }
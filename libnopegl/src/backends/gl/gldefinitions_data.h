@@ -54,6 +54,7 @@ static const struct gldefinition {
     {"glDeleteQueriesEXT", offsetof(struct glfunctions, DeleteQueriesEXT), 0},
     {"glDeleteRenderbuffers", offsetof(struct glfunctions, DeleteRenderbuffers), M},
     {"glDeleteShader", offsetof(struct glfunctions, DeleteShader), M},
+    {"glDeleteSync", offsetof(struct glfunctions, DeleteSync), M},
     {"glDeleteTextures", offsetof(struct glfunctions, DeleteTextures), M},
     {"glDeleteVertexArrays", offsetof(struct glfunctions, DeleteVertexArrays), M},
     {"glDepthFunc", offsetof(struct glfunctions, DepthFunc), M},
@@ -100,6 +101,7 @@ static const struct gldefinition {
     {"glGetIntegeri_v", offsetof(struct glfunctions, GetIntegeri_v), M},
     {"glGetIntegerv", offsetof(struct glfunctions, GetIntegerv), M},
     {"glGetInternalformativ", offsetof(struct glfunctions, GetInternalformativ), 0},
+    {"glGetProgramBinary", offsetof(struct glfunctions, GetProgramBinary), 0},
     {"glGetProgramInfoLog", offsetof(struct glfunctions, GetProgramInfoLog), M},
     {"glGetProgramInterfaceiv", offsetof(struct glfunctions, GetProgramInterfaceiv), 0},
     {"glGetProgramResourceIndex", offsetof(struct glfunctions, GetProgramResourceIndex), 0},
@@ -124,6 +126,8 @@ static const struct gldefinition {
     {"glMemoryBarrier", offsetof(struct glfunctions, MemoryBarrier), 0},
     {"glPixelStorei", offsetof(struct glfunctions, PixelStorei), M},
     {"glPolygonMode", offsetof(struct glfunctions, PolygonMode), 0},
+    {"glProgramBinary", offsetof(struct glfunctions, ProgramBinary), 0},
+    {"glProgramParameteri", offsetof(struct glfunctions, ProgramParameteri), 0},
     {"glQueryCounter", offsetof(struct glfunctions, QueryCounter), 0},
     {"glQueryCounterEXT", offsetof(struct glfunctions, QueryCounterEXT), 0},
     {"glReadBuffer", offsetof(struct glfunctions, ReadBuffer), M},
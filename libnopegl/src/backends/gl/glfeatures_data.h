@@ -171,5 +171,15 @@ static const struct glfeature {
         .extensions     = (const char*[]){"GL_ARB_buffer_storage", NULL},
         .funcs_offsets  = (const size_t[]){OFFSET(BufferStorage),
                                            -1}
+    }, {
+        .name           = "get_program_binary",
+        .flag           = NGLI_FEATURE_GL_GET_PROGRAM_BINARY,
+        .version        = 410,
+        .es_version     = 300,
+        .extensions     = (const char*[]){"GL_ARB_get_program_binary", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(GetProgramBinary),
+                                           OFFSET(ProgramBinary),
+                                           OFFSET(ProgramParameteri),
+                                           -1}
     },
 };
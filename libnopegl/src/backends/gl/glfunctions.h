@@ -47,6 +47,7 @@ struct glfunctions {
     void (NGLI_GL_APIENTRY *DeleteQueriesEXT)(GLsizei n, const GLuint * ids);
     void (NGLI_GL_APIENTRY *DeleteRenderbuffers)(GLsizei n, const GLuint * renderbuffers);
     void (NGLI_GL_APIENTRY *DeleteShader)(GLuint shader);
+    void (NGLI_GL_APIENTRY *DeleteSync)(GLsync sync);
     void (NGLI_GL_APIENTRY *DeleteTextures)(GLsizei n, const GLuint * textures);
     void (NGLI_GL_APIENTRY *DeleteVertexArrays)(GLsizei n, const GLuint * arrays);
     void (NGLI_GL_APIENTRY *DepthFunc)(GLenum func);
@@ -93,6 +94,7 @@ struct glfunctions {
     void (NGLI_GL_APIENTRY *GetIntegeri_v)(GLenum target, GLuint index, GLint * data);
     void (NGLI_GL_APIENTRY *GetIntegerv)(GLenum pname, GLint * data);
     void (NGLI_GL_APIENTRY *GetInternalformativ)(GLenum target, GLenum internalformat, GLenum pname, GLsizei count, GLint * params);
+    void (NGLI_GL_APIENTRY *GetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary);
     void (NGLI_GL_APIENTRY *GetProgramInfoLog)(GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
     void (NGLI_GL_APIENTRY *GetProgramInterfaceiv)(GLuint program, GLenum programInterface, GLenum pname, GLint * params);
     GLuint (NGLI_GL_APIENTRY *GetProgramResourceIndex)(GLuint program, GLenum programInterface, const GLchar * name);
@@ -117,6 +119,8 @@ struct glfunctions {
     void (NGLI_GL_APIENTRY *MemoryBarrier)(GLbitfield barriers);
     void (NGLI_GL_APIENTRY *PixelStorei)(GLenum pname, GLint param);
     void (NGLI_GL_APIENTRY *PolygonMode)(GLenum face, GLenum mode);
+    void (NGLI_GL_APIENTRY *ProgramBinary)(GLuint program, GLenum binaryFormat, const void * binary, GLsizei length);
+    void (NGLI_GL_APIENTRY *ProgramParameteri)(GLuint program, GLenum pname, GLint value);
     void (NGLI_GL_APIENTRY *QueryCounter)(GLuint id, GLenum target);
     void (NGLI_GL_APIENTRY *QueryCounterEXT)(GLuint id, GLenum target);
     void (NGLI_GL_APIENTRY *ReadBuffer)(GLenum src);
@@ -105,7 +105,13 @@ static GLenum get_gl_cull_mode(int cull_mode)
 
 void ngli_glstate_reset(const struct glcontext *gl, struct glstate *glstate)
 {
+    /*
+     * The resource bindings are left untouched and only marked as unknown:
+     * they are restored lazily by the next draw or dispatch
+     */
+    const uint64_t vertex_array_epoch = glstate->vertex_array_epoch;
     memset(glstate, 0, sizeof(*glstate));
+    glstate->vertex_array_epoch = vertex_array_epoch + 1;
 
     /* Blending */
     ngli_glDisable(gl, GL_BLEND);
@@ -174,6 +180,7 @@ void ngli_glstate_reset(const struct glcontext *gl, struct glstate *glstate)
 
     /* VAO */
     ngli_glBindVertexArray(gl, 0);
+    glstate->vertex_array_id = 0;
 }
 
 void ngli_glstate_update(const struct glcontext *gl, struct glstate *glstate, const struct graphics_state *state)
@@ -349,3 +356,144 @@ void ngli_glstate_update_viewport(const struct glcontext *gl, struct glstate *gl
     memcpy(glstate->viewport, viewport, sizeof(glstate->viewport));
     ngli_glViewport(gl, viewport->x, viewport->y, viewport->width, viewport->height);
 }
+
+static int get_texture_target_index(GLenum target)
+{
+    switch (target) {
+    case GL_TEXTURE_2D:           return NGLI_GLSTATE_TEXTURE_TARGET_2D;
+    case GL_TEXTURE_2D_ARRAY:     return NGLI_GLSTATE_TEXTURE_TARGET_2D_ARRAY;
+    case GL_TEXTURE_3D:           return NGLI_GLSTATE_TEXTURE_TARGET_3D;
+    case GL_TEXTURE_CUBE_MAP:     return NGLI_GLSTATE_TEXTURE_TARGET_CUBE_MAP;
+    case GL_TEXTURE_EXTERNAL_OES: return NGLI_GLSTATE_TEXTURE_TARGET_EXTERNAL_OES;
+    default:                      return -1;
+    }
+}
+
+void ngli_glstate_bind_texture(const struct glcontext *gl, struct glstate *glstate, GLenum target, GLuint id)
+{
+    const GLuint unit = glstate->active_texture - GL_TEXTURE0;
+    const int index = get_texture_target_index(target);
+    if (!glstate->active_texture || unit >= NGLI_GLSTATE_MAX_TEXTURE_UNITS || index < 0) {
+        ngli_glBindTexture(gl, target, id);
+        return;
+    }
+
+    struct glstate_texture_unit *texture_unit = &glstate->texture_units[unit];
+    const uint32_t bit = 1U << index;
+    if ((texture_unit->valid_mask & bit) && texture_unit->ids[index] == id)
+        return;
+    ngli_glBindTexture(gl, target, id);
+    texture_unit->valid_mask |= bit;
+    texture_unit->ids[index] = id;
+}
+
+void ngli_glstate_bind_texture_unit(const struct glcontext *gl, struct glstate *glstate, GLuint unit, GLenum target, GLuint id)
+{
+    const int index = get_texture_target_index(target);
+    if (unit < NGLI_GLSTATE_MAX_TEXTURE_UNITS && index >= 0) {
+        const struct glstate_texture_unit *texture_unit = &glstate->texture_units[unit];
+        if ((texture_unit->valid_mask & (1U << index)) && texture_unit->ids[index] == id)
+            return;
+    }
+
+    const GLenum active_texture = GL_TEXTURE0 + unit;
+    if (glstate->active_texture != active_texture) {
+        ngli_glActiveTexture(gl, active_texture);
+        glstate->active_texture = active_texture;
+    }
+    ngli_glstate_bind_texture(gl, glstate, target, id);
+}
+
+void ngli_glstate_bind_image_texture(const struct glcontext *gl, struct glstate *glstate, GLuint unit, GLuint id,
+                                     GLboolean layered, GLenum access, GLenum internal_format)
+{
+    if (unit >= NGLI_GLSTATE_MAX_IMAGE_UNITS) {
+        ngli_glBindImageTexture(gl, unit, id, 0, layered, 0, access, internal_format);
+        return;
+    }
+
+    struct glstate_image_unit *image_unit = &glstate->image_units[unit];
+    if (image_unit->valid &&
+        image_unit->id == id &&
+        image_unit->layered == layered &&
+        image_unit->access == access &&
+        image_unit->internal_format == internal_format)
+        return;
+    ngli_glBindImageTexture(gl, unit, id, 0, layered, 0, access, internal_format);
+    *image_unit = (struct glstate_image_unit){
+        .valid           = 1,
+        .id              = id,
+        .layered         = layered,
+        .access          = access,
+        .internal_format = internal_format,
+    };
+}
+
+static struct glstate_buffer_binding *get_buffer_binding(struct glstate *glstate, GLenum target, GLuint index)
+{
+    if (index >= NGLI_GLSTATE_MAX_BUFFER_BINDINGS)
+        return NULL;
+    if (target == GL_UNIFORM_BUFFER)
+        return &glstate->uniform_buffers[index];
+    if (target == GL_SHADER_STORAGE_BUFFER)
+        return &glstate->storage_buffers[index];
+    return NULL;
+}
+
+void ngli_glstate_bind_buffer_range(const struct glcontext *gl, struct glstate *glstate, GLenum target, GLuint index,
+                                    GLuint id, GLintptr offset, GLsizeiptr size)
+{
+    struct glstate_buffer_binding *binding = get_buffer_binding(glstate, target, index);
+    if (binding && binding->valid && binding->id == id && binding->offset == offset && binding->size == size)
+        return;
+    ngli_glBindBufferRange(gl, target, index, id, offset, size);
+    if (binding)
+        *binding = (struct glstate_buffer_binding){.valid = 1, .id = id, .offset = offset, .size = size};
+}
+
+void ngli_glstate_bind_vertex_array(const struct glcontext *gl, struct glstate *glstate, GLuint id)
+{
+    if (glstate->vertex_array_id != id) {
+        ngli_glBindVertexArray(gl, id);
+        glstate->vertex_array_id = id;
+    }
+}
+
+void ngli_glstate_invalidate_texture(struct glstate *glstate, GLuint id)
+{
+    for (size_t i = 0; i < NGLI_ARRAY_NB(glstate->texture_units); i++) {
+        struct glstate_texture_unit *texture_unit = &glstate->texture_units[i];
+        for (size_t j = 0; j < NGLI_ARRAY_NB(texture_unit->ids); j++) {
+            if (texture_unit->ids[j] == id)
+                texture_unit->valid_mask &= ~(1U << j);
+        }
+    }
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(glstate->image_units); i++) {
+        struct glstate_image_unit *image_unit = &glstate->image_units[i];
+        if (image_unit->id == id)
+            image_unit->valid = 0;
+    }
+}
+
+static void invalidate_buffer_bindings(struct glstate_buffer_binding *bindings, size_t nb_bindings, GLuint id)
+{
+    for (size_t i = 0; i < nb_bindings; i++) {
+        if (bindings[i].id == id)
+            bindings[i].valid = 0;
+    }
+}
+
+void ngli_glstate_invalidate_buffer(struct glstate *glstate, GLuint id)
+{
+    invalidate_buffer_bindings(glstate->uniform_buffers, NGLI_ARRAY_NB(glstate->uniform_buffers), id);
+    invalidate_buffer_bindings(glstate->storage_buffers, NGLI_ARRAY_NB(glstate->storage_buffers), id);
+    glstate->vertex_array_epoch++;
+}
+
+void ngli_glstate_invalidate_vertex_array(struct glstate *glstate, GLuint id)
+{
+    /* Deleting the bound vertex array reverts the binding to zero */
+    if (glstate->vertex_array_id == id)
+        glstate->vertex_array_id = 0;
+}
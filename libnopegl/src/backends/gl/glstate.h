@@ -30,6 +30,43 @@ struct graphics_state;
 struct scissor;
 struct viewport;
 
+/*
+ * Resource bindings are only shadowed up to these limits, bindings beyond
+ * them are always forwarded to the driver
+ */
+#define NGLI_GLSTATE_MAX_TEXTURE_UNITS   32
+#define NGLI_GLSTATE_MAX_IMAGE_UNITS     8
+#define NGLI_GLSTATE_MAX_BUFFER_BINDINGS 32
+
+enum {
+    NGLI_GLSTATE_TEXTURE_TARGET_2D,
+    NGLI_GLSTATE_TEXTURE_TARGET_2D_ARRAY,
+    NGLI_GLSTATE_TEXTURE_TARGET_3D,
+    NGLI_GLSTATE_TEXTURE_TARGET_CUBE_MAP,
+    NGLI_GLSTATE_TEXTURE_TARGET_EXTERNAL_OES,
+    NGLI_GLSTATE_TEXTURE_TARGET_NB
+};
+
+struct glstate_texture_unit {
+    uint32_t valid_mask; /* one bit per NGLI_GLSTATE_TEXTURE_TARGET_* */
+    GLuint ids[NGLI_GLSTATE_TEXTURE_TARGET_NB];
+};
+
+struct glstate_image_unit {
+    int valid;
+    GLuint id;
+    GLboolean layered;
+    GLenum access;
+    GLenum internal_format;
+};
+
+struct glstate_buffer_binding {
+    int valid;
+    GLuint id;
+    GLintptr offset;
+    GLsizeiptr size;
+};
+
 struct glstate {
     /* Graphics state */
     GLenum blend;
@@ -66,6 +103,21 @@ struct glstate {
 
     /* Common state */
     GLuint program_id;
+
+    /* Resource bindings */
+    GLenum active_texture; /* 0 if unknown */
+    struct glstate_texture_unit texture_units[NGLI_GLSTATE_MAX_TEXTURE_UNITS];
+    struct glstate_image_unit image_units[NGLI_GLSTATE_MAX_IMAGE_UNITS];
+    struct glstate_buffer_binding uniform_buffers[NGLI_GLSTATE_MAX_BUFFER_BINDINGS];
+    struct glstate_buffer_binding storage_buffers[NGLI_GLSTATE_MAX_BUFFER_BINDINGS];
+    GLuint vertex_array_id;
+
+    /*
+     * Incremented every time the vertex buffers referenced by the vertex
+     * array objects may have changed (buffer deletion, state reset), so that
+     * the per vertex array caches of the pipelines can be invalidated
+     */
+    uint64_t vertex_array_epoch;
 };
 
 void ngli_glstate_reset(const struct glcontext *gl,
@@ -87,4 +139,45 @@ void ngli_glstate_update_viewport(const struct glcontext *gl,
                                   struct glstate *glstate,
                                   const struct viewport *viewport);
 
+/* Bind a texture on the currently active texture unit */
+void ngli_glstate_bind_texture(const struct glcontext *gl,
+                               struct glstate *glstate,
+                               GLenum target,
+                               GLuint id);
+
+void ngli_glstate_bind_texture_unit(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLuint unit,
+                                    GLenum target,
+                                    GLuint id);
+
+void ngli_glstate_bind_image_texture(const struct glcontext *gl,
+                                     struct glstate *glstate,
+                                     GLuint unit,
+                                     GLuint id,
+                                     GLboolean layered,
+                                     GLenum access,
+                                     GLenum internal_format);
+
+void ngli_glstate_bind_buffer_range(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLenum target,
+                                    GLuint index,
+                                    GLuint id,
+                                    GLintptr offset,
+                                    GLsizeiptr size);
+
+void ngli_glstate_bind_vertex_array(const struct glcontext *gl,
+                                    struct glstate *glstate,
+                                    GLuint id);
+
+/*
+ * Must be called before a texture, buffer or vertex array name is released
+ * (or when the wrapping object is destroyed) since the driver may recycle
+ * it for a different object
+ */
+void ngli_glstate_invalidate_texture(struct glstate *glstate, GLuint id);
+void ngli_glstate_invalidate_buffer(struct glstate *glstate, GLuint id);
+void ngli_glstate_invalidate_vertex_array(struct glstate *glstate, GLuint id);
+
 #endif
@@ -96,10 +96,10 @@ static int wrap_capture_cvpixelbuffer(struct gpu_ctx *s,
     }
 
     GLuint id = CVOpenGLESTextureGetName(cv_texture);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, id);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_2D, id);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glstate_bind_texture(gl, &s_priv->glstate, GL_TEXTURE_2D, 0);
 
     struct texture *texture = ngli_texture_create(s);
     if (!texture) {
@@ -307,9 +307,29 @@ static int onscreen_rendertarget_init(struct gpu_ctx *s)
     return 0;
 }
 
+static void capture_slots_reset(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    if (!s_priv->capture_slots)
+        return;
+
+    for (size_t i = 0; i < s->nb_capture_slots; i++) {
+        struct capture_slot_gl *slot = &s_priv->capture_slots[i];
+        if (slot->fence)
+            ngli_glDeleteSync(gl, slot->fence);
+        if (slot->mapped_data)
+            ngli_buffer_unmap(slot->buffer);
+        ngli_buffer_freep(&slot->buffer);
+    }
+    ngli_freep(&s_priv->capture_slots);
+}
+
 static void rendertarget_reset(struct gpu_ctx *s)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    capture_slots_reset(s);
     ngli_rendertarget_freep(&s_priv->default_rt);
     ngli_rendertarget_freep(&s_priv->default_rt_load);
     ngli_texture_freep(&s_priv->color);
@@ -488,6 +508,8 @@ static int gl_init(struct gpu_ctx *s)
 
     struct glcontext *gl = s_priv->glcontext;
 
+    ngli_staging_gl_init(&s_priv->staging, s);
+
 #if DEBUG_GL
     if ((gl->features & NGLI_FEATURE_GL_KHR_DEBUG)) {
         ngli_glEnable(gl, GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -805,6 +827,103 @@ static int gl_end_draw(struct gpu_ctx *s, double t)
     return ret;
 }
 
+static int capture_slot_init(struct gpu_ctx *s, struct capture_slot_gl *slot)
+{
+    const struct ngl_config *config = &s->config;
+
+    slot->buffer = ngli_buffer_create(s);
+    if (!slot->buffer)
+        return NGL_ERROR_MEMORY;
+
+    const size_t size = (size_t)config->width * (size_t)config->height * 4;
+    const int usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT |
+                      NGLI_BUFFER_USAGE_TRANSFER_DST_BIT |
+                      NGLI_BUFFER_USAGE_MAP_READ;
+    return ngli_buffer_init(slot->buffer, size, usage);
+}
+
+static int gl_end_draw_async(struct gpu_ctx *s, double t, size_t index)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    struct rendertarget *rt = s_priv->default_rt;
+    struct rendertarget_gl *rt_gl = (struct rendertarget_gl *)rt;
+
+    if (!s_priv->capture_slots) {
+        s_priv->capture_slots = ngli_calloc(s->nb_capture_slots, sizeof(*s_priv->capture_slots));
+        if (!s_priv->capture_slots)
+            return NGL_ERROR_MEMORY;
+    }
+
+    struct capture_slot_gl *slot = &s_priv->capture_slots[index];
+    if (!slot->buffer) {
+        int ret = capture_slot_init(s, slot);
+        if (ret < 0)
+            return ret;
+    }
+
+    /* The slot is being recycled: its previous content is dropped */
+    if (slot->mapped_data) {
+        ngli_buffer_unmap(slot->buffer);
+        slot->mapped_data = NULL;
+    }
+    if (slot->fence) {
+        ngli_glDeleteSync(gl, slot->fence);
+        slot->fence = NULL;
+    }
+
+    /*
+     * Read the pixels into the pixel pack buffer: the transfer is queued on
+     * the GPU and does not stall the CPU until the slot is acquired.
+     */
+    const struct buffer_gl *buffer_gl = (const struct buffer_gl *)slot->buffer;
+    const GLuint fbo_id = rt_gl->resolve_id ? rt_gl->resolve_id : rt_gl->id;
+    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, fbo_id);
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, buffer_gl->id);
+    ngli_glReadPixels(gl, 0, 0, rt->width, rt->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+
+    slot->fence = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!slot->fence) {
+        LOG(ERROR, "could not create capture fence");
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+    ngli_glFlush(gl);
+
+    return ngli_glcontext_check_gl_error(gl, __func__);
+}
+
+static int gl_capture_acquire(struct gpu_ctx *s, size_t index, const uint8_t **datap)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+    const struct ngl_config *config = &s->config;
+
+    struct capture_slot_gl *slot = &s_priv->capture_slots[index];
+    if (slot->fence) {
+        const GLuint64 timeout = 1000000000; /* 1 second, in nanoseconds */
+        GLenum status = ngli_glClientWaitSync(gl, slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        while (status == GL_TIMEOUT_EXPIRED)
+            status = ngli_glClientWaitSync(gl, slot->fence, 0, timeout);
+        ngli_glDeleteSync(gl, slot->fence);
+        slot->fence = NULL;
+        if (status == GL_WAIT_FAILED) {
+            LOG(ERROR, "could not wait for capture fence");
+            return NGL_ERROR_GRAPHICS_GENERIC;
+        }
+    }
+
+    if (!slot->mapped_data) {
+        const size_t size = (size_t)config->width * (size_t)config->height * 4;
+        int ret = ngli_buffer_map(slot->buffer, size, 0, &slot->mapped_data);
+        if (ret < 0)
+            return ret;
+    }
+
+    *datap = slot->mapped_data;
+    return 0;
+}
+
 static int gl_query_draw_time(struct gpu_ctx *s, int64_t *time)
 {
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
@@ -845,6 +964,7 @@ static void gl_destroy(struct gpu_ctx *s)
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
     timer_reset(s);
     rendertarget_reset(s);
+    ngli_staging_gl_uninit(&s_priv->staging);
 #if DEBUG_GPU_CAPTURE
     if (s->gpu_capture)
         ngli_gpu_capture_end(s->gpu_capture_ctx);
@@ -978,6 +1098,8 @@ const struct gpu_ctx_class ngli_gpu_ctx_##cls_suffix = {
     .end_update                         = gl_end_update,                         \
     .begin_draw                         = gl_begin_draw,                         \
     .end_draw                           = gl_end_draw,                           \
+    .end_draw_async                     = gl_end_draw_async,                     \
+    .capture_acquire                    = gl_capture_acquire,                    \
     .query_draw_time                    = gl_query_draw_time,                    \
     .wait_idle                          = gl_wait_idle,                          \
     .destroy                            = gl_destroy,                            \
@@ -1027,6 +1149,7 @@ const struct gpu_ctx_class ngli_gpu_ctx_##cls_suffix = {
     .texture_create                     = ngli_texture_gl_create,                \
     .texture_init                       = ngli_texture_gl_init,                  \
     .texture_upload                     = ngli_texture_gl_upload,                \
+    .texture_upload_region              = ngli_texture_gl_upload_region,         \
     .texture_generate_mipmap            = ngli_texture_gl_generate_mipmap,       \
     .texture_freep                      = ngli_texture_gl_freep,                 \
 }                                                                                \
@@ -35,12 +35,19 @@
 #include "pgcache.h"
 #include "pipeline.h"
 #include "gpu_ctx.h"
+#include "staging_gl.h"
 
 struct ngl_ctx;
 struct rendertarget;
 
 typedef void (*capture_func_type)(struct gpu_ctx *s);
 
+struct capture_slot_gl {
+    struct buffer *buffer;
+    GLsync fence;
+    void *mapped_data;
+};
+
 struct gpu_ctx_gl {
     struct gpu_ctx parent;
     struct glcontext *glcontext;
@@ -61,6 +68,10 @@ struct gpu_ctx_gl {
     CVPixelBufferRef capture_cvbuffer;
     CVOpenGLESTextureRef capture_cvtexture;
 #endif
+    /* Asynchronous capture slots (lazily allocated) */
+    struct capture_slot_gl *capture_slots;
+    /* Pixel unpack buffers ring used to stage texture uploads */
+    struct staging_gl staging;
     /* Timer */
     GLuint queries[2];
     void (*glGenQueries)(const struct glcontext *gl, GLsizei n, GLuint * ids);
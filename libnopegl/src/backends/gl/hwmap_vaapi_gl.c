@@ -91,12 +91,12 @@ static int vaapi_init(struct hwmap *hwmap, struct nmd_frame *frame)
         const GLint wrap_s = ngli_texture_get_gl_wrap(params->texture_wrap_s);
         const GLint wrap_t = ngli_texture_get_gl_wrap(params->texture_wrap_t);
 
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, vaapi->gl_planes[i]);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_2D, vaapi->gl_planes[i]);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_s);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t);
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_2D, 0);
 
         const int format = i == 0 ? NGLI_FORMAT_R8_UNORM : NGLI_FORMAT_R8G8_UNORM;
 
@@ -273,7 +273,7 @@ static int vaapi_map_frame(struct hwmap *hwmap, struct nmd_frame *frame)
         struct texture_gl *plane_gl = (struct texture_gl *)plane;
         ngli_texture_gl_set_dimensions(plane, width, height, 0);
 
-        ngli_glBindTexture(gl, plane_gl->target, plane_gl->id);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, plane_gl->target, plane_gl->id);
         ngli_glEGLImageTargetTexture2DOES(gl, plane_gl->target, vaapi->egl_images[i]);
     }
 
@@ -94,7 +94,7 @@ static int vt_darwin_map_plane(struct hwmap *hwmap, IOSurfaceRef surface, size_t
     struct texture *plane = vt->planes[index];
     struct texture_gl *plane_gl = (struct texture_gl *)plane;
 
-    ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, plane_gl->id);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_RECTANGLE, plane_gl->id);
 
     size_t width = IOSurfaceGetWidthOfPlane(surface, index);
     size_t height = IOSurfaceGetHeightOfPlane(surface, index);
@@ -113,7 +113,7 @@ static int vt_darwin_map_plane(struct hwmap *hwmap, IOSurfaceRef surface, size_t
         return NGL_ERROR_EXTERNAL;
     }
 
-    ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, 0);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_RECTANGLE, 0);
 
     return 0;
 }
@@ -203,12 +203,12 @@ static int vt_darwin_init(struct hwmap *hwmap, struct nmd_frame * frame)
         const GLint min_filter = ngli_texture_get_gl_min_filter(params->texture_min_filter, NGLI_MIPMAP_FILTER_NONE);
         const GLint mag_filter = ngli_texture_get_gl_mag_filter(params->texture_mag_filter);
 
-        ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, vt->gl_planes[i]);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_RECTANGLE, vt->gl_planes[i]);
         ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, min_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, mag_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         ngli_glTexParameteri(gl, GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, 0);
+        ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, GL_TEXTURE_RECTANGLE, 0);
 
         const struct texture_params plane_params = {
             .type             = NGLI_TEXTURE_TYPE_2D,
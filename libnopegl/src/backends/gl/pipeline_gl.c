@@ -54,6 +54,7 @@ struct attribute_binding_gl {
     int format;
     size_t stride;
     size_t offset;
+    GLuint buffer_id; /* vertex buffer currently attached in the VAO */
 };
 
 static int build_texture_bindings(struct pipeline *s)
@@ -117,6 +118,8 @@ static GLenum get_gl_access(int access)
 static void set_textures(struct pipeline *s, struct glcontext *gl)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glstate *glstate = &gpu_ctx_gl->glstate;
     const struct texture_binding_gl *bindings = ngli_darray_data(&s_priv->texture_bindings);
     for (size_t i = 0; i < ngli_darray_count(&s_priv->texture_bindings); i++) {
         const struct texture_binding_gl *texture_binding = &bindings[i];
@@ -139,17 +142,17 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
                 texture_binding->desc.type == NGLI_TYPE_IMAGE_3D ||
                 texture_binding->desc.type == NGLI_TYPE_IMAGE_CUBE)
                 layered = GL_TRUE;
-            ngli_glBindImageTexture(gl, texture_binding->desc.binding, texture_id, 0, layered, 0, access, internal_format);
+            ngli_glstate_bind_image_texture(gl, glstate, texture_binding->desc.binding, texture_id, layered, access, internal_format);
         } else {
-            ngli_glActiveTexture(gl, GL_TEXTURE0 + texture_binding->desc.binding);
+            const GLuint unit = texture_binding->desc.binding;
             if (texture) {
-                ngli_glBindTexture(gl, texture_gl->target, texture_gl->id);
+                ngli_glstate_bind_texture_unit(gl, glstate, unit, texture_gl->target, texture_gl->id);
             } else {
-                ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
-                ngli_glBindTexture(gl, GL_TEXTURE_2D_ARRAY, 0);
-                ngli_glBindTexture(gl, GL_TEXTURE_3D, 0);
+                ngli_glstate_bind_texture_unit(gl, glstate, unit, GL_TEXTURE_2D, 0);
+                ngli_glstate_bind_texture_unit(gl, glstate, unit, GL_TEXTURE_2D_ARRAY, 0);
+                ngli_glstate_bind_texture_unit(gl, glstate, unit, GL_TEXTURE_3D, 0);
                 if (gl->features & NGLI_FEATURE_GL_OES_EGL_EXTERNAL_IMAGE)
-                    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, 0);
+                    ngli_glstate_bind_texture_unit(gl, glstate, unit, GL_TEXTURE_EXTERNAL_OES, 0);
             }
         }
     }
@@ -158,6 +161,8 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
 static void set_buffers(struct pipeline *s, struct glcontext *gl)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glstate *glstate = &gpu_ctx_gl->glstate;
 
     size_t current_dynamic_offset = 0;
     const struct buffer_binding_gl *bindings = ngli_darray_data(&s_priv->buffer_bindings);
@@ -172,7 +177,7 @@ static void set_buffers(struct pipeline *s, struct glcontext *gl)
             offset += s->dynamic_offsets[current_dynamic_offset++];
         }
         const size_t size = buffer_binding->size;
-        ngli_glBindBufferRange(gl, buffer_binding->type, buffer_desc->binding, buffer_gl->id, offset, size);
+        ngli_glstate_bind_buffer_range(gl, glstate, buffer_binding->type, buffer_desc->binding, buffer_gl->id, offset, size);
     }
 }
 
@@ -224,7 +229,7 @@ static int build_attribute_bindings(struct pipeline *s)
     struct glcontext *gl = gpu_ctx_gl->glcontext;
 
     ngli_glGenVertexArrays(gl, 1, &s_priv->vao_id);
-    ngli_glBindVertexArray(gl, s_priv->vao_id);
+    ngli_glstate_bind_vertex_array(gl, &gpu_ctx_gl->glstate, s_priv->vao_id);
 
     const struct pipeline_graphics *graphics = &s->graphics;
     const struct vertex_state *state = &graphics->vertex_state;
@@ -277,25 +282,42 @@ static GLenum get_gl_indices_type(int indices_format)
     return gl_indices_type_map[indices_format];
 }
 
-static void bind_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
+static void bind_vertex_attribs(struct pipeline *s, struct glcontext *gl)
 {
-    const struct pipeline_gl *s_priv = (const struct pipeline_gl *)s;
-    struct gpu_ctx *gpu_ctx = (struct gpu_ctx *)s->gpu_ctx;
+    struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
+    struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)gpu_ctx;
+    struct glstate *glstate = &gpu_ctx_gl->glstate;
 
-    ngli_glBindVertexArray(gl, s_priv->vao_id);
+    ngli_glstate_bind_vertex_array(gl, glstate, s_priv->vao_id);
+
+    /*
+     * The VAO retains the attribute pointers and the index buffer: they only
+     * need to be specified again when the bound buffers change
+     */
+    struct attribute_binding_gl *bindings = ngli_darray_data(&s_priv->attribute_bindings);
+    const size_t nb_bindings = ngli_darray_count(&s_priv->attribute_bindings);
+    if (s_priv->vertex_array_epoch != glstate->vertex_array_epoch) {
+        for (size_t i = 0; i < nb_bindings; i++)
+            bindings[i].buffer_id = 0;
+        s_priv->index_buffer_id = 0;
+        s_priv->vertex_array_epoch = glstate->vertex_array_epoch;
+    }
 
     const struct buffer **vertex_buffers = gpu_ctx->vertex_buffers;
-    const struct attribute_binding_gl *bindings = ngli_darray_data(&s_priv->attribute_bindings);
-    for (size_t i = 0; i < ngli_darray_count(&s_priv->attribute_bindings); i++) {
-        const struct attribute_binding_gl *attribute_binding = &bindings[i];
+    for (size_t i = 0; i < nb_bindings; i++) {
+        struct attribute_binding_gl *attribute_binding = &bindings[i];
         const size_t binding = attribute_binding->binding;
+        const struct buffer_gl *buffer_gl = (const struct buffer_gl *)vertex_buffers[binding];
+        if (attribute_binding->buffer_id == buffer_gl->id)
+            continue;
         const GLuint location = attribute_binding->location;
         const GLuint size = ngli_format_get_nb_comp(attribute_binding->format);
         const GLsizei stride = (GLsizei)attribute_binding->stride;
         const void *offset = (void *)(uintptr_t)attribute_binding->offset;
-        const struct buffer_gl *buffer_gl = (const struct buffer_gl *)vertex_buffers[binding];
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
         ngli_glVertexAttribPointer(gl, location, size, GL_FLOAT, GL_FALSE, stride, offset);
+        attribute_binding->buffer_id = buffer_gl->id;
     }
 }
 
@@ -496,7 +518,10 @@ void ngli_pipeline_gl_draw_indexed(struct pipeline *s, int nb_indices, int nb_in
 
     const struct buffer_gl *indices_gl = (const struct buffer_gl *)gpu_ctx->index_buffer;
     const GLenum gl_indices_type = get_gl_indices_type(gpu_ctx->index_format);
-    ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_gl->id);
+    if (s_priv->index_buffer_id != indices_gl->id) {
+        ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_gl->id);
+        s_priv->index_buffer_id = indices_gl->id;
+    }
 
     s_priv->insert_memory_barriers(s);
 
@@ -545,6 +570,7 @@ void ngli_pipeline_gl_freep(struct pipeline **sp)
     struct gpu_ctx *gpu_ctx = s->gpu_ctx;
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
+    ngli_glstate_invalidate_vertex_array(&gpu_ctx_gl->glstate, s_priv->vao_id);
     ngli_glDeleteVertexArrays(gl, 1, &s_priv->vao_id);
 
     ngli_freep(sp);
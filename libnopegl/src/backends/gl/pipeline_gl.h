@@ -37,6 +37,8 @@ struct pipeline_gl {
     struct darray attribute_bindings; // attribute_binding_gl
 
     GLuint vao_id;
+    GLuint index_buffer_id;      /* index buffer currently attached in the VAO */
+    uint64_t vertex_array_epoch; /* glstate epoch the VAO cache is valid for */
     int use_barriers;
     void (*insert_memory_barriers)(struct pipeline *s);
 };
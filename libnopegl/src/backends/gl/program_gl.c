@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "diskcache.h"
 #include "gpu_ctx_gl.h"
 #include "glincludes.h"
 #include "log.h"
@@ -250,7 +251,110 @@ struct program *ngli_program_gl_create(struct gpu_ctx *gpu_ctx)
     return (struct program *)s;
 }
 
-int ngli_program_gl_init(struct program *s, const struct program_params *params)
+#define CACHE_NAMESPACE "glprogram"
+
+static int support_program_binary(const struct glcontext *gl)
+{
+    if (!(gl->features & NGLI_FEATURE_GL_GET_PROGRAM_BINARY))
+        return 0;
+
+    GLint nb_formats = 0;
+    ngli_glGetIntegerv(gl, GL_NUM_PROGRAM_BINARY_FORMATS, &nb_formats);
+    return nb_formats > 0;
+}
+
+/*
+ * Program binaries are only valid for the driver that produced them, so the
+ * renderer and version strings are part of the key along with the sources.
+ */
+static char *get_cache_key(const struct glcontext *gl, const struct program_params *params)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    const char *renderer = (const char *)ngli_glGetString(gl, GL_RENDERER);
+    const char *version = (const char *)ngli_glGetString(gl, GL_VERSION);
+    ngli_bstr_printf(b, "%s\n%s\n", renderer ? renderer : "", version ? version : "");
+
+    const char *sources[] = {params->vertex, params->fragment, params->compute};
+    for (size_t i = 0; i < NGLI_ARRAY_NB(sources); i++) {
+        const char *src = sources[i] ? sources[i] : "";
+        ngli_bstr_printf(b, "%zu\n", strlen(src));
+        ngli_bstr_print(b, src);
+    }
+
+    char *key = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return key;
+}
+
+/* Return 1 if the program has been successfully loaded from the cache */
+static int load_program_binary(struct program *s, const char *dir, const char *key)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    void *data = NULL;
+    size_t size = 0;
+    int ret = ngli_diskcache_load(dir, CACHE_NAMESPACE, key, strlen(key), &data, &size);
+    if (ret < 0)
+        return 0;
+
+    if (size <= sizeof(GLenum) || size - sizeof(GLenum) > INT32_MAX) {
+        ngli_free(data);
+        return 0;
+    }
+
+    GLenum format;
+    memcpy(&format, data, sizeof(format));
+    const uint8_t *binary = (const uint8_t *)data + sizeof(format);
+    ngli_glProgramBinary(gl, s_priv->id, format, binary, (GLsizei)(size - sizeof(format)));
+    ngli_free(data);
+
+    GLint status = GL_FALSE;
+    ngli_glGetProgramiv(gl, s_priv->id, GL_LINK_STATUS, &status);
+    if (status == GL_TRUE)
+        return 1;
+
+    /*
+     * The binary has been rejected by the driver (typically after a driver
+     * update): drop any error it may have raised and start over with a fresh
+     * program object.
+     */
+    while (ngli_glGetError(gl) != GL_NO_ERROR);
+    ngli_glDeleteProgram(gl, s_priv->id);
+    s_priv->id = ngli_glCreateProgram(gl);
+    LOG(DEBUG, "cached program binary has been rejected by the driver");
+    return 0;
+}
+
+static void store_program_binary(struct program *s, const char *dir, const char *key)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    GLint length = 0;
+    ngli_glGetProgramiv(gl, s_priv->id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    uint8_t *data = ngli_malloc(sizeof(GLenum) + (size_t)length);
+    if (!data)
+        return;
+
+    GLenum format = 0;
+    GLsizei written = 0;
+    ngli_glGetProgramBinary(gl, s_priv->id, length, &written, &format, data + sizeof(format));
+    memcpy(data, &format, sizeof(format));
+    if (written > 0)
+        ngli_diskcache_store(dir, CACHE_NAMESPACE, key, strlen(key), data, sizeof(format) + (size_t)written);
+    ngli_free(data);
+}
+
+static int program_build(struct program *s, const struct program_params *params, int retrievable)
 {
     struct program_gl *s_priv = (struct program_gl *)s;
 
@@ -269,14 +373,6 @@ int ngli_program_gl_init(struct program *s, const struct program_params *params)
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
 
-    const uint64_t features = NGLI_FEATURE_GL_COMPUTE_SHADER_ALL;
-    if (params->compute && (gl->features & features) != features) {
-        LOG(ERROR, "context does not support compute shaders");
-        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
-    }
-
-    s_priv->id = ngli_glCreateProgram(gl);
-
     for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++) {
         if (!shaders[i].src)
             continue;
@@ -292,11 +388,14 @@ int ngli_program_gl_init(struct program *s, const struct program_params *params)
                     params->label ? params->label : "", s_with_numbers);
                 ngli_free(s_with_numbers);
             }
-            goto fail;
+            goto end;
         }
         ngli_glAttachShader(gl, s_priv->id, shader);
     }
 
+    if (retrievable)
+        ngli_glProgramParameteri(gl, s_priv->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     ngli_glLinkProgram(gl, s_priv->id);
     ret = program_check_status(gl, s_priv->id, GL_LINK_STATUS);
     if (ret < 0) {
@@ -316,26 +415,55 @@ int ngli_program_gl_init(struct program *s, const struct program_params *params)
             LOG(ERROR, "%s", ngli_bstr_strptr(bstr));
             ngli_bstr_freep(&bstr);
         }
-        goto fail;
+        goto end;
     }
 
+end:
     for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++)
         ngli_glDeleteShader(gl, shaders[i].id);
 
+    return ret;
+}
+
+int ngli_program_gl_init(struct program *s, const struct program_params *params)
+{
+    struct program_gl *s_priv = (struct program_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct ngl_config *config = &s->gpu_ctx->config;
+
+    const uint64_t features = NGLI_FEATURE_GL_COMPUTE_SHADER_ALL;
+    if (params->compute && (gl->features & features) != features) {
+        LOG(ERROR, "context does not support compute shaders");
+        return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+    }
+
+    s_priv->id = ngli_glCreateProgram(gl);
+
+    char *cache_key = NULL;
+    if (config->cache_dir && support_program_binary(gl)) {
+        cache_key = get_cache_key(gl, params);
+        if (!cache_key)
+            return NGL_ERROR_MEMORY;
+    }
+
+    int ret = 0;
+    if (!cache_key || !load_program_binary(s, config->cache_dir, cache_key)) {
+        ret = program_build(s, params, cache_key != NULL);
+        if (ret < 0)
+            goto end;
+        if (cache_key)
+            store_program_binary(s, config->cache_dir, cache_key);
+    }
+
     s->uniforms = program_probe_uniforms(gl, s_priv->id);
     s->attributes = program_probe_attributes(gl, s_priv->id);
     s->buffer_blocks = program_probe_buffer_blocks(gl, s_priv->id);
-    if (!s->uniforms || !s->attributes || !s->buffer_blocks) {
+    if (!s->uniforms || !s->attributes || !s->buffer_blocks)
         ret = NGL_ERROR_MEMORY;
-        goto fail;
-    }
-
-    return 0;
-
-fail:
-    for (size_t i = 0; i < NGLI_ARRAY_NB(shaders); i++)
-        ngli_glDeleteShader(gl, shaders[i].id);
 
+end:
+    ngli_free(cache_key);
     return ret;
 }
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "glcontext.h"
+#include "gpu_ctx_gl.h"
+#include "log.h"
+#include "nopegl.h"
+#include "staging_gl.h"
+
+static int wait_slot(struct glcontext *gl, struct staging_slot_gl *slot)
+{
+    if (!slot->fence)
+        return 0;
+
+    const GLuint64 timeout = 1000000000; /* 1 second, in nanoseconds */
+    GLenum status = ngli_glClientWaitSync(gl, slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    while (status == GL_TIMEOUT_EXPIRED)
+        status = ngli_glClientWaitSync(gl, slot->fence, 0, timeout);
+    ngli_glDeleteSync(gl, slot->fence);
+    slot->fence = NULL;
+    if (status == GL_WAIT_FAILED) {
+        LOG(ERROR, "could not wait for staging fence");
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+    return 0;
+}
+
+void ngli_staging_gl_init(struct staging_gl *s, struct gpu_ctx *gpu_ctx)
+{
+    memset(s, 0, sizeof(*s));
+    s->gpu_ctx = gpu_ctx;
+}
+
+int ngli_staging_gl_map(struct staging_gl *s, size_t size, void **datap)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    struct staging_slot_gl *slot = &s->slots[s->cur_slot];
+
+    /* The slot is only reused once the transfer reading from it is complete */
+    int ret = wait_slot(gl, slot);
+    if (ret < 0)
+        return ret;
+
+    if (!slot->id)
+        ngli_glGenBuffers(gl, 1, &slot->id);
+    ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, slot->id);
+
+    /* Slots only grow, so that they settle on the size of the largest upload */
+    if (slot->size < size) {
+        ngli_glBufferData(gl, GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        slot->size = size;
+    }
+
+    /*
+     * The fence guarantees that the GPU is not using the slot anymore, so the
+     * driver does not need to synchronize the mapping
+     */
+    const GLbitfield flags = GL_MAP_WRITE_BIT |
+                             GL_MAP_INVALIDATE_BUFFER_BIT |
+                             GL_MAP_UNSYNCHRONIZED_BIT;
+    void *data = ngli_glMapBufferRange(gl, GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+    if (!data) {
+        ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+
+    *datap = data;
+    return 0;
+}
+
+int ngli_staging_gl_unmap(struct staging_gl *s)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    if (!ngli_glUnmapBuffer(gl, GL_PIXEL_UNPACK_BUFFER)) {
+        LOG(ERROR, "staging buffer content has been lost");
+        ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+    return 0;
+}
+
+int ngli_staging_gl_submit(struct staging_gl *s)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    struct staging_slot_gl *slot = &s->slots[s->cur_slot];
+
+    ngli_glBindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
+
+    slot->fence = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!slot->fence) {
+        LOG(ERROR, "could not create staging fence");
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+
+    s->cur_slot = (s->cur_slot + 1) % NGLI_STAGING_GL_NB_SLOTS;
+    return 0;
+}
+
+void ngli_staging_gl_uninit(struct staging_gl *s)
+{
+    if (!s->gpu_ctx)
+        return;
+
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+
+    for (size_t i = 0; i < NGLI_STAGING_GL_NB_SLOTS; i++) {
+        struct staging_slot_gl *slot = &s->slots[i];
+        if (slot->fence)
+            ngli_glDeleteSync(gl, slot->fence);
+        if (slot->id)
+            ngli_glDeleteBuffers(gl, 1, &slot->id);
+    }
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STAGING_GL_H
+#define STAGING_GL_H
+
+#include <stddef.h>
+
+#include "glincludes.h"
+
+struct gpu_ctx;
+
+/*
+ * Ring of pixel unpack buffers used to stage texture uploads.
+ *
+ * Each upload is copied into the next slot of the ring and the texture is
+ * then updated from that slot, which lets the driver perform the transfer
+ * asynchronously instead of copying from client memory before returning. A
+ * fence is inserted after each transfer so that a slot is only rewritten once
+ * the GPU is done reading from it, which allows several uploads (typically the
+ * planes of the next video frames) to be in flight at the same time.
+ *
+ * Usage:
+ *   ngli_staging_gl_map()   binds the next slot and returns a pointer to it
+ *   ngli_staging_gl_unmap() flushes the data, the slot stays bound as the
+ *                           GL_PIXEL_UNPACK_BUFFER so the transfer can be
+ *                           issued with a NULL (zero offset) data pointer
+ *   ngli_staging_gl_submit() unbinds the slot and fences the transfer
+ */
+
+#define NGLI_STAGING_GL_NB_SLOTS 6
+
+struct staging_slot_gl {
+    GLuint id;
+    size_t size;
+    GLsync fence;
+};
+
+struct staging_gl {
+    struct gpu_ctx *gpu_ctx;
+    struct staging_slot_gl slots[NGLI_STAGING_GL_NB_SLOTS];
+    size_t cur_slot;
+};
+
+void ngli_staging_gl_init(struct staging_gl *s, struct gpu_ctx *gpu_ctx);
+int ngli_staging_gl_map(struct staging_gl *s, size_t size, void **datap);
+int ngli_staging_gl_unmap(struct staging_gl *s);
+int ngli_staging_gl_submit(struct staging_gl *s);
+void ngli_staging_gl_uninit(struct staging_gl *s);
+
+#endif
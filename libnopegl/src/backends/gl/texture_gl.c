@@ -172,6 +172,34 @@ static void texture_set_sub_image(struct texture *s, const uint8_t *data, int li
     ngli_glPixelStorei(gl, GL_UNPACK_ROW_LENGTH, 0);
 }
 
+/*
+ * Upload the data through the staging ring: copying into the pixel unpack
+ * buffer is the only work done on the CPU, the transfer to the texture itself
+ * is queued and performed asynchronously by the driver
+ */
+static int texture_set_sub_image_staged(struct texture *s, const uint8_t *data, int linesize)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    const struct texture_params *params = &s->params;
+
+    const int32_t row_length = linesize ? linesize : params->width;
+    const size_t size = (size_t)row_length * params->height * ngli_format_get_bytes_per_pixel(params->format);
+
+    void *dst;
+    int ret = ngli_staging_gl_map(&gpu_ctx_gl->staging, size, &dst);
+    if (ret < 0)
+        return ret;
+    memcpy(dst, data, size);
+    ret = ngli_staging_gl_unmap(&gpu_ctx_gl->staging);
+    if (ret < 0)
+        return ret;
+
+    /* The staging buffer is bound, the data pointer is an offset into it */
+    texture_set_sub_image(s, NULL, linesize);
+
+    return ngli_staging_gl_submit(&gpu_ctx_gl->staging);
+}
+
 static int get_mipmap_levels(const struct texture *s)
 {
     const struct texture_params *params = &s->params;
@@ -334,7 +362,7 @@ int ngli_texture_gl_init(struct texture *s, const struct texture_params *params)
     }
 
     ngli_glGenTextures(gl, 1, &s_priv->id);
-    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
     const GLint min_filter = ngli_texture_get_gl_min_filter(params->min_filter, s->params.mipmap_filter);
     const GLint mag_filter = ngli_texture_get_gl_mag_filter(params->mag_filter);
     const GLint wrap_s = ngli_texture_get_gl_wrap(params->wrap_s);
@@ -382,6 +410,10 @@ void ngli_texture_gl_set_id(struct texture *s, GLuint id)
     /* only wrapped textures can update their id with this function */
     ngli_assert(s_priv->wrapped);
 
+    /* The previous texture is owned by the caller and may have been released */
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    ngli_glstate_invalidate_texture(&gpu_ctx_gl->glstate, s_priv->id);
+
     s_priv->id = id;
 }
 
@@ -410,13 +442,53 @@ int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
     ngli_assert(!s_priv->wrapped);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
-    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    int ret = 0;
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
     if (data) {
-        texture_set_sub_image(s, data, linesize);
-        if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        /*
+         * 2D textures are the ones updated continuously (typically the planes
+         * of software decoded video frames), they are the ones benefiting
+         * from the staging ring
+         */
+        if (s_priv->target == GL_TEXTURE_2D)
+            ret = texture_set_sub_image_staged(s, data, linesize);
+        else
+            texture_set_sub_image(s, data, linesize);
+        if (ret >= 0 && params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
             ngli_glGenerateMipmap(gl, s_priv->target);
     }
-    ngli_glBindTexture(gl, s_priv->target, 0);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, 0);
+
+    return ret;
+}
+
+int ngli_texture_gl_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                                  int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    struct texture_gl *s_priv = (struct texture_gl *)s;
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+
+    ngli_assert(!s_priv->wrapped);
+    ngli_assert(s_priv->target == GL_TEXTURE_2D);
+    ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
+
+    if (!linesize)
+        linesize = width;
+
+    const int bytes_per_row = linesize * s_priv->bytes_per_pixel;
+    const int alignment = NGLI_MIN(bytes_per_row & ~(bytes_per_row - 1), 8);
+
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
+    ngli_glPixelStorei(gl, GL_UNPACK_ALIGNMENT, alignment);
+    ngli_glPixelStorei(gl, GL_UNPACK_ROW_LENGTH, linesize);
+    ngli_glTexSubImage2D(gl, s_priv->target, 0, x, y, width, height, s_priv->format, s_priv->format_type, data);
+    ngli_glPixelStorei(gl, GL_UNPACK_ALIGNMENT, 4);
+    ngli_glPixelStorei(gl, GL_UNPACK_ROW_LENGTH, 0);
+    if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        ngli_glGenerateMipmap(gl, s_priv->target);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, 0);
 
     return 0;
 }
@@ -431,7 +503,7 @@ int ngli_texture_gl_generate_mipmap(struct texture *s)
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
-    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    ngli_glstate_bind_texture(gl, &gpu_ctx_gl->glstate, s_priv->target, s_priv->id);
     ngli_glGenerateMipmap(gl, s_priv->target);
     return 0;
 }
@@ -446,6 +518,13 @@ void ngli_texture_gl_freep(struct texture **sp)
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
 
+    /*
+     * Wrapped textures are invalidated as well since their owner is free to
+     * release them once they are not referenced anymore
+     */
+    if (s_priv->target != GL_RENDERBUFFER)
+        ngli_glstate_invalidate_texture(&gpu_ctx_gl->glstate, s_priv->id);
+
     if (!s_priv->wrapped) {
         if (s_priv->target == GL_RENDERBUFFER)
             ngli_glDeleteRenderbuffers(gl, 1, &s_priv->id);
@@ -58,6 +58,8 @@ void ngli_texture_gl_set_id(struct texture *s, GLuint id);
 void ngli_texture_gl_set_dimensions(struct texture *s, int32_t width, int32_t height, int depth);
 
 int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_gl_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                                  int32_t x, int32_t y, int32_t width, int32_t height);
 int ngli_texture_gl_generate_mipmap(struct texture *s);
 
 void ngli_texture_gl_freep(struct texture **sp);
@@ -28,5 +28,7 @@ const struct api_impl api_vk = {
     .set_scene          = ngli_ctx_set_scene,
     .prepare_draw       = ngli_ctx_prepare_draw,
     .draw               = ngli_ctx_draw,
+    .draw_async         = ngli_ctx_draw_async,
+    .capture_acquire    = ngli_ctx_capture_acquire,
     .reset              = ngli_ctx_reset,
 };
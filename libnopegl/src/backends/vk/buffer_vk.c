@@ -143,46 +143,61 @@ VkResult ngli_buffer_vk_upload(struct buffer *s, const void *data, size_t size,
     }
 
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
-    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct buffer_vk *s_priv = (struct buffer_vk *)s;
 
-    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    const VkMemoryPropertyFlags mem_props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    VkResult res = create_vk_buffer(vk, s->size, usage, mem_props,
-                                    &s_priv->staging_buffer, &s_priv->staging_memory);
-    if (res != VK_SUCCESS)
-        return res;
-
-    uint8_t *mapped_data;
-    res = vkMapMemory(vk->device, s_priv->staging_memory, 0, s->size, 0, (void *)&mapped_data);
-    if (res != VK_SUCCESS)
-        return res;
-    memcpy(mapped_data + offset, data, size);
-    vkUnmapMemory(vk->device, s_priv->staging_memory);
-
-    struct cmd_vk *cmd_vk;
-    res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+    /*
+     * During the update phase, the copy is batched in the frame update
+     * command buffer, which is submitted (along with a barrier making the
+     * copies visible) at the end of the update. Otherwise, it is executed
+     * synchronously and its staging memory can be recycled right away.
+     */
+    struct cmd_vk *update_cmd = gpu_ctx_vk->update_cmds[gpu_ctx_vk->cur_frame_index];
+    const int in_update = gpu_ctx_vk->cur_cmd == update_cmd;
+    struct staging_vk *staging = in_update ? &gpu_ctx_vk->stagings[gpu_ctx_vk->cur_frame_index]
+                                           : &gpu_ctx_vk->transient_staging;
+    struct staging_alloc_vk alloc;
+    VkResult res = ngli_staging_vk_alloc(staging, size, 1, &alloc);
     if (res != VK_SUCCESS)
         return res;
+    memcpy(alloc.mapped_data, data, size);
 
     const VkBufferCopy region = {
-        .srcOffset = 0,
+        .srcOffset = alloc.offset,
         .dstOffset = offset,
         .size      = size,
     };
-    vkCmdCopyBuffer(cmd_vk->cmd_buf, s_priv->staging_buffer, s_priv->buffer, 1, &region);
 
-    res = ngli_cmd_vk_execute_transient(&cmd_vk);
-    if (res != VK_SUCCESS)
+    if (in_update) {
+        VkCommandBuffer cmd_buf = update_cmd->cmd_buf;
+        if (staging->nb_copies) {
+            /* Order the copy against the previous ones which may target the same buffer */
+            const VkMemoryBarrier barrier = {
+                .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            };
+            vkCmdPipelineBarrier(cmd_buf,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0, 1, &barrier, 0, NULL, 0, NULL);
+        }
+        vkCmdCopyBuffer(cmd_buf, alloc.buffer, s_priv->buffer, 1, &region);
+        staging->nb_copies++;
+        return VK_SUCCESS;
+    }
+
+    struct cmd_vk *cmd_vk;
+    res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+    if (res != VK_SUCCESS) {
+        ngli_staging_vk_reset(staging);
         return res;
+    }
 
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    s_priv->staging_buffer = VK_NULL_HANDLE;
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
-    s_priv->staging_memory = VK_NULL_HANDLE;
+    vkCmdCopyBuffer(cmd_vk->cmd_buf, alloc.buffer, s_priv->buffer, 1, &region);
 
-    return VK_SUCCESS;
+    res = ngli_cmd_vk_execute_transient(&cmd_vk);
+    ngli_staging_vk_reset(staging);
+    return res;
 }
 
 VkResult ngli_buffer_vk_map(struct buffer *s, size_t size, size_t offset, void **data)
@@ -215,7 +230,5 @@ void ngli_buffer_vk_freep(struct buffer **sp)
 
     vkDestroyBuffer(vk->device, s_priv->buffer, NULL);
     vkFreeMemory(vk->device, s_priv->memory, NULL);
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
     ngli_freep(sp);
 }
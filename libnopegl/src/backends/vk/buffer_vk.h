@@ -30,8 +30,6 @@ struct buffer_vk {
     struct buffer parent;
     VkBuffer buffer;
     VkDeviceMemory memory;
-    VkBuffer staging_buffer;
-    VkDeviceMemory staging_memory;
 };
 
 struct buffer *ngli_buffer_vk_create(struct gpu_ctx *gpu_ctx);
@@ -27,7 +27,9 @@
 
 #include <vulkan/vulkan.h>
 
+#include "diskcache.h"
 #include "glslang_utils.h"
+#include "hmap.h"
 #include "internal.h"
 #include "log.h"
 #include "math_utils.h"
@@ -311,6 +313,16 @@ static void destroy_render_resources(struct gpu_ctx *s)
         s_priv->mapped_data = NULL;
     }
     ngli_buffer_freep(&s_priv->capture_buffer);
+
+    if (s_priv->capture_slots) {
+        for (size_t i = 0; i < s->nb_capture_slots; i++) {
+            struct capture_slot_vk *slot = &s_priv->capture_slots[i];
+            if (slot->mapped_data)
+                ngli_buffer_unmap(slot->buffer);
+            ngli_buffer_freep(&slot->buffer);
+        }
+        ngli_freep(&s_priv->capture_slots);
+    }
 }
 
 static VkResult create_query_pool(struct gpu_ctx *s)
@@ -335,6 +347,92 @@ static void destroy_query_pool(struct gpu_ctx *s)
     vkDestroyQueryPool(vk->device, s_priv->query_pool, NULL);
 }
 
+#define PIPELINE_CACHE_NAMESPACE "vkpipelinecache"
+
+struct pipeline_cache_key {
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint8_t uuid[VK_UUID_SIZE];
+};
+
+static void get_pipeline_cache_key(const struct vkcontext *vk, struct pipeline_cache_key *key)
+{
+    const VkPhysicalDeviceProperties *props = &vk->phy_device_props;
+    memset(key, 0, sizeof(*key));
+    key->vendor_id = props->vendorID;
+    key->device_id = props->deviceID;
+    memcpy(key->uuid, props->pipelineCacheUUID, sizeof(key->uuid));
+}
+
+static VkResult create_pipeline_cache(struct gpu_ctx *s)
+{
+    const struct ngl_config *config = &s->config;
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    s_priv->pipeline_objects = ngli_hmap_create();
+    if (!s_priv->pipeline_objects)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    void *data = NULL;
+    size_t size = 0;
+    if (config->cache_dir) {
+        struct pipeline_cache_key key;
+        get_pipeline_cache_key(vk, &key);
+        ngli_diskcache_load(config->cache_dir, PIPELINE_CACHE_NAMESPACE, &key, sizeof(key), &data, &size);
+    }
+
+    /* The initial data is validated by the driver and ignored if incompatible */
+    const VkPipelineCacheCreateInfo create_info = {
+        .sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = size,
+        .pInitialData    = data,
+    };
+    VkResult res = vkCreatePipelineCache(vk->device, &create_info, NULL, &s_priv->pipeline_cache);
+    ngli_free(data);
+    return res;
+}
+
+static void store_pipeline_cache(struct gpu_ctx *s)
+{
+    const struct ngl_config *config = &s->config;
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    if (!config->cache_dir || !s_priv->pipeline_cache)
+        return;
+
+    size_t size = 0;
+    VkResult res = vkGetPipelineCacheData(vk->device, s_priv->pipeline_cache, &size, NULL);
+    if (res != VK_SUCCESS || !size)
+        return;
+
+    void *data = ngli_malloc(size);
+    if (!data)
+        return;
+
+    res = vkGetPipelineCacheData(vk->device, s_priv->pipeline_cache, &size, data);
+    if (res == VK_SUCCESS) {
+        struct pipeline_cache_key key;
+        get_pipeline_cache_key(vk, &key);
+        ngli_diskcache_store(config->cache_dir, PIPELINE_CACHE_NAMESPACE, &key, sizeof(key), data, size);
+    }
+    ngli_free(data);
+}
+
+static void destroy_pipeline_cache(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+    struct vkcontext *vk = s_priv->vkcontext;
+
+    store_pipeline_cache(s);
+    vkDestroyPipelineCache(vk->device, s_priv->pipeline_cache, NULL);
+
+    /* Entries are removed by the last pipeline referencing them */
+    ngli_assert(!s_priv->pipeline_objects || !ngli_hmap_count(s_priv->pipeline_objects));
+    ngli_hmap_freep(&s_priv->pipeline_objects);
+}
+
 static VkResult create_command_pool_and_buffers(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -398,6 +496,34 @@ static void destroy_command_pool_and_buffers(struct gpu_ctx *s)
     ngli_darray_reset(&s_priv->pending_cmds);
 }
 
+static VkResult create_stagings(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    s_priv->stagings = ngli_calloc(s_priv->nb_in_flight_frames, sizeof(*s_priv->stagings));
+    if (!s_priv->stagings)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    for (uint32_t i = 0; i < s_priv->nb_in_flight_frames; i++)
+        ngli_staging_vk_init(&s_priv->stagings[i], s);
+    ngli_staging_vk_init(&s_priv->transient_staging, s);
+
+    return VK_SUCCESS;
+}
+
+static void destroy_stagings(struct gpu_ctx *s)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    if (!s_priv->stagings)
+        return;
+
+    for (uint32_t i = 0; i < s_priv->nb_in_flight_frames; i++)
+        ngli_staging_vk_uninit(&s_priv->stagings[i]);
+    ngli_freep(&s_priv->stagings);
+    ngli_staging_vk_uninit(&s_priv->transient_staging);
+}
+
 static VkResult create_semaphores(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -934,6 +1060,10 @@ static int vk_init(struct gpu_ctx *s)
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    res = create_pipeline_cache(s);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
     res = create_semaphores(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
@@ -942,6 +1072,10 @@ static int vk_init(struct gpu_ctx *s)
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    res = create_stagings(s);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
     res = create_dummy_texture(s);
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
@@ -1052,8 +1186,20 @@ static int vk_begin_update(struct gpu_ctx *s, double t)
     if (res != VK_SUCCESS)
         return ngli_vk_res2ret(res);
 
+    /* The command buffer is about to be recycled, release the capture slots it was writing to */
+    if (s_priv->capture_slots) {
+        for (size_t i = 0; i < s->nb_capture_slots; i++) {
+            struct capture_slot_vk *slot = &s_priv->capture_slots[i];
+            if (slot->cmd == cmd_vk)
+                slot->cmd = NULL;
+        }
+    }
+
     s_priv->cur_frame_index = (s_priv->cur_frame_index + 1) % s_priv->nb_in_flight_frames;
 
+    /* Every command of the frame has completed, its staging memory can be recycled */
+    ngli_staging_vk_reset(&s_priv->stagings[s_priv->cur_frame_index]);
+
     s_priv->cur_cmd = s_priv->update_cmds[s_priv->cur_frame_index];
     res = ngli_cmd_vk_begin(s_priv->cur_cmd);
     if (res != VK_SUCCESS)
@@ -1070,6 +1216,26 @@ static int vk_end_update(struct gpu_ctx *s, double t)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
 
+    /* Make the buffer uploads of the update phase visible to every subsequent command */
+    const struct staging_vk *staging = &s_priv->stagings[s_priv->cur_frame_index];
+    if (staging->nb_copies) {
+        const VkMemoryBarrier barrier = {
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_INDEX_READ_BIT |
+                             VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                             VK_ACCESS_UNIFORM_READ_BIT |
+                             VK_ACCESS_SHADER_READ_BIT |
+                             VK_ACCESS_SHADER_WRITE_BIT |
+                             VK_ACCESS_TRANSFER_READ_BIT |
+                             VK_ACCESS_TRANSFER_WRITE_BIT,
+        };
+        vkCmdPipelineBarrier(s_priv->cur_cmd->cmd_buf,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0, 1, &barrier, 0, NULL, 0, NULL);
+    }
+
     VkSemaphore update_finished_sem = s_priv->update_finished_sems[s_priv->cur_frame_index];
     VkResult res = ngli_cmd_vk_add_signal_sem(s_priv->cur_cmd, &update_finished_sem);
     if (res != VK_SUCCESS)
@@ -1209,6 +1375,79 @@ static int vk_end_draw(struct gpu_ctx *s, double t)
     return 0;
 }
 
+static int capture_slot_init(struct gpu_ctx *s, struct capture_slot_vk *slot)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    slot->buffer = ngli_buffer_create(s);
+    if (!slot->buffer)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_buffer_init(slot->buffer,
+                               s_priv->capture_buffer_size,
+                               NGLI_BUFFER_USAGE_MAP_READ |
+                               NGLI_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (ret < 0)
+        return ret;
+
+    return ngli_buffer_map(slot->buffer, s_priv->capture_buffer_size, 0, &slot->mapped_data);
+}
+
+static int vk_end_draw_async(struct gpu_ctx *s, double t, size_t index)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    if (!s_priv->capture_slots) {
+        s_priv->capture_slots = ngli_calloc(s->nb_capture_slots, sizeof(*s_priv->capture_slots));
+        if (!s_priv->capture_slots)
+            return NGL_ERROR_MEMORY;
+    }
+
+    struct capture_slot_vk *slot = &s_priv->capture_slots[index];
+    if (!slot->buffer) {
+        int ret = capture_slot_init(s, slot);
+        if (ret < 0)
+            return ret;
+    }
+
+    /* Make sure the previous copy into this slot is complete before overwriting it */
+    if (slot->cmd) {
+        VkResult res = ngli_cmd_vk_wait(slot->cmd);
+        if (res != VK_SUCCESS)
+            return ngli_vk_res2ret(res);
+        slot->cmd = NULL;
+    }
+
+    struct texture **colors = ngli_darray_data(&s_priv->colors);
+    struct texture *color = colors[s_priv->cur_frame_index];
+    ngli_texture_vk_copy_to_buffer(color, slot->buffer);
+
+    VkResult res = ngli_cmd_vk_submit(s_priv->cur_cmd);
+    if (res != VK_SUCCESS)
+        return ngli_vk_res2ret(res);
+
+    slot->cmd = s_priv->cur_cmd;
+    s_priv->cur_cmd = NULL;
+
+    return 0;
+}
+
+static int vk_capture_acquire(struct gpu_ctx *s, size_t index, const uint8_t **datap)
+{
+    struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
+
+    struct capture_slot_vk *slot = &s_priv->capture_slots[index];
+    if (slot->cmd) {
+        VkResult res = ngli_cmd_vk_wait(slot->cmd);
+        if (res != VK_SUCCESS)
+            return ngli_vk_res2ret(res);
+        slot->cmd = NULL;
+    }
+
+    *datap = slot->mapped_data;
+    return 0;
+}
+
 static void vk_destroy(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -1226,11 +1465,13 @@ static void vk_destroy(struct gpu_ctx *s)
 #endif
 
     destroy_command_pool_and_buffers(s);
+    destroy_stagings(s);
     destroy_semaphores(s);
     destroy_dummy_texture(s);
     destroy_render_resources(s);
     destroy_swapchain(s);
     destroy_query_pool(s);
+    destroy_pipeline_cache(s);
 
     ngli_glslang_uninit();
 
@@ -1491,6 +1732,15 @@ static int vk_texture_upload(struct texture *s, const uint8_t *data, int linesiz
     return ngli_vk_res2ret(res);
 }
 
+static int vk_texture_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                                    int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    VkResult res = ngli_texture_vk_upload_region(s, data, linesize, x, y, width, height);
+    if (res != VK_SUCCESS)
+        LOG(ERROR, "unable to upload texture region: %s", ngli_vk_res2str(res));
+    return ngli_vk_res2ret(res);
+}
+
 static int vk_texture_generate_mipmap(struct texture *s)
 {
     VkResult res = ngli_texture_vk_generate_mipmap(s);
@@ -1526,6 +1776,8 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
     .begin_draw                         = vk_begin_draw,
     .query_draw_time                    = vk_query_draw_time,
     .end_draw                           = vk_end_draw,
+    .end_draw_async                     = vk_end_draw_async,
+    .capture_acquire                    = vk_capture_acquire,
     .wait_idle                          = vk_wait_idle,
     .destroy                            = vk_destroy,
 
@@ -1574,6 +1826,7 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
     .texture_create                     = ngli_texture_vk_create,
     .texture_init                       = vk_texture_init,
     .texture_upload                     = vk_texture_upload,
+    .texture_upload_region              = vk_texture_upload_region,
     .texture_generate_mipmap            = vk_texture_generate_mipmap,
     .texture_freep                      = ngli_texture_vk_freep,
 };
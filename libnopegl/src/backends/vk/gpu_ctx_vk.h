@@ -25,6 +25,13 @@
 #include "gpu_ctx.h"
 #include "vkcontext.h"
 #include "command_vk.h"
+#include "staging_vk.h"
+
+struct capture_slot_vk {
+    struct buffer *buffer;
+    void *mapped_data;
+    struct cmd_vk *cmd; /* command buffer writing into the slot, NULL once complete */
+};
 
 struct gpu_ctx_vk {
     struct gpu_ctx parent;
@@ -43,8 +50,25 @@ struct gpu_ctx_vk {
     struct cmd_vk *cur_cmd;
     int cur_cmd_is_transient;
 
+    /*
+     * Per in-flight frame staging memory: buffer uploads issued during the
+     * update phase are recorded in the frame update command buffer and their
+     * staging memory is recycled with the frame
+     */
+    struct staging_vk *stagings;
+
+    /*
+     * Staging memory of the uploads executed synchronously in a transient
+     * command buffer (outside of the frame loop, or outside of the update
+     * phase for buffers): it is recycled as soon as the copy has completed
+     */
+    struct staging_vk transient_staging;
+
     VkQueryPool query_pool;
 
+    VkPipelineCache pipeline_cache;
+    struct hmap *pipeline_objects;  // struct pipeline_objects_vk * indexed by key hash
+
     VkSurfaceCapabilitiesKHR surface_caps;
     VkSurfaceFormatKHR surface_format;
     VkPresentModeKHR present_mode;
@@ -69,6 +93,8 @@ struct gpu_ctx_vk {
     struct buffer *capture_buffer;
     int capture_buffer_size;
     void *mapped_data;
+    /* Asynchronous capture slots (lazily allocated) */
+    struct capture_slot_vk *capture_slots;
 
     struct rendertarget *default_rt;
     struct rendertarget *default_rt_load;
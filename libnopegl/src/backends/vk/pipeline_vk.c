@@ -20,6 +20,7 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -341,7 +342,7 @@ static VkResult pipeline_graphics_init(struct pipeline *s)
         .renderPass          = render_pass,
         .subpass             = 0,
     };
-    res = vkCreateGraphicsPipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    res = vkCreateGraphicsPipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 
     vkDestroyRenderPass(vk->device, render_pass, NULL);
 
@@ -368,7 +369,7 @@ static VkResult pipeline_compute_init(struct pipeline *s)
         .layout = s_priv->pipeline_layout,
     };
 
-    return vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
+    return vkCreateComputePipelines(vk->device, gpu_ctx_vk->pipeline_cache, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 }
 
 static const VkShaderStageFlags stage_flag_map[NGLI_PROGRAM_SHADER_NB] = {
@@ -568,44 +569,194 @@ static VkResult create_pipeline_layout(struct pipeline *s)
     return vkCreatePipelineLayout(vk->device, &pipeline_layout_create_info, NULL, &s_priv->pipeline_layout);
 }
 
-static VkResult create_pipeline(struct pipeline *s)
+static VkResult key_append(struct darray *key, const void *data, size_t size)
 {
-    VkResult res = create_desc_layout(s);
-    if (res != VK_SUCCESS)
-        return res;
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        if (!ngli_darray_push(key, &bytes[i]))
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return VK_SUCCESS;
+}
 
-    res = create_desc_sets(s);
-    if (res != VK_SUCCESS)
-        return res;
+/*
+ * Serialize everything the shared pipeline objects are derived from. The
+ * structures are serialized field by field (or only when they are known to be
+ * free of padding) so that the key can be compared with memcmp().
+ */
+static VkResult build_objects_key(const struct pipeline *s, struct darray *key)
+{
+    const struct pipeline_vk *s_priv = (const struct pipeline_vk *)s;
 
-    res = create_pipeline_layout(s);
-    if (res != VK_SUCCESS)
+    VkResult res;
+    if ((res = key_append(key, &s->type, sizeof(s->type))) != VK_SUCCESS ||
+        (res = key_append(key, &s->program, sizeof(s->program))) != VK_SUCCESS)
         return res;
 
     if (s->type == NGLI_PIPELINE_TYPE_GRAPHICS) {
-        res = pipeline_graphics_init(s);
-    } else if (s->type == NGLI_PIPELINE_TYPE_COMPUTE) {
-        res = pipeline_compute_init(s);
-    } else {
-        ngli_assert(0);
+        const struct pipeline_graphics *graphics = &s->graphics;
+        const struct rendertarget_layout *rt_layout = &graphics->rt_layout;
+        const size_t nb_binding_descs = ngli_darray_count(&s_priv->vertex_binding_descs);
+        const size_t nb_attribute_descs = ngli_darray_count(&s_priv->vertex_attribute_descs);
+        if ((res = key_append(key, &graphics->topology, sizeof(graphics->topology))) != VK_SUCCESS ||
+            (res = key_append(key, &graphics->state, sizeof(graphics->state))) != VK_SUCCESS ||
+            (res = key_append(key, &rt_layout->samples, sizeof(rt_layout->samples))) != VK_SUCCESS ||
+            (res = key_append(key, &rt_layout->nb_colors, sizeof(rt_layout->nb_colors))) != VK_SUCCESS ||
+            (res = key_append(key, rt_layout->colors, rt_layout->nb_colors * sizeof(*rt_layout->colors))) != VK_SUCCESS ||
+            (res = key_append(key, &rt_layout->depth_stencil, sizeof(rt_layout->depth_stencil))) != VK_SUCCESS ||
+            (res = key_append(key, &nb_binding_descs, sizeof(nb_binding_descs))) != VK_SUCCESS ||
+            (res = key_append(key, ngli_darray_data(&s_priv->vertex_binding_descs),
+                              nb_binding_descs * sizeof(VkVertexInputBindingDescription))) != VK_SUCCESS ||
+            (res = key_append(key, &nb_attribute_descs, sizeof(nb_attribute_descs))) != VK_SUCCESS ||
+            (res = key_append(key, ngli_darray_data(&s_priv->vertex_attribute_descs),
+                              nb_attribute_descs * sizeof(VkVertexInputAttributeDescription))) != VK_SUCCESS)
+            return res;
+    }
+
+    const VkDescriptorSetLayoutBinding *bindings = ngli_darray_data(&s_priv->desc_set_layout_bindings);
+    for (size_t i = 0; i < ngli_darray_count(&s_priv->desc_set_layout_bindings); i++) {
+        const VkDescriptorSetLayoutBinding *binding = &bindings[i];
+        const VkSampler sampler = binding->pImmutableSamplers ? *binding->pImmutableSamplers : VK_NULL_HANDLE;
+        if ((res = key_append(key, &binding->binding, sizeof(binding->binding))) != VK_SUCCESS ||
+            (res = key_append(key, &binding->descriptorType, sizeof(binding->descriptorType))) != VK_SUCCESS ||
+            (res = key_append(key, &binding->descriptorCount, sizeof(binding->descriptorCount))) != VK_SUCCESS ||
+            (res = key_append(key, &binding->stageFlags, sizeof(binding->stageFlags))) != VK_SUCCESS ||
+            (res = key_append(key, &sampler, sizeof(sampler))) != VK_SUCCESS)
+            return res;
     }
+
     return VK_SUCCESS;
 }
 
-static void destroy_pipeline_keep_pool(struct pipeline *s)
+static void destroy_objects(struct vkcontext *vk, struct pipeline_objects_vk *objects)
+{
+    vkDestroyPipeline(vk->device, objects->pipeline, NULL);
+    vkDestroyPipelineLayout(vk->device, objects->pipeline_layout, NULL);
+    vkDestroyDescriptorSetLayout(vk->device, objects->desc_set_layout, NULL);
+    ngli_darray_reset(&objects->key);
+    ngli_free(objects);
+}
+
+static VkResult create_objects(struct pipeline *s, struct pipeline_objects_vk *objects)
+{
+    struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
+
+    VkResult res = create_desc_layout(s);
+    if (res == VK_SUCCESS)
+        res = create_pipeline_layout(s);
+    if (res == VK_SUCCESS) {
+        if (s->type == NGLI_PIPELINE_TYPE_GRAPHICS) {
+            res = pipeline_graphics_init(s);
+        } else if (s->type == NGLI_PIPELINE_TYPE_COMPUTE) {
+            res = pipeline_compute_init(s);
+        } else {
+            ngli_assert(0);
+        }
+    }
+
+    /* Hand over the objects (even partially created ones) to the entry */
+    objects->desc_set_layout = s_priv->desc_set_layout;
+    objects->pipeline_layout = s_priv->pipeline_layout;
+    objects->pipeline = s_priv->pipeline;
+    return res;
+}
+
+static VkResult acquire_objects(struct pipeline *s)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
 
-    vkDestroyPipeline(vk->device, s_priv->pipeline, NULL);
-    s_priv->pipeline = VK_NULL_HANDLE;
+    struct pipeline_objects_vk *objects = ngli_calloc(1, sizeof(*objects));
+    if (!objects)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    ngli_darray_init(&objects->key, sizeof(uint8_t), 0);
 
-    vkDestroyPipelineLayout(vk->device, s_priv->pipeline_layout, NULL);
-    s_priv->pipeline_layout = VK_NULL_HANDLE;
+    VkResult res = build_objects_key(s, &objects->key);
+    if (res != VK_SUCCESS) {
+        destroy_objects(vk, objects);
+        return res;
+    }
+
+    const uint8_t *key = ngli_darray_data(&objects->key);
+    const size_t key_size = ngli_darray_count(&objects->key);
+    objects->hash = ngli_hash64_mem(key, key_size);
+    snprintf(objects->map_key, sizeof(objects->map_key), "%016" PRIx64, objects->hash);
+
+    /* The map only indexes the entries by hash, the full key is verified here */
+    struct pipeline_objects_vk *entry =
+        ngli_hmap_get_prehashed(gpu_ctx_vk->pipeline_objects, objects->map_key, objects->hash);
+    if (entry && ngli_darray_count(&entry->key) == key_size &&
+        !memcmp(ngli_darray_data(&entry->key), key, key_size)) {
+        destroy_objects(vk, objects);
+        entry->refcount++;
+        s_priv->objects = entry;
+        s_priv->desc_set_layout = entry->desc_set_layout;
+        s_priv->pipeline_layout = entry->pipeline_layout;
+        s_priv->pipeline = entry->pipeline;
+        return VK_SUCCESS;
+    }
+
+    /*
+     * On the unlikely collision with an entry of a different key, the new
+     * objects are not registered and remain private to this pipeline.
+     */
+    res = create_objects(s, objects);
+    if (res == VK_SUCCESS && !entry) {
+        if (ngli_hmap_set_prehashed(gpu_ctx_vk->pipeline_objects, objects->map_key, objects->hash, objects) < 0)
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        else
+            objects->shared = 1;
+    }
+    if (res != VK_SUCCESS) {
+        destroy_objects(vk, objects);
+        s_priv->desc_set_layout = VK_NULL_HANDLE;
+        s_priv->pipeline_layout = VK_NULL_HANDLE;
+        s_priv->pipeline = VK_NULL_HANDLE;
+        return res;
+    }
+    objects->refcount = 1;
+    s_priv->objects = objects;
+
+    return VK_SUCCESS;
+}
+
+static void release_objects(struct pipeline *s)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+    struct pipeline_vk *s_priv = (struct pipeline_vk *)s;
+
+    struct pipeline_objects_vk *objects = s_priv->objects;
+    if (!objects)
+        return;
 
-    vkDestroyDescriptorSetLayout(vk->device, s_priv->desc_set_layout, NULL);
+    s_priv->objects = NULL;
     s_priv->desc_set_layout = VK_NULL_HANDLE;
+    s_priv->pipeline_layout = VK_NULL_HANDLE;
+    s_priv->pipeline = VK_NULL_HANDLE;
+
+    ngli_assert(objects->refcount > 0);
+    if (--objects->refcount)
+        return;
+
+    if (objects->shared)
+        ngli_hmap_set_prehashed(gpu_ctx_vk->pipeline_objects, objects->map_key, objects->hash, NULL);
+    destroy_objects(vk, objects);
+}
+
+static VkResult create_pipeline(struct pipeline *s)
+{
+    VkResult res = acquire_objects(s);
+    if (res != VK_SUCCESS)
+        return res;
+
+    return create_desc_sets(s);
+}
+
+static void destroy_pipeline_keep_pool(struct pipeline *s)
+{
+    release_objects(s);
 }
 
 static void destroy_pipeline(struct pipeline *s)
@@ -29,6 +29,24 @@
 
 struct gpu_ctx;
 
+/*
+ * Vulkan objects which only depend on the pipeline description (program,
+ * graphics state, rendertarget layout, vertex state and resource layout).
+ * They are shared between all the pipelines with an identical description,
+ * typically a node reached through several branches of the graph. The
+ * descriptor sets, which reference the bound resources, remain per pipeline.
+ */
+struct pipeline_objects_vk {
+    uint64_t hash;
+    char map_key[17];                       // hexadecimal hash, key in gpu_ctx_vk.pipeline_objects
+    int shared;                             // whether the entry is registered in the map
+    struct darray key;                      // array of uint8_t
+    VkDescriptorSetLayout desc_set_layout;
+    VkPipelineLayout pipeline_layout;
+    VkPipeline pipeline;
+    size_t refcount;
+};
+
 struct pipeline_vk {
     struct pipeline parent;
 
@@ -44,6 +62,7 @@ struct pipeline_vk {
     VkDescriptorSet *desc_sets;
     VkPipelineLayout pipeline_layout;
     VkPipeline pipeline;
+    struct pipeline_objects_vk *objects;
 };
 
 struct pipeline *ngli_pipeline_vk_create(struct gpu_ctx *gpu_ctx);
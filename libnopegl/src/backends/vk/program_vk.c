@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "diskcache.h"
 #include "glslang_utils.h"
 #include "gpu_ctx_vk.h"
 #include "internal.h"
@@ -40,11 +41,40 @@ struct program *ngli_program_vk_create(struct gpu_ctx *gpu_ctx)
     return (struct program *)s;
 }
 
+#define CACHE_NAMESPACE "spirv"
+
+static char *get_cache_key(int stage, const char *src)
+{
+    return ngli_asprintf("%d\n%s", stage, src);
+}
+
+static int compile_shader(const char *cache_dir, int stage, const char *src, void **datap, size_t *sizep)
+{
+    if (!cache_dir)
+        return ngli_glslang_compile(stage, src, datap, sizep);
+
+    char *key = get_cache_key(stage, src);
+    if (!key)
+        return NGL_ERROR_MEMORY;
+
+    const size_t key_size = strlen(key);
+    int ret = ngli_diskcache_load(cache_dir, CACHE_NAMESPACE, key, key_size, datap, sizep);
+    if (ret == NGL_ERROR_NOT_FOUND) {
+        ret = ngli_glslang_compile(stage, src, datap, sizep);
+        if (ret >= 0)
+            ngli_diskcache_store(cache_dir, CACHE_NAMESPACE, key, key_size, *datap, *sizep);
+    }
+
+    ngli_free(key);
+    return ret;
+}
+
 int ngli_program_vk_init(struct program *s, const struct program_params *params)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
     struct program_vk *s_priv = (struct program_vk *)s;
+    const struct ngl_config *config = &s->gpu_ctx->config;
 
     const struct {
         int stage;
@@ -61,7 +91,7 @@ int ngli_program_vk_init(struct program *s, const struct program_params *params)
 
         void *data = NULL;
         size_t size = 0;
-        int ret = ngli_glslang_compile(shaders[i].stage, shaders[i].src, &data, &size);
+        int ret = compile_shader(config->cache_dir, shaders[i].stage, shaders[i].src, &data, &size);
         if (ret < 0) {
             char *s_with_numbers = ngli_numbered_lines(shaders[i].src);
             if (s_with_numbers) {
@@ -181,21 +181,35 @@ static VkResult vk_create_compatible_renderpass(struct gpu_ctx *s, const struct
         .pDepthStencilAttachment = has_ds_ref ? &depth_stencil_ref : NULL,
     };
 
+    /*
+     * The depth/stencil and multisampled attachments may be shared between
+     * consecutive render passes (see texturepool.c): on top of waiting for the
+     * previous reads, the first accesses of this pass must be ordered after
+     * the color and depth/stencil writes of the previous passes.
+     */
+    const VkPipelineStageFlags attachment_stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    const VkAccessFlags attachment_writes = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    const VkAccessFlags attachment_accesses = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                              attachment_writes;
     const VkSubpassDependency dependencies[2] = {
         {
             .srcSubpass      = VK_SUBPASS_EXTERNAL,
             .dstSubpass      = 0,
-            .srcStageMask    = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-            .dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            .srcAccessMask   = VK_ACCESS_MEMORY_READ_BIT,
-            .dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .srcStageMask    = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | attachment_stages,
+            .dstStageMask    = attachment_stages,
+            .srcAccessMask   = attachment_writes,
+            .dstAccessMask   = attachment_accesses,
             .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
         }, {
             .srcSubpass      = 0,
             .dstSubpass      = VK_SUBPASS_EXTERNAL,
-            .srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .srcStageMask    = attachment_stages,
             .dstStageMask    = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-            .srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .srcAccessMask   = attachment_accesses,
             .dstAccessMask   = VK_ACCESS_MEMORY_READ_BIT,
             .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
         }
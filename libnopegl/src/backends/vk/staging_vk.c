@@ -0,0 +1,142 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+
+#include "buffer_vk.h"
+#include "staging_vk.h"
+#include "utils.h"
+
+#define STAGING_CHUNK_SIZE (4 << 20)
+#define STAGING_ALIGNMENT  16
+
+struct staging_chunk_vk {
+    struct buffer *buffer;
+    uint8_t *mapped_data;
+    size_t offset;
+};
+
+static VkResult chunk_init(struct staging_chunk_vk *chunk, struct gpu_ctx *gpu_ctx, size_t size)
+{
+    chunk->buffer = ngli_buffer_vk_create(gpu_ctx);
+    if (!chunk->buffer)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    chunk->buffer->size = size;
+    chunk->buffer->usage = NGLI_BUFFER_USAGE_MAP_WRITE | NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    VkResult res = ngli_buffer_vk_init(chunk->buffer);
+    if (res != VK_SUCCESS)
+        return res;
+
+    return ngli_buffer_vk_map(chunk->buffer, size, 0, (void **)&chunk->mapped_data);
+}
+
+static void chunk_reset(struct staging_chunk_vk *chunk)
+{
+    if (chunk->mapped_data)
+        ngli_buffer_vk_unmap(chunk->buffer);
+    ngli_buffer_vk_freep(&chunk->buffer);
+}
+
+void ngli_staging_vk_init(struct staging_vk *s, struct gpu_ctx *gpu_ctx)
+{
+    s->gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->chunks, sizeof(struct staging_chunk_vk), 0);
+}
+
+/* The alignment is not necessarily a power of 2 (e.g. 12-byte texels) */
+static size_t align_offset(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+VkResult ngli_staging_vk_alloc(struct staging_vk *s, size_t size, size_t alignment, struct staging_alloc_vk *alloc)
+{
+    struct staging_chunk_vk *chunks = ngli_darray_data(&s->chunks);
+    const size_t nb_chunks = ngli_darray_count(&s->chunks);
+
+    /* Chunks are filled in order, only the current one and the next ones have free space */
+    struct staging_chunk_vk *chunk = NULL;
+    for (; s->cur_chunk < nb_chunks; s->cur_chunk++) {
+        struct staging_chunk_vk *cur = &chunks[s->cur_chunk];
+        if (align_offset(cur->offset, alignment) + size <= cur->buffer->size) {
+            chunk = cur;
+            break;
+        }
+    }
+
+    if (!chunk) {
+        struct staging_chunk_vk new_chunk = {0};
+        VkResult res = chunk_init(&new_chunk, s->gpu_ctx, NGLI_MAX(size, STAGING_CHUNK_SIZE));
+        if (res != VK_SUCCESS) {
+            chunk_reset(&new_chunk);
+            return res;
+        }
+
+        chunk = ngli_darray_push(&s->chunks, &new_chunk);
+        if (!chunk) {
+            chunk_reset(&new_chunk);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        s->cur_chunk = ngli_darray_count(&s->chunks) - 1;
+    }
+
+    chunk->offset = align_offset(chunk->offset, alignment);
+
+    alloc->buffer = ((struct buffer_vk *)chunk->buffer)->buffer;
+    alloc->offset = chunk->offset;
+    alloc->mapped_data = chunk->mapped_data + chunk->offset;
+
+    chunk->offset = NGLI_ALIGN(chunk->offset + size, STAGING_ALIGNMENT);
+
+    return VK_SUCCESS;
+}
+
+void ngli_staging_vk_reset(struct staging_vk *s)
+{
+    /*
+     * Chunks allocated for an oversized upload are not kept around since
+     * they are unlikely to be reused in the same way
+     */
+    size_t i = 0;
+    while (i < ngli_darray_count(&s->chunks)) {
+        struct staging_chunk_vk *chunk = ngli_darray_get(&s->chunks, i);
+        if (chunk->buffer->size > STAGING_CHUNK_SIZE) {
+            chunk_reset(chunk);
+            ngli_darray_remove(&s->chunks, i);
+            continue;
+        }
+        chunk->offset = 0;
+        i++;
+    }
+    s->cur_chunk = 0;
+    s->nb_copies = 0;
+}
+
+void ngli_staging_vk_uninit(struct staging_vk *s)
+{
+    struct staging_chunk_vk *chunks = ngli_darray_data(&s->chunks);
+    for (size_t i = 0; i < ngli_darray_count(&s->chunks); i++)
+        chunk_reset(&chunks[i]);
+    ngli_darray_reset(&s->chunks);
+    s->cur_chunk = 0;
+    s->nb_copies = 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STAGING_VK_H
+#define STAGING_VK_H
+
+#include <vulkan/vulkan.h>
+
+#include "darray.h"
+
+struct gpu_ctx;
+struct buffer;
+
+/*
+ * Linear allocator of host visible transfer memory.
+ *
+ * The memory is sub-allocated from a set of large persistently mapped chunks.
+ * Allocations cannot be released individually: the whole staging memory is
+ * recycled at once with ngli_staging_vk_reset(), which must only be called
+ * once every command reading from it has completed (typically when the frame
+ * owning it is recycled).
+ *
+ * Every allocation starts at a multiple of the requested alignment, which
+ * does not need to be a power of 2.
+ */
+
+struct staging_alloc_vk {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    void *mapped_data;
+};
+
+struct staging_vk {
+    struct gpu_ctx *gpu_ctx;
+    struct darray chunks; /* array of struct staging_chunk_vk */
+    size_t cur_chunk;
+    size_t nb_copies; /* number of copies recorded from this staging memory */
+};
+
+void ngli_staging_vk_init(struct staging_vk *s, struct gpu_ctx *gpu_ctx);
+VkResult ngli_staging_vk_alloc(struct staging_vk *s, size_t size, size_t alignment, struct staging_alloc_vk *alloc);
+void ngli_staging_vk_reset(struct staging_vk *s);
+void ngli_staging_vk_uninit(struct staging_vk *s);
+
+#endif
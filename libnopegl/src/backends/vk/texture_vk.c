@@ -539,6 +539,46 @@ void ngli_texture_vk_copy_to_buffer(struct texture *s, struct buffer *buffer)
                            buffer_vk->buffer, 1, &region);
 }
 
+/*
+ * A copy recorded in the current frame command buffer reads from the frame
+ * staging memory, recycled with the frame, while a copy executed in a
+ * transient command buffer completes before the upload returns: its staging
+ * memory is recycled right away.
+ */
+static struct staging_vk *get_staging(struct gpu_ctx_vk *gpu_ctx_vk, int cmd_is_transient)
+{
+    if (cmd_is_transient)
+        return &gpu_ctx_vk->transient_staging;
+    return &gpu_ctx_vk->stagings[gpu_ctx_vk->cur_frame_index];
+}
+
+/*
+ * Only the copies recorded in the frame update command buffer are made
+ * visible by the barrier submitted at the end of the update, the ones
+ * recorded elsewhere carry their own layout transitions.
+ */
+static void register_copy(struct gpu_ctx_vk *gpu_ctx_vk, struct staging_vk *staging, const struct cmd_vk *cmd_vk)
+{
+    if (cmd_vk == gpu_ctx_vk->update_cmds[gpu_ctx_vk->cur_frame_index])
+        staging->nb_copies++;
+}
+
+/*
+ * The buffer offset of a buffer to image copy must be a multiple of 4 and of
+ * the texel size
+ */
+static size_t get_copy_alignment(const struct texture_vk *s_priv)
+{
+    const size_t bpp = s_priv->bytes_per_pixel;
+    size_t a = bpp, b = 4;
+    while (b) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return bpp / a * 4;
+}
+
 VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int linesize)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
@@ -552,44 +592,31 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
     if (!data)
         return VK_SUCCESS;
 
-    if (!s_priv->staging_buffer || s_priv->staging_buffer_row_length != linesize) {
-        const int32_t width = linesize ? linesize : s->params.width;
-        const int32_t staging_buffer_size = width * s->params.height * s->params.depth * s_priv->bytes_per_pixel * s_priv->array_layers;
-
-        if (s_priv->staging_buffer) {
-            if (s_priv->staging_buffer_ptr) {
-                ngli_buffer_unmap(s_priv->staging_buffer);
-                s_priv->staging_buffer_ptr = NULL;
-            }
-            ngli_buffer_freep(&s_priv->staging_buffer);
-        }
-
-        s_priv->staging_buffer = ngli_buffer_create(s->gpu_ctx);
-        if (!s_priv->staging_buffer)
-            return VK_ERROR_OUT_OF_HOST_MEMORY;
-
-        const int usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT |
-                          NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT |
-                          NGLI_BUFFER_USAGE_MAP_WRITE;
-        int ret = ngli_buffer_init(s_priv->staging_buffer, staging_buffer_size, usage);
-        if (ret < 0)
-            return VK_ERROR_UNKNOWN;
-
-        s_priv->staging_buffer_row_length = linesize;
-
-        ret = ngli_buffer_map(s_priv->staging_buffer, staging_buffer_size, 0, &s_priv->staging_buffer_ptr);
-        if (ret < 0)
-            return VK_ERROR_UNKNOWN;
-    }
-
-    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
-
+    /*
+     * The data is copied into the frame staging memory, which is only
+     * recycled once the frame has completed: the upload does not have to wait
+     * for the previous transfers to finish, and during the update phase the
+     * copy is recorded in the frame update command buffer so that it overlaps
+     * with the rendering of the previous frames
+     */
+    const int32_t row_length = linesize ? linesize : params->width;
+    const VkDeviceSize layer_size = (VkDeviceSize)row_length * params->height * params->depth * s_priv->bytes_per_pixel;
     struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
     const int cmd_is_transient = cmd_vk ? 0 : 1;
+    struct staging_vk *staging = get_staging(gpu_ctx_vk, cmd_is_transient);
+    struct staging_alloc_vk alloc;
+    VkResult res = ngli_staging_vk_alloc(staging, layer_size * s_priv->array_layers,
+                                         get_copy_alignment(s_priv), &alloc);
+    if (res != VK_SUCCESS)
+        return res;
+    memcpy(alloc.mapped_data, data, layer_size * s_priv->array_layers);
+
     if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
-        if (res != VK_SUCCESS)
+        res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+        if (res != VK_SUCCESS) {
+            ngli_staging_vk_reset(staging);
             return res;
+        }
     }
     VkCommandBuffer cmd_buf = cmd_vk->cmd_buf;
 
@@ -609,9 +636,8 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
     struct darray copy_regions;
     ngli_darray_init(&copy_regions, sizeof(VkBufferImageCopy), 0);
 
-    const VkDeviceSize layer_size = s->params.width * s->params.height * s_priv->bytes_per_pixel;
     for (int32_t i = 0; i < s_priv->array_layers; i++) {
-        const VkDeviceSize offset = i * layer_size;
+        const VkDeviceSize offset = alloc.offset + i * layer_size;
         const VkBufferImageCopy region = {
             .bufferOffset      = offset,
             .bufferRowLength   = linesize,
@@ -633,20 +659,21 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
             ngli_darray_reset(&copy_regions);
             if (cmd_is_transient) {
                 ngli_cmd_vk_freep(&cmd_vk);
+                ngli_staging_vk_reset(staging);
             }
             return VK_ERROR_OUT_OF_HOST_MEMORY;
         }
     }
 
-    struct buffer_vk *staging_buffer_vk = (struct buffer_vk *)s_priv->staging_buffer;
     vkCmdCopyBufferToImage(cmd_buf,
-                           staging_buffer_vk->buffer,
+                           alloc.buffer,
                            s_priv->image,
                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                            (uint32_t)ngli_darray_count(&copy_regions),
                            ngli_darray_data(&copy_regions));
 
     ngli_darray_reset(&copy_regions);
+    register_copy(gpu_ctx_vk, staging, cmd_vk);
 
     transition_image_layout(cmd_buf,
                             s_priv->image,
@@ -655,7 +682,97 @@ VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int line
                             &subres_range);
 
     if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        ngli_staging_vk_reset(staging);
+        if (res != VK_SUCCESS)
+            return res;
+    }
+
+    if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        ngli_texture_generate_mipmap(s);
+
+    return VK_SUCCESS;
+}
+
+VkResult ngli_texture_vk_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                                       int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    const struct texture_params *params = &s->params;
+    struct texture_vk *s_priv = (struct texture_vk *)s;
+
+    ngli_assert(!s_priv->wrapped_image);
+    ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
+
+    if (!linesize)
+        linesize = width;
+
+    /*
+     * The region is packed into the frame staging memory so that several
+     * regions of the same texture can be uploaded within the same command
+     * buffer without overwriting each other
+     */
+    const size_t row_size = (size_t)width * s_priv->bytes_per_pixel;
+    const size_t src_row_size = (size_t)linesize * s_priv->bytes_per_pixel;
+    struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
+    const int cmd_is_transient = cmd_vk ? 0 : 1;
+    struct staging_vk *staging = get_staging(gpu_ctx_vk, cmd_is_transient);
+    struct staging_alloc_vk alloc;
+    VkResult res = ngli_staging_vk_alloc(staging, row_size * height, get_copy_alignment(s_priv), &alloc);
+    if (res != VK_SUCCESS)
+        return res;
+    uint8_t *dst = alloc.mapped_data;
+    for (int32_t i = 0; i < height; i++)
+        memcpy(dst + i * row_size, data + i * src_row_size, row_size);
+
+    if (cmd_is_transient) {
+        res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+        if (res != VK_SUCCESS) {
+            ngli_staging_vk_reset(staging);
+            return res;
+        }
+    }
+    VkCommandBuffer cmd_buf = cmd_vk->cmd_buf;
+
+    const VkImageSubresourceRange subres_range = {
+        .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
+        .baseMipLevel   = 0,
+        .levelCount     = 1,
+        .baseArrayLayer = 0,
+        .layerCount     = 1,
+    };
+    transition_image_layout(cmd_buf,
+                            s_priv->image,
+                            s_priv->image_layout,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            &subres_range);
+
+    const VkBufferImageCopy region = {
+        .bufferOffset      = alloc.offset,
+        .bufferRowLength   = 0,
+        .bufferImageHeight = 0,
+        .imageSubresource = {
+            .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
+            .mipLevel       = 0,
+            .baseArrayLayer = 0,
+            .layerCount     = 1,
+        },
+        .imageOffset = {x, y, 0},
+        .imageExtent = {width, height, 1},
+    };
+    vkCmdCopyBufferToImage(cmd_buf, alloc.buffer, s_priv->image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    register_copy(gpu_ctx_vk, staging, cmd_vk);
+
+    transition_image_layout(cmd_buf,
+                            s_priv->image,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            s_priv->image_layout,
+                            &subres_range);
+
+    if (cmd_is_transient) {
+        res = ngli_cmd_vk_execute_transient(&cmd_vk);
+        ngli_staging_vk_reset(staging);
         if (res != VK_SUCCESS)
             return res;
     }
@@ -815,9 +932,5 @@ void ngli_texture_vk_freep(struct texture **sp)
         vkDestroyImage(vk->device, s_priv->image, NULL);
     vkFreeMemory(vk->device, s_priv->image_memory, NULL);
 
-    if (s_priv->staging_buffer_ptr)
-        ngli_buffer_unmap(s_priv->staging_buffer);
-    ngli_buffer_freep(&s_priv->staging_buffer);
-
     ngli_freep(sp);
 }
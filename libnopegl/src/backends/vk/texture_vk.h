@@ -55,15 +55,14 @@ struct texture_vk {
     int wrapped_sampler;
     int use_ycbcr_sampler;
     struct ycbcr_sampler_vk *ycbcr_sampler;
-    struct buffer *staging_buffer;
-    VkDeviceSize staging_buffer_row_length;
-    void *staging_buffer_ptr;
 };
 
 struct texture *ngli_texture_vk_create(struct gpu_ctx *gpu_ctx);
 VkResult ngli_texture_vk_init(struct texture *s, const struct texture_params *params);
 VkResult ngli_texture_vk_wrap(struct texture *s, const struct texture_vk_wrap_params *wrap_params);
 VkResult ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int linesize);
+VkResult ngli_texture_vk_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                                       int32_t x, int32_t y, int32_t width, int32_t height);
 VkResult ngli_texture_vk_generate_mipmap(struct texture *s);
 void ngli_texture_vk_transition_layout(struct texture *s, VkImageLayout layout);
 void ngli_texture_vk_transition_to_default_layout(struct texture *s);
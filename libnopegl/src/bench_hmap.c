@@ -0,0 +1,108 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "hmap.h"
+#include "utils.h"
+
+#define NB_KEYS    4096
+#define NB_LOOKUPS 64
+
+static char keys[NB_KEYS][32];
+
+#define BENCH(name, code) do {                                          \
+    const int64_t t0 = ngli_gettime_relative();                         \
+    code                                                                \
+    const int64_t t1 = ngli_gettime_relative();                         \
+    printf("%-24s %8" PRId64 " us\n", name, t1 - t0);                   \
+} while (0)
+
+int main(void)
+{
+    /* Key pattern similar to the uniform and resource names found in pass.c */
+    for (size_t i = 0; i < NB_KEYS; i++)
+        snprintf(keys[i], sizeof(keys[i]), "tex%zu_coord_matrix", i);
+
+    uint64_t hashes[NB_KEYS];
+    for (size_t i = 0; i < NB_KEYS; i++)
+        hashes[i] = ngli_hmap_hash_key(keys[i]);
+
+    struct hmap *hm = ngli_hmap_create();
+    if (!hm)
+        return 1;
+
+    size_t found = 0;
+
+    BENCH("insert", {
+        for (size_t i = 0; i < NB_KEYS; i++)
+            if (ngli_hmap_set(hm, keys[i], keys[i]) < 0)
+                return 1;
+    });
+
+    BENCH("lookup", {
+        for (size_t n = 0; n < NB_LOOKUPS; n++)
+            for (size_t i = 0; i < NB_KEYS; i++)
+                found += ngli_hmap_get(hm, keys[i]) != NULL;
+    });
+
+    BENCH("lookup (prehashed)", {
+        for (size_t n = 0; n < NB_LOOKUPS; n++)
+            for (size_t i = 0; i < NB_KEYS; i++)
+                found += ngli_hmap_get_prehashed(hm, keys[i], hashes[i]) != NULL;
+    });
+
+    BENCH("lookup (missing)", {
+        for (size_t n = 0; n < NB_LOOKUPS; n++)
+            for (size_t i = 0; i < NB_KEYS; i++)
+                found += ngli_hmap_get(hm, keys[i] + 1) != NULL;
+    });
+
+    BENCH("iterate", {
+        for (size_t n = 0; n < NB_LOOKUPS; n++) {
+            const struct hmap_entry *e = NULL;
+            while ((e = ngli_hmap_next(hm, e)))
+                found += e->data != NULL;
+        }
+    });
+
+    BENCH("delete and reinsert", {
+        for (size_t i = 0; i < NB_KEYS; i += 2)
+            if (ngli_hmap_set(hm, keys[i], NULL) < 0)
+                return 1;
+        for (size_t i = 0; i < NB_KEYS; i += 2)
+            if (ngli_hmap_set(hm, keys[i], keys[i]) < 0)
+                return 1;
+    });
+
+    BENCH("delete", {
+        for (size_t i = 0; i < NB_KEYS; i++)
+            if (ngli_hmap_set(hm, keys[i], NULL) < 0)
+                return 1;
+    });
+
+    printf("%zu entries found\n", found);
+
+    ngli_hmap_freep(&hm);
+    return 0;
+}
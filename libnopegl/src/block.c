@@ -223,6 +223,41 @@ void ngli_block_field_copy(const struct block_field *fi, uint8_t * restrict dst,
     }
 }
 
+/*
+ * Compare the packed src data against a field previously written with
+ * ngli_block_field_copy(), ignoring the layout padding.
+ */
+int ngli_block_field_equal(const struct block_field *fi, const uint8_t *dst, const uint8_t *src)
+{
+    const uint8_t *dstp = dst;
+    const uint8_t *srcp = src;
+
+    if (fi->type == NGLI_TYPE_MAT3) {
+        const size_t dst_vec_stride = fi->stride / 3;
+        const size_t src_vec_stride = sizes_map[NGLI_TYPE_VEC3];
+        const size_t count = 3 * NGLI_MAX(fi->count, 1);
+        for (size_t i = 0; i < count; i++) {
+            if (memcmp(dstp, srcp, src_vec_stride))
+                return 0;
+            dstp += dst_vec_stride;
+            srcp += src_vec_stride;
+        }
+        return 1;
+    }
+
+    const size_t src_stride = sizes_map[fi->type];
+    const size_t count = NGLI_MAX(fi->count, 1);
+    if (src_stride == fi->stride)
+        return !memcmp(dstp, srcp, src_stride * count);
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp(dstp, srcp, src_stride))
+            return 0;
+        dstp += fi->stride;
+        srcp += src_stride;
+    }
+    return 1;
+}
+
 void ngli_block_reset(struct block *s)
 {
     ngli_darray_reset(&s->fields);
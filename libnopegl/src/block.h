@@ -45,6 +45,7 @@ struct block_field {
 };
 
 void ngli_block_field_copy(const struct block_field *fi, uint8_t *dst, const uint8_t *src);
+int ngli_block_field_equal(const struct block_field *fi, const uint8_t *dst, const uint8_t *src);
 
 struct block {
     enum block_layout layout;
@@ -34,6 +34,7 @@ struct bstr {
     size_t len;
     size_t bufsize;
     int state;
+    uint64_t hash;
 };
 
 struct bstr *ngli_bstr_create(void)
@@ -49,6 +50,7 @@ struct bstr *ngli_bstr_create(void)
         return NULL;
     }
     b->str[0] = 0;
+    b->hash = NGLI_HASH64_INIT;
     return b;
 }
 
@@ -67,6 +69,7 @@ void ngli_bstr_print(struct bstr *b, const char *str)
         b->bufsize = new_size;
     }
     memcpy(b->str + b->len, str, len + 1);
+    b->hash = ngli_hash64_update(b->hash, (const uint8_t *)str, len);
     b->len += len;
 }
 
@@ -103,6 +106,7 @@ void ngli_bstr_printf(struct bstr *b, const char *fmt, ...)
         }
     }
 
+    b->hash = ngli_hash64_update(b->hash, (const uint8_t *)b->str + b->len, len);
     b->len = b->len + len;
 }
 
@@ -111,6 +115,7 @@ void ngli_bstr_clear(struct bstr *b)
     b->len = 0;
     b->str[0] = 0;
     b->state = 0;
+    b->hash = NGLI_HASH64_INIT;
 }
 
 int ngli_bstr_truncate(struct bstr *b, size_t len)
@@ -119,6 +124,8 @@ int ngli_bstr_truncate(struct bstr *b, size_t len)
         return NGL_ERROR_INVALID_ARG;
     b->len = len;
     b->str[b->len] = 0;
+    /* The hash cannot be rewound, it has to be recomputed from the start */
+    b->hash = ngli_hash64_mem((const uint8_t *)b->str, b->len);
     return 0;
 }
 
@@ -137,6 +144,11 @@ size_t ngli_bstr_len(const struct bstr *b)
     return b->len;
 }
 
+uint64_t ngli_bstr_hash(const struct bstr *b)
+{
+    return b->hash;
+}
+
 int ngli_bstr_check(const struct bstr *b)
 {
     return b->state;
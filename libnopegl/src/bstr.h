@@ -23,6 +23,7 @@
 #define BSTR_H
 
 #include <stdarg.h>
+#include <stdint.h>
 
 #include "utils.h"
 
@@ -36,6 +37,12 @@ int ngli_bstr_truncate(struct bstr *b, size_t len);
 char *ngli_bstr_strdup(const struct bstr *b);
 const char *ngli_bstr_strptr(const struct bstr *b);
 size_t ngli_bstr_len(const struct bstr *b);
+
+/*
+ * 64-bit FNV-1a hash of the content (same as ngli_hash64_mem()), updated
+ * as the string is appended to so that it is available without another pass.
+ */
+uint64_t ngli_bstr_hash(const struct bstr *b);
 int ngli_bstr_check(const struct bstr *b);
 void ngli_bstr_freep(struct bstr **bp);
 
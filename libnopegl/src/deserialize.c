@@ -25,11 +25,14 @@
 #include <string.h>
 
 #include "darray.h"
+#include "hmap.h"
 #include "log.h"
 #include "memory.h"
 #include "nopegl.h"
 #include "internal.h"
 #include "params.h"
+#include "serialize.h"
+#include "utils.h"
 
 static int parse_i32(const char *s, int32_t *valp)
 {
@@ -363,6 +366,20 @@ static int parse_param_data(struct darray *nodes_array, uint8_t *dstp,
     return (int)(cur - str);
 }
 
+static int parse_param_blob(const struct darray *blobs, uint8_t *dstp,
+                            const struct node_param *par, const char *str)
+{
+    size_t blob_id;
+    const int len = parse_hexsize(str, &blob_id);
+    if (len <= 0 || !blobs || blob_id >= ngli_darray_count(blobs))
+        return NGL_ERROR_INVALID_DATA;
+    const struct serialize_blob *blob = ngli_darray_get(blobs, blob_id);
+    int ret = ngli_params_set_data(dstp, par, blob->size, blob->data);
+    if (ret < 0)
+        return ret;
+    return len;
+}
+
 static int parse_param_node(struct darray *nodes_array, uint8_t *dstp,
                             const struct node_param *par, const char *str)
 {
@@ -443,8 +460,8 @@ static int parse_param_nodedict(struct darray *nodes_array, uint8_t *dstp,
     return len;
 }
 
-static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
-                       const struct node_param *par, const char *str)
+static int parse_param(struct darray *nodes_array, const struct darray *blobs,
+                       uint8_t *base_ptr, const struct node_param *par, const char *str)
 {
     int len = -1;
 
@@ -457,6 +474,13 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
         return len + 1;
     }
 
+    if (par->type == NGLI_PARAM_TYPE_DATA && str[0] == '@') {
+        len = parse_param_blob(blobs, dstp, par, str + 1);
+        if (len < 0)
+            return len;
+        return len + 1;
+    }
+
     switch (par->type) {
     case NGLI_PARAM_TYPE_I32:      len = parse_param_i32(nodes_array, dstp, par, str);      break;
     case NGLI_PARAM_TYPE_U32:      len = parse_param_u32(nodes_array, dstp, par, str);      break;
@@ -488,8 +512,8 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
     return len;
 }
 
-static int set_node_params(struct darray *nodes_array, char *str,
-                           const struct ngl_node *node)
+static int set_node_params(struct darray *nodes_array, const struct darray *blobs,
+                           char *str, const struct ngl_node *node)
 {
     uint8_t *base_ptr = node->opts;
     const struct node_param *params = node->cls->params;
@@ -511,7 +535,7 @@ static int set_node_params(struct darray *nodes_array, char *str,
         }
 
         str = eok + 1;
-        int ret = parse_param(nodes_array, base_ptr, par, str);
+        int ret = parse_param(nodes_array, blobs, base_ptr, par, str);
         if (ret < 0) {
             LOG(ERROR, "unable to set node param %s.%s: %s",
                 node->cls->name, par->key, NGLI_RET_STR(ret));
@@ -527,69 +551,55 @@ static int set_node_params(struct darray *nodes_array, char *str,
     return 0;
 }
 
-int ngli_scene_deserialize(struct ngl_scene *scene, const char *str)
+/*
+ * Parse the version line and the metadata lines following it ("# key=value"),
+ * and make *sp point to the first node line.
+ */
+static int parse_header(struct ngl_scene *scene, char **sp)
 {
-    int ret = 0;
-    struct ngl_node *node = NULL;
-    struct darray nodes_array;
-
-    ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
-
-    char *s = ngli_strdup(str);
-    if (!s)
-        return NGL_ERROR_MEMORY;
+    char *s = *sp;
 
-    char *sstart = s;
-    char *send = s + strlen(s);
-
-    /* Parse header */
     int major, minor, micro;
     int n = sscanf(s, "# Nope.GL v%d.%d.%d", &major, &minor, &micro);
     if (n != 3) {
         LOG(ERROR, "invalid serialized scene");
-        ret = NGL_ERROR_INVALID_DATA;
-        goto end;
+        return NGL_ERROR_INVALID_DATA;
     }
     if (NGL_VERSION_INT != NGL_GET_VERSION(major, minor, micro)) {
         LOG(ERROR, "mismatching version: %d.%d.%d != %d.%d.%d",
             major, minor, micro,
             NGL_VERSION_MAJOR, NGL_VERSION_MINOR, NGL_VERSION_MICRO);
-        ret = NGL_ERROR_INVALID_DATA;
-        goto end;
+        return NGL_ERROR_INVALID_DATA;
     }
     s += strcspn(s, "\n");
     if (*s == '\n')
         s++;
 
-    /* Parse metadata: lines following "# key=value" */
     while (*s == '#') {
         char key[64], value[64];
         n = sscanf(s, "# %63[^=]=%63[^\n]", key, value);
         if (n != 2) {
             LOG(ERROR, "unable to parse metadata line \"%s\"", s);
-            ret = NGL_ERROR_INVALID_DATA;
-            goto end;
+            return NGL_ERROR_INVALID_DATA;
         }
 
         if (!strcmp(key, "duration")) {
-            ret = parse_f64(value, &scene->duration);
+            int ret = parse_f64(value, &scene->duration);
             if (ret < 0) {
                 LOG(ERROR, "unable to parse duration \"%s\"", value);
-                goto end;
+                return ret;
             }
         } else if (!strcmp(key, "aspect_ratio")) {
             n = sscanf(value, "%d/%d", &scene->aspect_ratio[0], &scene->aspect_ratio[1]);
             if (n != 2) {
                 LOG(ERROR, "unable to parse aspect ratio \"%s\"", value);
-                ret = NGL_ERROR_INVALID_DATA;
-                goto end;
+                return NGL_ERROR_INVALID_DATA;
             }
         } else if (!strcmp(key, "framerate")) {
             n = sscanf(value, "%d/%d", &scene->framerate[0], &scene->framerate[1]);
             if (n != 2) {
                 LOG(ERROR, "unable to parse framerate\"%s\"", value);
-                ret = NGL_ERROR_INVALID_DATA;
-                goto end;
+                return NGL_ERROR_INVALID_DATA;
             }
         } else {
             LOG(WARNING, "unrecognized metadata key \"%s\"", key);
@@ -600,48 +610,419 @@ int ngli_scene_deserialize(struct ngl_scene *scene, const char *str)
             s++;
     }
 
+    *sp = s;
+    return 0;
+}
+
+/*
+ * Create the node described by a NUL terminated node line and append it to
+ * nodes_array, which holds the reference on it.
+ */
+static int create_node(struct darray *nodes_array, const struct darray *blobs, char *s)
+{
+    const int type = NGLI_FOURCC(s[0], s[1], s[2], s[3]);
+    s += 4;
+    if (*s == ' ')
+        s++;
+
+    struct ngl_node *node = ngl_node_create(type);
+    if (!node) {
+        // Could be a memory error as well but it's more likely the node
+        // type is wrong
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if (!ngli_darray_push(nodes_array, &node)) {
+        ngl_node_unrefp(&node);
+        return NGL_ERROR_MEMORY;
+    }
+
+    return set_node_params(nodes_array, blobs, s, node);
+}
+
+/*
+ * The string is modified in place during the parsing and must be NUL
+ * terminated. Data parameters referencing a blob ("key:@<id>") are only
+ * allowed when blobs is not NULL.
+ */
+static int deserialize(struct ngl_scene *scene, char *s, const struct darray *blobs)
+{
+    struct darray nodes_array;
+    ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
+
+    char *send = s + strlen(s);
+
+    int ret = parse_header(scene, &s);
+    if (ret < 0)
+        goto end;
+
     /* Parse nodes (1 line = 1 node) */
     while (s < send - 4) {
-        const int type = NGLI_FOURCC(s[0], s[1], s[2], s[3]);
-        s += 4;
-        if (*s == ' ')
-            s++;
+        size_t eol = strcspn(s, "\n");
+        s[eol] = 0;
 
-        node = ngl_node_create(type);
-        if (!node) {
-            // Could be a memory error as well but it's more likely the node
-            // type is wrong
-            ret = NGL_ERROR_INVALID_DATA;
+        ret = create_node(&nodes_array, blobs, s);
+        if (ret < 0)
             break;
-        }
 
-        if (!ngli_darray_push(&nodes_array, &node)) {
-            ngl_node_unrefp(&node);
-            ret = NGL_ERROR_MEMORY;
+        s += eol + 1;
+    }
+
+    if (ret >= 0 && ngli_darray_count(&nodes_array)) {
+        struct ngl_node **root = ngli_darray_tail(&nodes_array);
+        ret = ngl_scene_init_from_node(scene, *root);
+    }
+
+    struct ngl_node **nodes = ngli_darray_data(&nodes_array);
+    for (size_t i = 0; i < ngli_darray_count(&nodes_array); i++)
+        ngl_node_unrefp(&nodes[i]);
+
+end:
+    ngli_darray_reset(&nodes_array);
+    return ret;
+}
+
+/*
+ * Release the current value of a parameter which is otherwise extended
+ * (lists, dicts) or kept (node associated with a value) by its setter.
+ */
+static void reset_param(uint8_t *dstp, const struct node_param *par)
+{
+    if (par->flags & NGLI_PARAM_FLAG_ALLOW_NODE) {
+        ngl_node_unrefp((struct ngl_node **)dstp);
+        return;
+    }
+
+    switch (par->type) {
+    case NGLI_PARAM_TYPE_NODELIST: {
+        struct ngl_node ***elemsp = (struct ngl_node ***)dstp;
+        size_t *nb_elemsp = (size_t *)(dstp + sizeof(struct ngl_node **));
+        for (size_t i = 0; i < *nb_elemsp; i++)
+            ngl_node_unrefp(&(*elemsp)[i]);
+        ngli_freep(elemsp);
+        *nb_elemsp = 0;
+        break;
+    }
+    case NGLI_PARAM_TYPE_F64LIST: {
+        double **elemsp = (double **)dstp;
+        size_t *nb_elemsp = (size_t *)(dstp + sizeof(double *));
+        ngli_freep(elemsp);
+        *nb_elemsp = 0;
+        break;
+    }
+    case NGLI_PARAM_TYPE_NODEDICT:
+        ngli_hmap_freep((struct hmap **)dstp);
+        break;
+    }
+}
+
+/*
+ * Parse a parameter value into a scratch storage, only to check it without
+ * changing the node.
+ */
+static int check_param(struct darray *nodes_array, const struct node_param *par, const char *str)
+{
+    union {
+        struct ngl_node *node;
+        double f64;
+        uint8_t data[sizeof(struct ngl_node *) + sizeof(float[4*4])];
+    } scratch = {0};
+
+    struct node_param scratch_params[2] = {*par};
+    scratch_params[0].offset = 0;
+    const int ret = parse_param(nodes_array, NULL, scratch.data, &scratch_params[0], str);
+    ngli_params_free(scratch.data, scratch_params);
+    return ret;
+}
+
+/*
+ * Same as set_node_params() but on a node which may already be initialized:
+ * every value replaces the current one and goes through the same checks and
+ * updates as the public ngl_node_param_set_*() functions. If apply is not set,
+ * the values are only checked and the node is left untouched.
+ */
+static int patch_node_params(struct darray *nodes_array, char *str, struct ngl_node *node, int apply)
+{
+    for (;;) {
+        char *eok = strchr(str, ':');
+        if (!eok)
             break;
+        *eok = 0;
+
+        uint8_t *base_ptr;
+        const struct node_param *par = ngli_node_param_find(node, str, &base_ptr);
+        if (!par) {
+            LOG(ERROR, "unable to find parameter %s.%s",
+                node->cls->name, str);
+            return NGL_ERROR_INVALID_DATA;
         }
 
-        size_t eol = strcspn(s, "\n");
-        s[eol] = 0;
+        uint8_t *dstp = base_ptr + par->offset;
+        int ret = ngli_node_param_is_value_allowed(node, par->key, dstp, par);
+        if (ret < 0)
+            return ret;
 
-        int ret = set_node_params(&nodes_array, s, node);
+        str = eok + 1;
+        if (node->ctx && (par->flags & NGLI_PARAM_FLAG_ALLOW_NODE) && str[0] == '!') {
+            LOG(ERROR, "%s.%s can not be live associated with a node", node->label, par->key);
+            return NGL_ERROR_INVALID_USAGE;
+        }
+
+        if (apply) {
+            reset_param(dstp, par);
+            ret = parse_param(nodes_array, NULL, base_ptr, par, str);
+        } else {
+            ret = check_param(nodes_array, par, str);
+        }
         if (ret < 0) {
-            node = NULL;
+            LOG(ERROR, "unable to set node param %s.%s: %s",
+                node->cls->name, par->key, NGLI_RET_STR(ret));
+            return ret;
+        }
+        str += ret;
+
+        if (apply) {
+            ret = ngli_node_param_update(node, par);
+            if (ret < 0)
+                return ret;
+        }
+
+        if (*str != ' ')
             break;
+        str++;
+    }
+
+    return 0;
+}
+
+struct patch_change {
+    struct ngl_node *node;
+    size_t params_offset; /* offset of the parameters in the patch string */
+    size_t nb_nodes;      /* number of nodes the relative ids are resolved against */
+};
+
+int ngli_scene_apply_patch(struct ngl_scene *scene, const char *patch)
+{
+    if (!scene->root) {
+        LOG(ERROR, "a patch can only be applied on a scene with a root node");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    /*
+     * The patch is parsed in place, so the whole patch is first checked on a
+     * copy of it and the changes are then applied from another one: a
+     * rejected patch leaves the scene untouched.
+     */
+    char *s = ngli_strdup(patch);
+    char *apply_str = ngli_strdup(patch);
+    if (!s || !apply_str) {
+        ngli_free(s);
+        ngli_free(apply_str);
+        return NGL_ERROR_MEMORY;
+    }
+    char *sstart = s;
+    char *send = s + strlen(s);
+
+    /*
+     * The scene nodes are referenced in their serialization order, so that
+     * a patch addresses them exactly like the nodes of the serialized scene.
+     * Only the nodes declared by the patch are owned by the array.
+     */
+    struct darray nodes_array;
+    ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
+    struct darray changes;
+    ngli_darray_init(&changes, sizeof(struct patch_change), 0);
+    struct darray apply_nodes;
+    ngli_darray_init(&apply_nodes, sizeof(struct ngl_node *), 0);
+    int ret = ngli_scene_get_nodes(scene, &nodes_array);
+    const size_t nb_scene_nodes = ngli_darray_count(&nodes_array);
+    if (ret < 0)
+        goto end;
+
+    struct ngl_scene patched_scene = *scene;
+    ret = parse_header(&patched_scene, &s);
+    if (ret < 0)
+        goto end;
+
+    while (s < send) {
+        size_t eol = strcspn(s, "\n");
+        s[eol] = 0;
+
+        if (!eol) {
+            s++;
+            continue;
+        }
+
+        if (s[0] == '=') {
+            size_t node_id;
+            const int len = parse_hexsize(s + 1, &node_id);
+            struct ngl_node **nodep = len > 0 ? get_abs_node(&nodes_array, node_id) : NULL;
+            if (!nodep) {
+                LOG(ERROR, "invalid node reference in patch line \"%s\"", s);
+                ret = NGL_ERROR_INVALID_DATA;
+                break;
+            }
+            char *params = s + 1 + len;
+            if (*params == ' ')
+                params++;
+            const struct patch_change change = {
+                .node          = *nodep,
+                .params_offset = params - sstart,
+                .nb_nodes      = ngli_darray_count(&nodes_array),
+            };
+            if (!ngli_darray_push(&changes, &change)) {
+                ret = NGL_ERROR_MEMORY;
+                break;
+            }
+            ret = patch_node_params(&nodes_array, params, *nodep, 0);
+        } else if (eol < 4) {
+            LOG(ERROR, "invalid patch line \"%s\"", s);
+            ret = NGL_ERROR_INVALID_DATA;
+        } else {
+            /* The new nodes are not part of the scene until they are referenced by a change */
+            ret = create_node(&nodes_array, NULL, s);
         }
+        if (ret < 0)
+            break;
 
         s += eol + 1;
     }
+    if (ret < 0)
+        goto end;
 
-    if (node)
-        ret = ngl_scene_init_from_node(scene, node);
-
+    /*
+     * The relative node ids of a change are resolved against the nodes
+     * declared up to it, which are progressively exposed to the changes.
+     */
     struct ngl_node **nodes = ngli_darray_data(&nodes_array);
-    for (size_t i = 0; i < ngli_darray_count(&nodes_array); i++)
-        ngl_node_unrefp(&nodes[i]);
+    const struct patch_change *patch_changes = ngli_darray_data(&changes);
+    for (size_t i = 0; i < ngli_darray_count(&changes); i++) {
+        const struct patch_change *change = &patch_changes[i];
+        while (ngli_darray_count(&apply_nodes) < change->nb_nodes) {
+            if (!ngli_darray_push(&apply_nodes, &nodes[ngli_darray_count(&apply_nodes)])) {
+                ret = NGL_ERROR_MEMORY;
+                goto end;
+            }
+        }
+        ret = patch_node_params(&apply_nodes, apply_str + change->params_offset, change->node, 1);
+        if (ret < 0)
+            goto end;
+    }
+
+    scene->duration = patched_scene.duration;
+    memcpy(scene->aspect_ratio, patched_scene.aspect_ratio, sizeof(scene->aspect_ratio));
+    memcpy(scene->framerate, patched_scene.framerate, sizeof(scene->framerate));
 
 end:
+    for (size_t i = nb_scene_nodes; i < ngli_darray_count(&nodes_array); i++)
+        ngl_node_unrefp(ngli_darray_get(&nodes_array, i));
     ngli_darray_reset(&nodes_array);
+    ngli_darray_reset(&changes);
+    ngli_darray_reset(&apply_nodes);
+    ngli_free(apply_str);
     ngli_free(sstart);
     return ret;
 }
+
+int ngli_scene_deserialize(struct ngl_scene *scene, const char *str)
+{
+    char *s = ngli_strdup(str);
+    if (!s)
+        return NGL_ERROR_MEMORY;
+    int ret = deserialize(scene, s, NULL);
+    ngli_free(s);
+    return ret;
+}
+
+static int deserialize_text(struct ngl_scene *scene, const char *data, size_t size)
+{
+    if (size == SIZE_MAX)
+        return NGL_ERROR_LIMIT_EXCEEDED;
+    char *s = ngli_malloc(size + 1);
+    if (!s)
+        return NGL_ERROR_MEMORY;
+    if (size)
+        memcpy(s, data, size);
+    s[size] = 0;
+    int ret = deserialize(scene, s, NULL);
+    ngli_free(s);
+    return ret;
+}
+
+static int check_range(uint64_t offset, uint64_t size, size_t total_size)
+{
+    return offset <= total_size && size <= total_size - offset;
+}
+
+static int deserialize_binary(struct ngl_scene *scene, const uint8_t *data, size_t size)
+{
+    struct serialize_header header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.version != SERIALIZE_VERSION) {
+        LOG(ERROR, "unsupported binary scene version %u", header.version);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    if (!check_range(header.nodes_offset, header.nodes_size, size) ||
+        header.nb_blobs > (size - sizeof(header)) / sizeof(struct serialize_blob_entry) ||
+        !check_range(header.blobs_offset, header.nb_blobs * sizeof(struct serialize_blob_entry), size)) {
+        LOG(ERROR, "invalid binary scene layout");
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    struct darray blobs;
+    ngli_darray_init(&blobs, sizeof(struct serialize_blob), 0);
+
+    int ret = 0;
+    char *s = NULL;
+    for (size_t i = 0; i < header.nb_blobs; i++) {
+        struct serialize_blob_entry entry;
+        memcpy(&entry, data + header.blobs_offset + i * sizeof(entry), sizeof(entry));
+        if (!check_range(entry.offset, entry.size, size)) {
+            LOG(ERROR, "blob %zu is out of bounds", i);
+            ret = NGL_ERROR_INVALID_DATA;
+            goto end;
+        }
+        /* The blob payloads are referenced directly from the source memory */
+        const struct serialize_blob blob = {
+            .data = data + entry.offset,
+            .size = (size_t)entry.size,
+        };
+        if (!ngli_darray_push(&blobs, &blob)) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+    }
+
+    const size_t nodes_size = (size_t)header.nodes_size;
+    s = ngli_malloc(nodes_size + 1);
+    if (!s) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+    memcpy(s, data + header.nodes_offset, nodes_size);
+    s[nodes_size] = 0;
+
+    ret = deserialize(scene, s, &blobs);
+
+end:
+    ngli_free(s);
+    ngli_darray_reset(&blobs);
+    return ret;
+}
+
+int ngli_scene_deserialize_mem(struct ngl_scene *scene, const void *data, size_t size)
+{
+    if (size >= sizeof(struct serialize_header)) {
+        uint32_t magic;
+        memcpy(&magic, data, sizeof(magic));
+        if (magic == SERIALIZE_MAGIC)
+            return deserialize_binary(scene, data, size);
+        if (magic == NGLI_FOURCC('B','L','G','N')) { /* byte-swapped magic */
+            LOG(ERROR, "binary scene was serialized with a different byte order");
+            return NGL_ERROR_UNSUPPORTED;
+        }
+    }
+    return deserialize_text(scene, data, size);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "diskcache.h"
+#include "log.h"
+#include "memory.h"
+#include "nopegl.h"
+#include "utils.h"
+
+#define DISKCACHE_MAGIC   NGLI_FOURCC('N','G','L','C')
+#define DISKCACHE_VERSION 1
+
+struct diskcache_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key_size;
+    uint64_t data_size;
+};
+
+static char *get_entry_path(const char *dir, const char *ns, const void *key, size_t key_size)
+{
+    const uint32_t hash = ngli_crc32_mem(key, key_size);
+    return ngli_asprintf("%s/%s-%08x.bin", dir, ns, hash);
+}
+
+int ngli_diskcache_load(const char *dir, const char *ns,
+                        const void *key, size_t key_size,
+                        void **datap, size_t *sizep)
+{
+    char *path = get_entry_path(dir, ns, key, key_size);
+    if (!path)
+        return NGL_ERROR_MEMORY;
+
+    int ret = NGL_ERROR_NOT_FOUND;
+    void *stored_key = NULL;
+    void *data = NULL;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        goto end;
+
+    struct diskcache_header header;
+    if (fread(&header, 1, sizeof(header), fp) != sizeof(header) ||
+        header.magic != DISKCACHE_MAGIC ||
+        header.version != DISKCACHE_VERSION ||
+        header.key_size != key_size ||
+        header.data_size > SIZE_MAX) {
+        LOG(DEBUG, "ignoring invalid cache entry %s", path);
+        goto end;
+    }
+
+    /*
+     * The data size is checked against the file size before any allocation
+     * so that a corrupted header can not request an arbitrary amount of
+     * memory
+     */
+    int64_t file_size;
+    if (ngli_get_filesize(path, &file_size) < 0 ||
+        (uint64_t)file_size < sizeof(header) + key_size ||
+        header.data_size != (uint64_t)file_size - sizeof(header) - key_size) {
+        LOG(DEBUG, "cache entry %s size does not match its header", path);
+        goto end;
+    }
+
+    stored_key = ngli_malloc(key_size);
+    data = ngli_malloc(header.data_size ? (size_t)header.data_size : 1);
+    if (!stored_key || !data) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    if (fread(stored_key, 1, key_size, fp) != key_size ||
+        memcmp(stored_key, key, key_size)) {
+        LOG(DEBUG, "cache entry %s does not match the requested key", path);
+        goto end;
+    }
+
+    if (fread(data, 1, (size_t)header.data_size, fp) != header.data_size) {
+        LOG(DEBUG, "cache entry %s is truncated", path);
+        goto end;
+    }
+
+    *datap = data;
+    *sizep = (size_t)header.data_size;
+    data = NULL;
+    ret = 0;
+
+end:
+    if (fp)
+        fclose(fp);
+    ngli_free(data);
+    ngli_free(stored_key);
+    ngli_free(path);
+    return ret;
+}
+
+int ngli_diskcache_store(const char *dir, const char *ns,
+                         const void *key, size_t key_size,
+                         const void *data, size_t size)
+{
+    char *path = get_entry_path(dir, ns, key, key_size);
+    if (!path)
+        return NGL_ERROR_MEMORY;
+
+    /* Unique per process so that concurrent writers never share a file */
+    char *tmp_path = ngli_asprintf("%s.%d.tmp", path, (int)getpid());
+    if (!tmp_path) {
+        ngli_free(path);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = 0;
+    FILE *fp = fopen(tmp_path, "wb");
+    if (!fp) {
+        LOG(WARNING, "could not create cache entry %s", tmp_path);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    const struct diskcache_header header = {
+        .magic     = DISKCACHE_MAGIC,
+        .version   = DISKCACHE_VERSION,
+        .key_size  = key_size,
+        .data_size = size,
+    };
+    const int write_ok = fwrite(&header, 1, sizeof(header), fp) == sizeof(header) &&
+                         fwrite(key, 1, key_size, fp) == key_size &&
+                         fwrite(data, 1, size, fp) == size;
+    if (fclose(fp) != 0 || !write_ok) {
+        LOG(WARNING, "could not write cache entry %s", tmp_path);
+        remove(tmp_path);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    /*
+     * On Windows, rename() fails if the destination exists: since another
+     * process already stored the same entry, this is not an error.
+     */
+    if (rename(tmp_path, path) != 0)
+        remove(tmp_path);
+
+end:
+    ngli_free(tmp_path);
+    ngli_free(path);
+    return ret;
+}
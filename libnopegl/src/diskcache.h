@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DISKCACHE_H
+#define DISKCACHE_H
+
+#include <stddef.h>
+
+/*
+ * Persistent key/value blob storage in a user provided directory.
+ *
+ * Every entry lives in its own file named after the namespace and a hash of
+ * the key. The full key is stored along with the data so that a hash
+ * collision is detected and treated as a cache miss. Entries are written to a
+ * temporary file first and then renamed, which makes it safe for several
+ * processes to share the same cache directory.
+ */
+
+/*
+ * Load the data associated with key. Return NGL_ERROR_NOT_FOUND on cache
+ * miss. On success, *datap must be freed by the caller with ngli_free().
+ */
+int ngli_diskcache_load(const char *dir, const char *ns,
+                        const void *key, size_t key_size,
+                        void **datap, size_t *sizep);
+
+int ngli_diskcache_store(const char *dir, const char *ns,
+                         const void *key, size_t key_size,
+                         const void *data, size_t size);
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "drawlist.h"
+#include "gpu_ctx.h"
+#include "internal.h"
+#include "log.h"
+#include "math_utils.h"
+#include "utils.h"
+
+enum {
+    OP_DRAW,
+    OP_PUSH_TRANSFORM,
+    OP_PUSH_CAMERA,
+    OP_PUSH_SCISSOR,
+    OP_POP,
+};
+
+struct drawlist_op {
+    int type;
+    struct ngl_node *node;
+    struct rnode *rnode;              // draw: render path of the node
+    const float *matrix;              // push transform/camera: (modelview) matrix
+    const float *projection_matrix;   // push camera
+    const int32_t *scissor;           // push scissor: NULL to keep the current one
+    size_t link;                      // push: index of the pop, pop: index of the push
+};
+
+void ngli_drawlist_init(struct drawlist *s, struct ngl_ctx *ctx)
+{
+    s->ctx = ctx;
+    ngli_darray_init(&s->ops, sizeof(struct drawlist_op), 0);
+    ngli_darray_init(&s->open_ops, sizeof(size_t), 0);
+    ngli_darray_init(&s->scissors, sizeof(struct scissor), 0);
+}
+
+int ngli_drawlist_record(struct drawlist *s, struct ngl_node *root)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    ngli_darray_clear(&s->ops);
+    ngli_darray_clear(&s->open_ops);
+
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    int ret = ngli_node_record(root, s);
+    ctx->rnode_pos = rnode_pos;
+    if (ret < 0)
+        return ret;
+
+    ngli_assert(!ngli_darray_count(&s->open_ops));
+    LOG(DEBUG, "recorded %zu draw operations from %s", ngli_darray_count(&s->ops), root->label);
+    return 0;
+}
+
+static int add_op(struct drawlist *s, const struct drawlist_op *op)
+{
+    if (!ngli_darray_push(&s->ops, op))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static int push_op(struct drawlist *s, const struct drawlist_op *op)
+{
+    const size_t index = ngli_darray_count(&s->ops);
+    if (!ngli_darray_push(&s->open_ops, &index))
+        return NGL_ERROR_MEMORY;
+    return add_op(s, op);
+}
+
+int ngli_drawlist_add_draw(struct drawlist *s, struct ngl_node *node)
+{
+    const struct drawlist_op op = {
+        .type  = OP_DRAW,
+        .node  = node,
+        .rnode = s->ctx->rnode_pos,
+    };
+    return add_op(s, &op);
+}
+
+int ngli_drawlist_push_transform(struct drawlist *s, struct ngl_node *node, const float *matrix)
+{
+    const struct drawlist_op op = {
+        .type   = OP_PUSH_TRANSFORM,
+        .node   = node,
+        .matrix = matrix,
+    };
+    return push_op(s, &op);
+}
+
+int ngli_drawlist_push_camera(struct drawlist *s, struct ngl_node *node,
+                              const float *modelview_matrix, const float *projection_matrix)
+{
+    const struct drawlist_op op = {
+        .type              = OP_PUSH_CAMERA,
+        .node              = node,
+        .matrix            = modelview_matrix,
+        .projection_matrix = projection_matrix,
+    };
+    return push_op(s, &op);
+}
+
+int ngli_drawlist_push_scissor(struct drawlist *s, struct ngl_node *node, const int32_t *scissor)
+{
+    const struct drawlist_op op = {
+        .type    = OP_PUSH_SCISSOR,
+        .node    = node,
+        .scissor = scissor,
+    };
+    return push_op(s, &op);
+}
+
+int ngli_drawlist_pop(struct drawlist *s)
+{
+    const size_t *indexp = ngli_darray_pop(&s->open_ops);
+    ngli_assert(indexp);
+
+    const size_t index = *indexp;
+    struct drawlist_op *push = ngli_darray_get(&s->ops, index);
+    push->link = ngli_darray_count(&s->ops);
+
+    const struct drawlist_op op = {
+        .type = OP_POP,
+        .node = push->node,
+        .link = index,
+    };
+    return add_op(s, &op);
+}
+
+static int push_state(struct drawlist *s, const struct drawlist_op *op)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (op->type == OP_PUSH_TRANSFORM) {
+        float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
+        if (!next_matrix)
+            return NGL_ERROR_MEMORY;
+
+        /* The push may re-allocate the stack, so the previous matrix can only
+         * be accessed afterwards */
+        const float *prev_matrix = next_matrix - 4 * 4;
+        ngli_mat4_mul(next_matrix, prev_matrix, op->matrix);
+    } else if (op->type == OP_PUSH_CAMERA) {
+        if (!ngli_darray_push(&ctx->modelview_matrix_stack, op->matrix))
+            return NGL_ERROR_MEMORY;
+        if (!ngli_darray_push(&ctx->projection_matrix_stack, op->projection_matrix)) {
+            ngli_darray_pop(&ctx->modelview_matrix_stack);
+            return NGL_ERROR_MEMORY;
+        }
+    } else if (op->type == OP_PUSH_SCISSOR && op->scissor) {
+        struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+        const struct scissor prev_scissor = ngli_gpu_ctx_get_scissor(gpu_ctx);
+        if (!ngli_darray_push(&s->scissors, &prev_scissor))
+            return NGL_ERROR_MEMORY;
+        const struct scissor scissor = {NGLI_ARG_VEC4(op->scissor)};
+        ngli_gpu_ctx_set_scissor(gpu_ctx, &scissor);
+    }
+
+    return 0;
+}
+
+static void pop_state(struct drawlist *s, const struct drawlist_op *push)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (push->type == OP_PUSH_TRANSFORM) {
+        ngli_darray_pop(&ctx->modelview_matrix_stack);
+    } else if (push->type == OP_PUSH_CAMERA) {
+        ngli_darray_pop(&ctx->modelview_matrix_stack);
+        ngli_darray_pop(&ctx->projection_matrix_stack);
+    } else if (push->type == OP_PUSH_SCISSOR && push->scissor) {
+        const struct scissor *prev_scissor = ngli_darray_pop(&s->scissors);
+        ngli_gpu_ctx_set_scissor(ctx->gpu_ctx, prev_scissor);
+    }
+}
+
+void ngli_drawlist_replay(struct drawlist *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct rnode *rnode_pos = ctx->rnode_pos;
+
+    const struct drawlist_op *ops = ngli_darray_data(&s->ops);
+    const size_t nb_ops = ngli_darray_count(&s->ops);
+    size_t i = 0;
+    while (i < nb_ops) {
+        const struct drawlist_op *op = &ops[i++];
+        switch (op->type) {
+        case OP_DRAW:
+            ctx->rnode_pos = op->rnode;
+            ngli_node_draw(op->node);
+            break;
+        case OP_PUSH_TRANSFORM:
+        case OP_PUSH_CAMERA:
+        case OP_PUSH_SCISSOR:
+            /* Similarly to the draw callbacks, the branch is skipped if the
+             * state cannot be applied */
+            if (push_state(s, op) < 0) {
+                i = op->link + 1;
+                break;
+            }
+            op->node->draw_count++;
+            break;
+        case OP_POP:
+            pop_state(s, &ops[op->link]);
+            break;
+        default:
+            ngli_assert(0);
+        }
+    }
+
+    ctx->rnode_pos = rnode_pos;
+}
+
+void ngli_drawlist_reset(struct drawlist *s)
+{
+    ngli_darray_reset(&s->ops);
+    ngli_darray_reset(&s->open_ops);
+    ngli_darray_reset(&s->scissors);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "darray.h"
+
+struct ngl_ctx;
+struct ngl_node;
+
+/*
+ * Flat list of draw operations recorded once from the scene graph when it is
+ * set, and replayed at every draw instead of walking the graph. The structure
+ * of a scene cannot change once it is attached to a context, so the list
+ * remains valid for its whole lifetime; only the data referenced by the
+ * operations (matrices, scissors) is read again at each replay.
+ *
+ * Nodes which only apply a state around the draw of their children (such as
+ * transforms or cameras) are flattened into push/pop operations. Every other
+ * node is recorded as a draw operation executing its regular draw callback
+ * with the render path it was recorded with.
+ */
+
+struct drawlist {
+    struct ngl_ctx *ctx;
+    struct darray ops;          // array of struct drawlist_op
+    struct darray open_ops;     // indices of the push operations being recorded
+    struct darray scissors;     // scissors saved by the push operations during the replay
+};
+
+void ngli_drawlist_init(struct drawlist *s, struct ngl_ctx *ctx);
+int ngli_drawlist_record(struct drawlist *s, struct ngl_node *root);
+
+/* Recording primitives, used by the record callback of the nodes */
+int ngli_drawlist_add_draw(struct drawlist *s, struct ngl_node *node);
+int ngli_drawlist_push_transform(struct drawlist *s, struct ngl_node *node, const float *matrix);
+int ngli_drawlist_push_camera(struct drawlist *s, struct ngl_node *node,
+                              const float *modelview_matrix, const float *projection_matrix);
+int ngli_drawlist_push_scissor(struct drawlist *s, struct ngl_node *node, const int32_t *scissor);
+int ngli_drawlist_pop(struct drawlist *s);
+
+void ngli_drawlist_replay(struct drawlist *s);
+void ngli_drawlist_reset(struct drawlist *s);
+
+#endif
@@ -206,6 +206,13 @@ static const struct constant {
     {"tau", TAU_F32},
 };
 
+union func {
+    void *f;
+    float (*f1)(float a);
+    float (*f2)(float a, float b);
+    float (*f3)(float a, float b, float c);
+};
+
 struct token {
     enum token_type type;
     int precedence;
@@ -214,15 +221,42 @@ struct token {
     float value;        // TOKEN_CONSTANT
     const float *ptr;   // TOKEN_VARIABLE (pointer to the changing data)
     const char *name;   // TOKEN_FUNCTION (pointer to functions_map[].name)
-    union {
-        void *f;
-        float (*f1)(float a);
-        float (*f2)(float a, float b);
-        float (*f3)(float a, float b, float c);
-    } func; // TOKEN_UNARY_OPERATOR, TOKEN_BINARY_OPERATOR, TOKEN_FUNCTION
+    union func func;    // TOKEN_UNARY_OPERATOR, TOKEN_BINARY_OPERATOR, TOKEN_FUNCTION
     int nb_args;
 };
 
+/*
+ * The RPN output is compiled into a flat list of instructions operating on
+ * registers. Every register is written at most once: constants are set at
+ * init, variables are loaded at the beginning of each run, and each
+ * instruction writes its own register.
+ */
+enum opcode {
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_NEG,
+    OP_CALL1,
+    OP_CALL2,
+    OP_CALL3,
+};
+
+struct insn {
+    enum opcode opcode;
+    union func func;    // OP_CALL*
+    size_t dst;
+    size_t src[3];
+};
+
+struct var_load {
+    size_t reg;
+    const float *ptr;
+};
+
+/* Number of values evaluated at once by ngli_eval_run_n() */
+#define NB_LANES 8
+
 struct eval {
     struct darray tokens;       // user input, infix notation
     struct darray tmp_stack;    // temporary token stack
@@ -230,6 +264,13 @@ struct eval {
     struct hmap *funcs;         // hash map of functions_map
     struct hmap *consts;        // hash map of constants_map
     const struct hmap *vars;    // hash map of user variables
+
+    struct darray insns;        // compiled instructions
+    struct darray var_loads;    // variables to load before each run
+    struct darray reg_values;   // initial register values, used while compiling
+    float *regs;                // registers for ngli_eval_run()
+    float (*lanes)[NB_LANES];   // registers for ngli_eval_run_n()
+    size_t result_reg;
 };
 
 struct eval *ngli_eval_create(void)
@@ -240,6 +281,9 @@ struct eval *ngli_eval_create(void)
     ngli_darray_init(&s->tokens, sizeof(struct token), 0);
     ngli_darray_init(&s->tmp_stack, sizeof(struct token), 0);
     ngli_darray_init(&s->output, sizeof(struct token), 0);
+    ngli_darray_init(&s->insns, sizeof(struct insn), 0);
+    ngli_darray_init(&s->var_loads, sizeof(struct var_load), 0);
+    ngli_darray_init(&s->reg_values, sizeof(float), 0);
     return s;
 }
 
@@ -618,6 +662,209 @@ static int infix_to_rpn(struct eval *s, const char *expr)
     return prepare_eval_run(s);
 }
 
+static float exec_insn(const struct insn *insn, const float *regs)
+{
+    const size_t *src = insn->src;
+    switch (insn->opcode) {
+    case OP_ADD:   return regs[src[0]] + regs[src[1]];
+    case OP_SUB:   return regs[src[0]] - regs[src[1]];
+    case OP_MUL:   return regs[src[0]] * regs[src[1]];
+    case OP_DIV:   return regs[src[0]] / regs[src[1]];
+    case OP_NEG:   return -regs[src[0]];
+    case OP_CALL1: return insn->func.f1(regs[src[0]]);
+    case OP_CALL2: return insn->func.f2(regs[src[0]], regs[src[1]]);
+    case OP_CALL3: return insn->func.f3(regs[src[0]], regs[src[1]], regs[src[2]]);
+    }
+    ngli_assert(0);
+}
+
+static int new_register(struct eval *s, float value, size_t *regp)
+{
+    *regp = ngli_darray_count(&s->reg_values);
+    if (!ngli_darray_push(&s->reg_values, &value))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static int get_constant_register(struct eval *s, struct darray *constants, float value, size_t *regp)
+{
+    /* Constants are compared bitwise so that NaN and signed zeros are honored */
+    const float *reg_values = ngli_darray_data(&s->reg_values);
+    const size_t *regs = ngli_darray_data(constants);
+    for (size_t i = 0; i < ngli_darray_count(constants); i++) {
+        if (!memcmp(&reg_values[regs[i]], &value, sizeof(value))) {
+            *regp = regs[i];
+            return 0;
+        }
+    }
+
+    int ret = new_register(s, value, regp);
+    if (ret < 0)
+        return ret;
+    PUSH(constants, regp);
+    return 0;
+}
+
+static int get_variable_register(struct eval *s, const float *ptr, size_t *regp)
+{
+    const struct var_load *var_loads = ngli_darray_data(&s->var_loads);
+    for (size_t i = 0; i < ngli_darray_count(&s->var_loads); i++) {
+        if (var_loads[i].ptr == ptr) {
+            *regp = var_loads[i].reg;
+            return 0;
+        }
+    }
+
+    int ret = new_register(s, 0.f, regp);
+    if (ret < 0)
+        return ret;
+    const struct var_load var_load = {.reg=*regp, .ptr=ptr};
+    PUSH(&s->var_loads, &var_load);
+    return 0;
+}
+
+static int is_constant_register(const struct darray *constants, size_t reg)
+{
+    const size_t *regs = ngli_darray_data(constants);
+    for (size_t i = 0; i < ngli_darray_count(constants); i++)
+        if (regs[i] == reg)
+            return 1;
+    return 0;
+}
+
+static enum opcode get_opcode(const struct token *token)
+{
+    if (token->type == TOKEN_UNARY_OPERATOR)
+        return OP_NEG;
+    if (token->type == TOKEN_BINARY_OPERATOR) {
+        switch (token->chr) {
+        case '+': return OP_ADD;
+        case '-': return OP_SUB;
+        case '*': return OP_MUL;
+        case '/': return OP_DIV;
+        }
+    }
+    if (token->type == TOKEN_FUNCTION)
+        return OP_CALL1 + token->nb_args - 1;
+    ngli_assert(0);
+}
+
+/*
+ * Compile an operator or function token into an instruction, unless its
+ * arguments are all constants (the result is then computed right away) or an
+ * identical instruction already exists (its result is then reused).
+ */
+static int compile_operator(struct eval *s, struct darray *constants, const struct token *token,
+                            const size_t *src, size_t *regp)
+{
+    if (token->type == TOKEN_UNARY_OPERATOR && token->chr == '+') {
+        *regp = src[0];
+        return 0;
+    }
+
+    const struct insn insn = {
+        .opcode = get_opcode(token),
+        .func   = token->func,
+        .src    = {src[0], token->nb_args > 1 ? src[1] : 0, token->nb_args > 2 ? src[2] : 0},
+    };
+
+    /* print() must be honored for every evaluation */
+    const int is_pure = token->func.f != f_print;
+
+    if (is_pure) {
+        int all_constants = 1;
+        for (int i = 0; i < token->nb_args; i++)
+            all_constants &= is_constant_register(constants, src[i]);
+        if (all_constants) {
+            const float value = exec_insn(&insn, ngli_darray_data(&s->reg_values));
+            return get_constant_register(s, constants, value, regp);
+        }
+
+        const struct insn *insns = ngli_darray_data(&s->insns);
+        for (size_t i = 0; i < ngli_darray_count(&s->insns); i++) {
+            const struct insn *prev = &insns[i];
+            if (prev->opcode == insn.opcode && prev->func.f == insn.func.f &&
+                !memcmp(prev->src, insn.src, sizeof(insn.src))) {
+                *regp = prev->dst;
+                return 0;
+            }
+        }
+    }
+
+    int ret = new_register(s, 0.f, regp);
+    if (ret < 0)
+        return ret;
+    struct insn *new_insn = ngli_darray_push(&s->insns, &insn);
+    if (!new_insn)
+        return NGL_ERROR_MEMORY;
+    new_insn->dst = *regp;
+    return 0;
+}
+
+static int compile_rpn(struct eval *s, struct darray *stack, struct darray *constants)
+{
+    int ret;
+    const struct token *tokens = ngli_darray_data(&s->output);
+    for (size_t i = 0; i < ngli_darray_count(&s->output); i++) {
+        const struct token *token = &tokens[i];
+
+        size_t reg;
+        if (token->type == TOKEN_CONSTANT) {
+            ret = get_constant_register(s, constants, token->value, &reg);
+        } else if (token->type == TOKEN_VARIABLE) {
+            ret = get_variable_register(s, token->ptr, &reg);
+        } else {
+            /* The stack depth has already been checked by prepare_eval_run() */
+            size_t src[3];
+            for (int j = token->nb_args - 1; j >= 0; j--)
+                src[j] = *(const size_t *)ngli_darray_pop_unsafe(stack);
+            ret = compile_operator(s, constants, token, src, &reg);
+        }
+        if (ret < 0)
+            return ret;
+        PUSH(stack, &reg);
+    }
+
+    const size_t *res = ngli_darray_pop(stack);
+    if (res)
+        s->result_reg = *res;
+    else if ((ret = get_constant_register(s, constants, 0.f, &s->result_reg)) < 0)
+        return ret;
+
+    const size_t nb_regs = ngli_darray_count(&s->reg_values);
+    const float *reg_values = ngli_darray_data(&s->reg_values);
+    s->regs = ngli_calloc(nb_regs, sizeof(*s->regs));
+    s->lanes = ngli_calloc(nb_regs, sizeof(*s->lanes));
+    if (!s->regs || !s->lanes)
+        return NGL_ERROR_MEMORY;
+    for (size_t i = 0; i < nb_regs; i++) {
+        s->regs[i] = reg_values[i];
+        for (size_t j = 0; j < NB_LANES; j++)
+            s->lanes[i][j] = reg_values[i];
+    }
+
+    return 0;
+}
+
+static int compile(struct eval *s)
+{
+    struct darray stack, constants;
+    ngli_darray_init(&stack, sizeof(size_t), 0);
+    ngli_darray_init(&constants, sizeof(size_t), 0);
+
+    int ret = compile_rpn(s, &stack, &constants);
+
+    ngli_darray_reset(&constants);
+    ngli_darray_reset(&stack);
+
+    /* Only the compiled program is needed from now on */
+    ngli_darray_reset(&s->reg_values);
+    ngli_darray_reset(&s->tmp_stack);
+    ngli_darray_reset(&s->output);
+
+    return ret;
+}
+
 int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars)
 {
     if (!expr)
@@ -627,54 +874,74 @@ int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars)
 
     int ret;
     if ((ret = tokenize(s, expr)) < 0 ||
-        (ret = infix_to_rpn(s, expr)) < 0)
+        (ret = infix_to_rpn(s, expr)) < 0 ||
+        (ret = compile(s)) < 0)
         return ret;
 
     return 0;
 }
 
-/*
- * Evaluate the operator by consuming the stack.
- */
-static float eval_operator_pop(struct darray *stack, const struct token *token)
+int ngli_eval_run(struct eval *s, float *dst)
 {
-    const struct token *o1 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 1)
-        return token->func.f1(o1->value);
+    float *regs = s->regs;
 
-    const struct token *o2 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 2)
-        return token->func.f2(o2->value, o1->value);
+    const struct var_load *var_loads = ngli_darray_data(&s->var_loads);
+    for (size_t i = 0; i < ngli_darray_count(&s->var_loads); i++)
+        regs[var_loads[i].reg] = *var_loads[i].ptr;
 
-    const struct token *o3 = ngli_darray_pop_unsafe(stack);
-    if (token->nb_args == 3)
-        return token->func.f3(o3->value, o2->value, o1->value);
+    const struct insn *insns = ngli_darray_data(&s->insns);
+    for (size_t i = 0; i < ngli_darray_count(&s->insns); i++)
+        regs[insns[i].dst] = exec_insn(&insns[i], regs);
 
-    ngli_assert(0);
+    *dst = regs[s->result_reg];
+    return 0;
 }
 
-int ngli_eval_run(struct eval *s, float *dst)
+/*
+ * The arithmetic operators are written as fixed-size loops over all the lanes
+ * so that the compiler can vectorize them; function calls are restricted to
+ * the active lanes since they may have side effects (print).
+ */
+static void exec_insn_lanes(const struct insn *insn, float (*lanes)[NB_LANES], size_t n)
 {
-    struct darray *stack = &s->tmp_stack;
+    float *dst = lanes[insn->dst];
+    const float *a = lanes[insn->src[0]];
+    const float *b = lanes[insn->src[1]];
+    const float *c = lanes[insn->src[2]];
+
+    switch (insn->opcode) {
+    case OP_ADD: for (size_t i = 0; i < NB_LANES; i++) dst[i] = a[i] + b[i]; break;
+    case OP_SUB: for (size_t i = 0; i < NB_LANES; i++) dst[i] = a[i] - b[i]; break;
+    case OP_MUL: for (size_t i = 0; i < NB_LANES; i++) dst[i] = a[i] * b[i]; break;
+    case OP_DIV: for (size_t i = 0; i < NB_LANES; i++) dst[i] = a[i] / b[i]; break;
+    case OP_NEG: for (size_t i = 0; i < NB_LANES; i++) dst[i] = -a[i];       break;
+    case OP_CALL1: for (size_t i = 0; i < n; i++) dst[i] = insn->func.f1(a[i]);             break;
+    case OP_CALL2: for (size_t i = 0; i < n; i++) dst[i] = insn->func.f2(a[i], b[i]);       break;
+    case OP_CALL3: for (size_t i = 0; i < n; i++) dst[i] = insn->func.f3(a[i], b[i], c[i]); break;
+    }
+}
 
-    ngli_darray_clear(stack);
+int ngli_eval_run_n(struct eval *s, float *dst, size_t n)
+{
+    float (*lanes)[NB_LANES] = s->lanes;
 
-    const struct token *tokens = ngli_darray_data(&s->output);
-    for (size_t i = 0; i < ngli_darray_count(&s->output); i++) {
-        const struct token *token = &tokens[i];
-        if (token->type == TOKEN_VARIABLE) {
-            const struct token r = {.type=TOKEN_CONSTANT, .value=*token->ptr};
-            PUSH(stack, &r);
-        } else if (token->type == TOKEN_CONSTANT) {
-            PUSH(stack, token);
-        } else {
-            const struct token r = {.type=TOKEN_CONSTANT, .value=eval_operator_pop(stack, token)};
-            PUSH(stack, &r);
-        }
+    const struct var_load *var_loads = ngli_darray_data(&s->var_loads);
+    const size_t nb_var_loads = ngli_darray_count(&s->var_loads);
+    const struct insn *insns = ngli_darray_data(&s->insns);
+    const size_t nb_insns = ngli_darray_count(&s->insns);
+
+    for (size_t base = 0; base < n; base += NB_LANES) {
+        const size_t nb_lanes = NGLI_MIN(n - base, NB_LANES);
+
+        for (size_t i = 0; i < nb_var_loads; i++)
+            memcpy(lanes[var_loads[i].reg], var_loads[i].ptr + base, nb_lanes * sizeof(float));
+
+        for (size_t i = 0; i < nb_insns; i++)
+            exec_insn_lanes(&insns[i], lanes, nb_lanes);
+
+        memcpy(dst + base, lanes[s->result_reg], nb_lanes * sizeof(float));
     }
 
-    const struct token *res = ngli_darray_pop(stack);
-    *dst = res ? res->value : 0.f;
     return 0;
 }
 
@@ -686,6 +953,11 @@ void ngli_eval_freep(struct eval **sp)
     ngli_darray_reset(&s->tokens);
     ngli_darray_reset(&s->tmp_stack);
     ngli_darray_reset(&s->output);
+    ngli_darray_reset(&s->insns);
+    ngli_darray_reset(&s->var_loads);
+    ngli_darray_reset(&s->reg_values);
+    ngli_freep(&s->regs);
+    ngli_freep(&s->lanes);
     ngli_hmap_freep(&s->funcs);
     ngli_hmap_freep(&s->consts);
     ngli_freep(sp);
@@ -23,6 +23,8 @@
 #ifndef EVAL_H
 #define EVAL_H
 
+#include <stddef.h>
+
 #include "hmap.h"
 
 struct eval;
@@ -30,6 +32,13 @@ struct eval;
 struct eval *ngli_eval_create(void);
 int ngli_eval_init(struct eval *s, const char *expr, const struct hmap *vars);
 int ngli_eval_run(struct eval *s, float *dst);
+
+/*
+ * Evaluate the expression n times: every variable registered at init must
+ * point to an array of at least n values, and the i-th result is computed
+ * from the i-th value of each variable.
+ */
+int ngli_eval_run_n(struct eval *s, float *dst, size_t n);
 void ngli_eval_freep(struct eval **sp);
 
 #endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "config.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 200809L // mmap()
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include "filemap.h"
+#include "log.h"
+#include "nopegl.h"
+#include "utils.h"
+
+#if defined(_WIN32)
+int ngli_filemap_open(struct filemap *s, const char *filename)
+{
+    memset(s, 0, sizeof(*s));
+
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        LOG(ERROR, "could not get size of '%s'", filename);
+        CloseHandle(file);
+        return NGL_ERROR_IO;
+    }
+
+    if ((uint64_t)file_size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return NGL_ERROR_LIMIT_EXCEEDED;
+    }
+
+    s->file_handle = file;
+    s->size = (size_t)file_size.QuadPart;
+    if (!s->size)
+        return 0;
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        LOG(ERROR, "could not create mapping of '%s'", filename);
+        ngli_filemap_close(s);
+        return NGL_ERROR_IO;
+    }
+    s->mapping_handle = mapping;
+
+    s->data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!s->data) {
+        LOG(ERROR, "could not map '%s'", filename);
+        ngli_filemap_close(s);
+        return NGL_ERROR_IO;
+    }
+
+    return 0;
+}
+
+void ngli_filemap_prefetch(const struct filemap *s, size_t offset, size_t size)
+{
+    /* Rely on the system default read-ahead */
+}
+
+void ngli_filemap_close(struct filemap *s)
+{
+    if (s->data)
+        UnmapViewOfFile(s->data);
+    if (s->mapping_handle)
+        CloseHandle(s->mapping_handle);
+    if (s->file_handle)
+        CloseHandle(s->file_handle);
+    memset(s, 0, sizeof(*s));
+}
+#else
+int ngli_filemap_open(struct filemap *s, const char *filename)
+{
+    memset(s, 0, sizeof(*s));
+
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        LOG(ERROR, "could not stat '%s': %s", filename, strerror(errno));
+        close(fd);
+        return NGL_ERROR_IO;
+    }
+
+    if ((uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        return NGL_ERROR_LIMIT_EXCEEDED;
+    }
+
+    s->size = (size_t)st.st_size;
+    if (!s->size) {
+        close(fd);
+        return 0;
+    }
+
+    void *data = mmap(NULL, s->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* the mapping holds its own reference on the file */
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s': %s", filename, strerror(errno));
+        s->size = 0;
+        return NGL_ERROR_IO;
+    }
+    s->data = data;
+
+    return 0;
+}
+
+void ngli_filemap_prefetch(const struct filemap *s, size_t offset, size_t size)
+{
+    if (offset >= s->size)
+        return;
+    size = NGLI_MIN(size, s->size - offset);
+
+    /* The advised range must start on a page boundary */
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t start = offset / page_size * page_size;
+    uint8_t *addr = (uint8_t *)s->data + start;
+    (void)posix_madvise(addr, size + offset - start, POSIX_MADV_WILLNEED);
+}
+
+void ngli_filemap_close(struct filemap *s)
+{
+    if (s->data)
+        munmap((void *)s->data, s->size);
+    memset(s, 0, sizeof(*s));
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include <stddef.h>
+
+/*
+ * Read-only memory mapping of a whole file: pages are loaded on demand by the
+ * system when accessed, and are shared with the page cache.
+ */
+struct filemap {
+    const void *data;
+    size_t size;
+#if defined(_WIN32)
+    void *file_handle;
+    void *mapping_handle;
+#endif
+};
+
+int ngli_filemap_open(struct filemap *s, const char *filename);
+
+/*
+ * Hint the system that the given range is going to be accessed soon so that
+ * it can start reading it ahead asynchronously.
+ */
+void ngli_filemap_prefetch(const struct filemap *s, size_t offset, size_t size);
+
+void ngli_filemap_close(struct filemap *s);
+
+#endif
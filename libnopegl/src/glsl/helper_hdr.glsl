@@ -0,0 +1,209 @@
+/*
+ * Copyright 2022 GoPro Inc.
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * HDR to SDR conversion, injected along with the video texture sampling
+ * code: every symbol is prefixed to prevent any conflict with user shaders.
+ */
+
+const vec3 ngli_hdr_luma_coeff = vec3(0.2627, 0.6780, 0.0593); // luma weights for BT.2020
+const float ngli_hdr_l_hdr = 1000.0;
+const float ngli_hdr_l_sdr = 100.0;
+const float ngli_hdr_p_hdr = 1.0 + 32.0 * pow(ngli_hdr_l_hdr / 10000.0, 1.0 / 2.4);
+const float ngli_hdr_p_sdr = 1.0 + 32.0 * pow(ngli_hdr_l_sdr / 10000.0, 1.0 / 2.4);
+const float ngli_hdr_gcr = ngli_hdr_luma_coeff.r / ngli_hdr_luma_coeff.g;
+const float ngli_hdr_gcb = ngli_hdr_luma_coeff.b / ngli_hdr_luma_coeff.g;
+
+/* BT.2446-1-2021 method A */
+vec3 ngli_hdr_tonemap(vec3 x)
+{
+    vec3 xp = pow(x, vec3(1.0 / 2.4));
+    float y_hdr = dot(ngli_hdr_luma_coeff, xp);
+
+    /* Step 1: convert signal to perceptually linear space */
+    float yp = log(1.0 + (ngli_hdr_p_hdr - 1.0) * y_hdr) / log(ngli_hdr_p_hdr);
+
+    /* Step 2: apply knee function in perceptual domain */
+    float yc = mix(
+        1.077 * yp,
+        mix((-1.1510 * yp + 2.7811) * yp - 0.6302, 0.5 * yp + 0.5, yp > 0.9909),
+        yp > 0.7399);
+
+    /* Step 3: convert back to gamma domain */
+    float y_sdr = (pow(ngli_hdr_p_sdr, yc) - 1.0) / (ngli_hdr_p_sdr - 1.0);
+
+    /* Colour correction */
+    float scale = y_sdr / (1.1 * y_hdr);
+    float cb_tmo = scale * (xp.b - y_hdr);
+    float cr_tmo = scale * (xp.r - y_hdr);
+    float y_tmo = y_sdr - max(0.1 * cr_tmo, 0.0);
+
+    /* Convert from Y'Cb'Cr' to R'G'B' (still in BT.2020) */
+    float cg_tmo = -(ngli_hdr_gcr * cr_tmo + ngli_hdr_gcb * cb_tmo);
+    return y_tmo + vec3(cr_tmo, cg_tmo, cb_tmo);
+}
+
+vec3 ngli_hdr_bt2020_to_bt709(vec3 x)
+{
+    const mat3 bt2020_to_bt709 = mat3(
+         1.660491,   -0.12455047, -0.01815076,
+        -0.58764114,  1.1328999,  -0.1005789,
+        -0.07284986, -0.00834942,  1.11872966);
+    return bt2020_to_bt709 * x;
+}
+
+/* HLG Reference EOTF (linearize: R'G'B' HDR → RGB HDR), normalized, ITU-R BT.2100 */
+vec3 ngli_hdr_hlg_eotf(vec3 x)
+{
+    const float a = 0.17883277;
+    const float b = 0.28466892;
+    const float c = 0.55991073;
+    return mix(x * x / 3.0, (exp((x - c) / a) + b) / 12.0, lessThan(vec3(0.5), x));
+}
+
+/* HLG Reference OOTF (linear scene light → linear display light), ITU-R BT.2100 */
+vec3 ngli_hdr_hlg_ootf(vec3 x)
+{
+    return x * vec3(pow(dot(ngli_hdr_luma_coeff, x), 0.2));
+}
+
+vec3 ngli_hdr_hlg2sdr(vec3 hdr)
+{
+    return ngli_hdr_bt2020_to_bt709(ngli_hdr_tonemap(ngli_hdr_hlg_ootf(ngli_hdr_hlg_eotf(hdr))));
+}
+
+/* ITU-R BT.2100 */
+const float ngli_hdr_pq_m1 = 0.1593017578125;
+const float ngli_hdr_pq_m2 = 78.84375;
+const float ngli_hdr_pq_c1 = 0.8359375;
+const float ngli_hdr_pq_c2 = 18.8515625;
+const float ngli_hdr_pq_c3 = 18.6875;
+
+/* PQ Reference EOTF (linearize: R'G'B' HDR → RGB HDR), ITU-R BT.2100 */
+vec3 ngli_hdr_pq_eotf3(vec3 x)
+{
+    vec3 p = pow(x, vec3(1.0 / ngli_hdr_pq_m2));
+    vec3 num = max(p - ngli_hdr_pq_c1, 0.0);
+    vec3 den = ngli_hdr_pq_c2 - ngli_hdr_pq_c3 * p;
+    vec3 Y = pow(num / den, vec3(1.0 / ngli_hdr_pq_m1));
+    return 10000.0 * Y;
+}
+
+float ngli_hdr_pq_eotf(float x)
+{
+    return ngli_hdr_pq_eotf3(vec3(x)).x;
+}
+
+/* PQ Reference OETF (EOTF¯¹), ITU-R BT.2100 */
+float ngli_hdr_pq_oetf(float x)
+{
+    float Y = x / 10000.0;
+    float Ym = pow(Y, ngli_hdr_pq_m1);
+    return pow((ngli_hdr_pq_c1 + ngli_hdr_pq_c2 * Ym) / (1.0 + ngli_hdr_pq_c3 * Ym), ngli_hdr_pq_m2);
+}
+
+/*
+ * Entire PQ encoding luminance range. Could be refined if mastering display
+ * Lb/Lw are known.
+ */
+const float ngli_hdr_pq_lb = 0.0;       /* minimum black luminance */
+const float ngli_hdr_pq_lw = 10000.0;   /* peak white luminance */
+
+/*
+ * Target HLG luminance range.
+ */
+const float ngli_hdr_pq_lmin = 0.0;
+const float ngli_hdr_pq_lmax = 1000.0;
+
+/* EETF (non-linear PQ signal → non-linear PQ signal), ITU-R BT.2408-5 annex 5 */
+float ngli_hdr_pq_eetf(float x)
+{
+    /* Step 1 */
+    float v_min = ngli_hdr_pq_oetf(ngli_hdr_pq_lb);
+    float v_max = ngli_hdr_pq_oetf(ngli_hdr_pq_lw);
+    float e1 = (x - v_min) / (v_max - v_min);
+
+    float l_min = ngli_hdr_pq_oetf(ngli_hdr_pq_lmin);
+    float l_max = ngli_hdr_pq_oetf(ngli_hdr_pq_lmax);
+    float min_lum = (l_min - v_min) / (v_max - v_min);
+    float max_lum = (l_max - v_min) / (v_max - v_min);
+
+    /* Step 2 */
+    float ks = 1.5 * max_lum - 0.5; /* knee start (roll off beginning) */
+    float b = min_lum;
+
+    /* Step 4: Hermite spline P(t) */
+    float t = (e1 - ks) / (1.0 - ks);
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float p = (2.0 * t3 - 3.0 * t2 + 1.0) * ks
+            + (t3 - 2.0 * t2 + t) * (1.0 - ks)
+            + (-2.0 * t3 + 3.0 * t2) * max_lum;
+
+    /* Step 3: solve for the EETF (e3) with given end points */
+    float e2 = mix(p, e1, step(e1, ks));
+
+    /*
+     * Step 4: the following step is supposed to be defined for 0 ≤E₂≤ 1 but no
+     * alternative outside is given, so assuming we need to clamp
+     */
+    e2 = clamp(e2, 0.0, 1.0);
+    float e3 = e2 + b * pow(1.0 - e2, 4.0);
+
+    /*
+     * Step 5: invert the normalization of the PQ values based on the mastering
+     * display black and white luminances, Lb and Lw, to obtain the target
+     * display PQ values.
+     */
+    float e4 = mix(v_min, v_max, e3);
+    return e4;
+}
+
+vec3 ngli_hdr_pq2sdr(vec3 hdr)
+{
+    /* Linearize the PQ signal and ensure it is in the [0; 10000] range */
+    vec3 rgb_linear = ngli_hdr_pq_eotf3(hdr);
+    rgb_linear = clamp(rgb_linear, 0.0, 10000.0);
+
+    /*
+     * Apply the EETF with the maxRGB method to map the PQ signal with a peak
+     * luminance of 10000 cd/m² to 1000 cd/m² (HLG), ITU-R BT.2408-5 annex 5
+     */
+    float m1 = max(rgb_linear.r, max(rgb_linear.g, rgb_linear.b));
+    float m2 = ngli_hdr_pq_eotf(ngli_hdr_pq_eetf(ngli_hdr_pq_oetf(m1)));
+    rgb_linear *= m2 / m1;
+
+    /* Rescale the PQ signal so [0, 1000] maps to [0, 1] */
+    rgb_linear /= 1000.0;
+
+    return ngli_hdr_bt2020_to_bt709(ngli_hdr_tonemap(rgb_linear));
+}
+
+/* The tonemap values match the NGLI_IMAGE_TONEMAP_* enum */
+vec4 ngli_texvideo_tonemap(vec4 color, int tonemap)
+{
+    if (tonemap == 1)
+        return vec4(ngli_hdr_hlg2sdr(color.rgb), color.a);
+    if (tonemap == 2)
+        return vec4(ngli_hdr_pq2sdr(color.rgb), color.a);
+    return color;
+}
@@ -22,11 +22,18 @@
 
 void main()
 {
+    /*
+     * The atlas coordinates are expressed in pixels so that they remain valid
+     * when the atlas texture grows
+     */
+    vec2 tex_size = vec2(textureSize(tex, 0));
+    vec4 tex_coords = coords / tex_size.xyxy;
+
     /*
      * uv is a normalized [0;1] quad coordinate which we map to the atlas
      * element coordinate boundaries
      */
-    vec2 chr_uv = mix(coords.xy, coords.zw, uv);
+    vec2 chr_uv = mix(tex_coords.xy, tex_coords.zw, uv);
 
     /*
      * The half texel clamping is here to prevent texture bleeding when the
@@ -35,8 +42,8 @@ void main()
      * ambiguity and float inaccuracies. It could become an issue only in the
      * case of a huge atlas.
      */
-    vec2 half_texel = 0.5 / vec2(textureSize(tex, 0)) + 1e-8;
-    vec2 clamp_uv = clamp(chr_uv, coords.xy + half_texel, coords.zw - half_texel);
+    vec2 half_texel = 0.5 / tex_size + 1e-8;
+    vec2 clamp_uv = clamp(chr_uv, tex_coords.xy + half_texel, tex_coords.zw - half_texel);
 
     float v = ngl_tex2d(tex, clamp_uv).r;
     ngl_out_color = vec4(color, 1.0) * opacity * v;
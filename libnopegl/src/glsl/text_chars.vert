@@ -30,7 +30,7 @@ void main()
     uv = vec2(ref_uv.x, 1.0 - ref_uv.y);
 
     /*
-     * These are the normalized top-left and bottom-right coordinates of the
+     * These are the top-left and bottom-right pixel coordinates of the
      * character in the atlas.
      */
     coords = atlas_coords;
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+void main()
+{
+    /* See text_chars.frag for the atlas coordinates handling */
+    vec2 tex_size = vec2(textureSize(tex, 0));
+    vec4 tex_coords = coords / tex_size.xyxy;
+    vec2 chr_uv = mix(tex_coords.xy, tex_coords.zw, uv);
+    vec2 half_texel = 0.5 / tex_size + 1e-8;
+    vec2 clamp_uv = clamp(chr_uv, tex_coords.xy + half_texel, tex_coords.zw - half_texel);
+
+    /*
+     * The atlas stores the signed distance to the glyph outline, with the
+     * edge at 128/255 and positive values inside. The screen space derivative
+     * of the distance tells how much of it a pixel covers, which gives an
+     * antialiased edge of about one pixel whatever the scale of the text.
+     */
+    float dist = ngl_tex2d(tex, clamp_uv).r - 128.0 / 255.0;
+    float v = clamp(dist / max(fwidth(dist), 1e-6) + 0.5, 0.0, 1.0);
+    ngl_out_color = vec4(color, 1.0) * opacity * v;
+}
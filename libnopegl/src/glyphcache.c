@@ -0,0 +1,386 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "darray.h"
+#include "format.h"
+#include "glyphcache.h"
+#include "gpu_ctx.h"
+#include "hmap.h"
+#include "internal.h"
+#include "log.h"
+#include "memory.h"
+#include "nopegl.h"
+#include "text.h"
+#include "texture.h"
+#include "utils.h"
+
+#define INITIAL_ATLAS_SIZE 512
+#define MAX_ATLAS_SIZE     4096
+
+struct shelf {
+    int32_t y, height;
+    int32_t x;             // next free column
+    struct darray entries; // struct glyphcache_entry *
+    uint64_t last_use;
+};
+
+struct glyphcache {
+    struct ngl_ctx *ctx;
+    int32_t width, height;
+    int32_t max_size;
+    int mag_filter;
+    uint8_t *data; // CPU copy of the atlas, used to fill the texture when it grows
+    struct texture *texture;
+    struct darray released_textures; // struct texture *, replaced atlas textures the GPU may still access
+    struct darray shelves; // struct shelf
+    int32_t shelves_end;   // first row not allocated to any shelf
+    struct hmap *entries;  // struct glyphcache_entry
+    uint64_t clock;
+};
+
+static void free_entry(void *user_arg, void *data)
+{
+    struct glyphcache_entry *entry = data;
+    ngli_freep(&entry->key);
+    ngli_freep(&entry);
+}
+
+struct glyphcache *ngli_glyphcache_create(struct ngl_ctx *ctx)
+{
+    struct glyphcache *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    ngli_darray_init(&s->released_textures, sizeof(struct texture *), 0);
+    ngli_darray_init(&s->shelves, sizeof(struct shelf), 0);
+    return s;
+}
+
+static int create_texture(struct glyphcache *s, int32_t width, int32_t height, struct texture **texturep)
+{
+    const struct texture_params tex_params = {
+        .type       = NGLI_TEXTURE_TYPE_2D,
+        .width      = width,
+        .height     = height,
+        .format     = NGLI_FORMAT_R8_UNORM,
+        .min_filter = NGLI_FILTER_LINEAR,
+        .mag_filter = s->mag_filter,
+        .usage      = NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT
+                    | NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT
+                    | NGLI_TEXTURE_USAGE_SAMPLED_BIT,
+    };
+
+    struct texture *texture = ngli_texture_create(s->ctx->gpu_ctx);
+    if (!texture)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_texture_init(texture, &tex_params);
+    if (ret < 0) {
+        ngli_texture_freep(&texture);
+        return ret;
+    }
+
+    *texturep = texture;
+    return 0;
+}
+
+int ngli_glyphcache_init(struct glyphcache *s, int mag_filter)
+{
+    s->mag_filter = mag_filter;
+
+    const struct gpu_limits *limits = &s->ctx->gpu_ctx->limits;
+    s->max_size = NGLI_MIN(MAX_ATLAS_SIZE, (int32_t)limits->max_texture_dimension_2d);
+    s->width  = NGLI_MIN(INITIAL_ATLAS_SIZE, s->max_size);
+    s->height = s->width;
+
+    s->entries = ngli_hmap_create();
+    if (!s->entries)
+        return NGL_ERROR_MEMORY;
+    ngli_hmap_set_free(s->entries, free_entry, NULL);
+
+    s->data = ngli_calloc(s->height, s->width);
+    if (!s->data)
+        return NGL_ERROR_MEMORY;
+
+    return create_texture(s, s->width, s->height, &s->texture);
+}
+
+static void touch_entry(struct glyphcache *s, struct glyphcache_entry *entry)
+{
+    entry->last_use = ++s->clock;
+    entry->refcount++;
+    if (entry->shelf_id != SIZE_MAX) {
+        struct shelf *shelf = ngli_darray_get(&s->shelves, entry->shelf_id);
+        shelf->last_use = entry->last_use;
+    }
+}
+
+struct glyphcache_entry *ngli_glyphcache_get(struct glyphcache *s, const char *key)
+{
+    struct glyphcache_entry *entry = ngli_hmap_get(s->entries, key);
+    if (entry)
+        touch_entry(s, entry);
+    return entry;
+}
+
+/*
+ * Pick the shelf with the smallest height able to hold the glyph, unless a
+ * new shelf closer to the glyph height can still be opened
+ */
+static size_t find_shelf(struct glyphcache *s, int32_t w, int32_t h)
+{
+    size_t best_id = SIZE_MAX;
+    const struct shelf *shelves = ngli_darray_data(&s->shelves);
+    for (size_t i = 0; i < ngli_darray_count(&s->shelves); i++) {
+        const struct shelf *shelf = &shelves[i];
+        if (shelf->height < h || shelf->x + w > s->width)
+            continue;
+        if (best_id == SIZE_MAX || shelf->height < shelves[best_id].height)
+            best_id = i;
+    }
+
+    const int can_open_shelf = s->shelves_end + h <= s->height;
+    if (best_id != SIZE_MAX && (!can_open_shelf || shelves[best_id].height <= h + h / 2))
+        return best_id;
+
+    if (!can_open_shelf)
+        return SIZE_MAX;
+
+    struct shelf shelf = {.y = s->shelves_end, .height = h};
+    ngli_darray_init(&shelf.entries, sizeof(struct glyphcache_entry *), 0);
+    if (!ngli_darray_push(&s->shelves, &shelf))
+        return SIZE_MAX;
+    s->shelves_end += h;
+    return ngli_darray_count(&s->shelves) - 1;
+}
+
+static int grow(struct glyphcache *s)
+{
+    int32_t width = s->width;
+    int32_t height = s->height;
+    if (height <= width && height < s->max_size)
+        height = NGLI_MIN(height * 2, s->max_size);
+    else if (width < s->max_size)
+        width = NGLI_MIN(width * 2, s->max_size);
+    else
+        return NGL_ERROR_LIMIT_EXCEEDED;
+
+    uint8_t *data = ngli_calloc(height, width);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+    for (int32_t y = 0; y < s->height; y++)
+        memcpy(data + y * width, s->data + y * s->width, s->width);
+
+    struct texture *texture = NULL;
+    int ret = create_texture(s, width, height, &texture);
+    if (ret < 0)
+        goto fail;
+
+    ret = ngli_texture_upload(texture, data, width);
+    if (ret < 0)
+        goto fail;
+
+    /*
+     * The previous atlas may still be referenced by commands recorded during
+     * the current frame (draws of the other texts, pending glyph uploads), so
+     * it can only be destroyed once the frame has been executed.
+     */
+    if (!ngli_darray_push(&s->released_textures, &s->texture)) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
+    LOG(DEBUG, "grow glyph atlas from %dx%d to %dx%d", s->width, s->height, width, height);
+
+    ngli_freep(&s->data);
+    s->texture = texture;
+    s->data = data;
+    s->width = width;
+    s->height = height;
+    return 0;
+
+fail:
+    ngli_texture_freep(&texture);
+    ngli_freep(&data);
+    return ret;
+}
+
+static int shelf_is_evictable(const struct shelf *shelf, int32_t h)
+{
+    if (shelf->height < h || !ngli_darray_count(&shelf->entries))
+        return 0;
+    struct glyphcache_entry **entries = ngli_darray_data(&shelf->entries);
+    for (size_t i = 0; i < ngli_darray_count(&shelf->entries); i++)
+        if (entries[i]->refcount)
+            return 0;
+    return 1;
+}
+
+/* Evict the least recently used shelf for which no glyph is in use */
+static int evict_shelf(struct glyphcache *s, int32_t h)
+{
+    size_t lru_id = SIZE_MAX;
+    struct shelf *shelves = ngli_darray_data(&s->shelves);
+    for (size_t i = 0; i < ngli_darray_count(&s->shelves); i++) {
+        if (!shelf_is_evictable(&shelves[i], h))
+            continue;
+        if (lru_id == SIZE_MAX || shelves[i].last_use < shelves[lru_id].last_use)
+            lru_id = i;
+    }
+    if (lru_id == SIZE_MAX)
+        return NGL_ERROR_LIMIT_EXCEEDED;
+
+    struct shelf *shelf = &shelves[lru_id];
+    struct glyphcache_entry **entries = ngli_darray_data(&shelf->entries);
+    for (size_t i = 0; i < ngli_darray_count(&shelf->entries); i++) {
+        int ret = ngli_hmap_set(s->entries, entries[i]->key, NULL);
+        if (ret < 0)
+            return ret;
+    }
+    LOG(DEBUG, "evict %zu glyphs from the glyph atlas", ngli_darray_count(&shelf->entries));
+    ngli_darray_clear(&shelf->entries);
+    shelf->x = 0;
+    return 0;
+}
+
+int ngli_glyphcache_add(struct glyphcache *s, const char *key, const struct bitmap *bitmap,
+                        int32_t bearing_x, int32_t bearing_y, struct glyphcache_entry **entryp)
+{
+    const int32_t w = bitmap->width;
+    const int32_t h = bitmap->height;
+    if (w > s->max_size || h > s->max_size) {
+        LOG(ERROR, "glyph size %dx%d exceeds the atlas limits", w, h);
+        return NGL_ERROR_LIMIT_EXCEEDED;
+    }
+
+    struct glyphcache_entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+    entry->width     = NGLI_I32_TO_I26D6(w);
+    entry->height    = NGLI_I32_TO_I26D6(h);
+    entry->bearing_x = bearing_x;
+    entry->bearing_y = bearing_y;
+    entry->shelf_id  = SIZE_MAX;
+    entry->key       = ngli_strdup(key);
+    if (!entry->key) {
+        free_entry(NULL, entry);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret;
+
+    /* Blank glyphs (such as spaces) do not need any room in the atlas */
+    if (w && h) {
+        size_t shelf_id;
+        while ((shelf_id = find_shelf(s, w, h)) == SIZE_MAX) {
+            ret = grow(s);
+            if (ret == NGL_ERROR_LIMIT_EXCEEDED)
+                ret = evict_shelf(s, h);
+            if (ret == NGL_ERROR_LIMIT_EXCEEDED)
+                LOG(ERROR, "glyph atlas is full");
+            if (ret < 0) {
+                free_entry(NULL, entry);
+                return ret;
+            }
+        }
+
+        struct shelf *shelf = ngli_darray_get(&s->shelves, shelf_id);
+        if (!ngli_darray_push(&shelf->entries, &entry)) {
+            free_entry(NULL, entry);
+            return NGL_ERROR_MEMORY;
+        }
+
+        const int32_t x = shelf->x;
+        const int32_t y = shelf->y;
+        shelf->x += w;
+
+        const int32_t coords[] = {x, y, x + w, y + h};
+        memcpy(entry->coords, coords, sizeof(coords));
+        entry->shelf_id = shelf_id;
+
+        for (int32_t line = 0; line < h; line++)
+            memcpy(s->data + (y + line) * s->width + x, bitmap->buffer + line * bitmap->stride, w);
+    }
+
+    ret = ngli_hmap_set(s->entries, key, entry);
+    if (ret < 0) {
+        if (entry->shelf_id != SIZE_MAX) {
+            struct shelf *shelf = ngli_darray_get(&s->shelves, entry->shelf_id);
+            ngli_darray_pop(&shelf->entries);
+        }
+        free_entry(NULL, entry);
+        return ret;
+    }
+
+    touch_entry(s, entry);
+    *entryp = entry;
+
+    const int32_t *c = entry->coords;
+    return ngli_texture_upload_region(s->texture, s->data + c[1] * s->width + c[0], s->width, c[0], c[1], w, h);
+}
+
+void ngli_glyphcache_release(struct glyphcache *s, struct glyphcache_entry *entry)
+{
+    ngli_assert(entry->refcount > 0);
+    entry->refcount--;
+}
+
+struct texture *ngli_glyphcache_get_texture(const struct glyphcache *s)
+{
+    return s->texture;
+}
+
+static void free_released_textures(struct glyphcache *s)
+{
+    struct texture **textures = ngli_darray_data(&s->released_textures);
+    for (size_t i = 0; i < ngli_darray_count(&s->released_textures); i++)
+        ngli_texture_freep(&textures[i]);
+    ngli_darray_clear(&s->released_textures);
+}
+
+void ngli_glyphcache_collect(struct glyphcache *s)
+{
+    if (!s || !ngli_darray_count(&s->released_textures))
+        return;
+
+    /* Atlas growths are rare enough for a full GPU synchronization */
+    ngli_gpu_ctx_wait_idle(s->ctx->gpu_ctx);
+    free_released_textures(s);
+}
+
+void ngli_glyphcache_freep(struct glyphcache **sp)
+{
+    struct glyphcache *s = *sp;
+    if (!s)
+        return;
+    struct shelf *shelves = ngli_darray_data(&s->shelves);
+    for (size_t i = 0; i < ngli_darray_count(&s->shelves); i++)
+        ngli_darray_reset(&shelves[i].entries);
+    ngli_darray_reset(&s->shelves);
+    ngli_hmap_freep(&s->entries);
+    free_released_textures(s);
+    ngli_darray_reset(&s->released_textures);
+    ngli_texture_freep(&s->texture);
+    ngli_freep(&s->data);
+    ngli_freep(sp);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GLYPHCACHE_H
+#define GLYPHCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atlas.h"
+
+struct ngl_ctx;
+struct glyphcache;
+
+/*
+ * Context wide cache of rasterized glyphs, shared by all the Text nodes.
+ *
+ * The glyphs are packed into shelves of a single texture atlas which only
+ * receives the newly rasterized bitmaps. The atlas grows (by doubling one of
+ * its dimensions) until it reaches its maximum size, at which point the least
+ * recently used shelf not referenced by any glyph in use is evicted to make
+ * room for the new glyph. Since the glyphs never move within the atlas, their
+ * coordinates are expressed in pixels and remain valid when the atlas grows;
+ * only the atlas texture changes.
+ */
+
+struct glyphcache_entry {
+    int32_t coords[4];            // x0, y0, x1, y1 pixel coordinates in the atlas texture
+    int32_t width, height;        // in 26.6
+    int32_t bearing_x, bearing_y; // in 26.6
+
+    /* private */
+    char *key;
+    size_t shelf_id;
+    uint64_t last_use;
+    int32_t refcount;
+};
+
+struct glyphcache *ngli_glyphcache_create(struct ngl_ctx *ctx);
+
+/* The filter (NGLI_FILTER_*) is applied when the glyphs are magnified */
+int ngli_glyphcache_init(struct glyphcache *s, int mag_filter);
+
+/*
+ * Lookup a glyph in the cache. On success, the returned entry holds a
+ * reference which must be dropped with ngli_glyphcache_release(). Referenced
+ * entries are never evicted.
+ */
+struct glyphcache_entry *ngli_glyphcache_get(struct glyphcache *s, const char *key);
+
+/*
+ * Insert a new glyph in the cache and upload its bitmap into the atlas. The
+ * bearing values are expressed in 26.6. Like ngli_glyphcache_get(), the
+ * returned entry holds a reference.
+ */
+int ngli_glyphcache_add(struct glyphcache *s, const char *key, const struct bitmap *bitmap,
+                        int32_t bearing_x, int32_t bearing_y, struct glyphcache_entry **entryp);
+
+void ngli_glyphcache_release(struct glyphcache *s, struct glyphcache_entry *entry);
+
+struct texture *ngli_glyphcache_get_texture(const struct glyphcache *s);
+
+/*
+ * Destroy the atlas textures replaced when the atlas grew. Must be called
+ * between frames: it waits for the GPU to complete the previous ones, which
+ * may still access these textures.
+ */
+void ngli_glyphcache_collect(struct glyphcache *s);
+
+void ngli_glyphcache_freep(struct glyphcache **sp);
+
+#endif
@@ -20,6 +20,7 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <string.h>
 
 #include "gpu_ctx.h"
@@ -91,8 +92,17 @@ struct gpu_ctx *ngli_gpu_ctx_create(const struct ngl_config *config)
     return s;
 }
 
+#define DEFAULT_NB_CAPTURE_SLOTS 2
+
 int ngli_gpu_ctx_init(struct gpu_ctx *s)
 {
+    const struct ngl_config *config = &s->config;
+    if (config->nb_capture_slots < 0) {
+        LOG(ERROR, "invalid number of capture slots: %d", config->nb_capture_slots);
+        return NGL_ERROR_INVALID_ARG;
+    }
+    s->nb_capture_slots = config->nb_capture_slots ? (size_t)config->nb_capture_slots : DEFAULT_NB_CAPTURE_SLOTS;
+
     int ret = s->cls->init(s);
     if (ret < 0)
         return ret;
@@ -137,6 +147,29 @@ int ngli_gpu_ctx_end_draw(struct gpu_ctx *s, double t)
     return s->cls->end_draw(s, t);
 }
 
+int ngli_gpu_ctx_end_draw_async(struct gpu_ctx *s, double t, uint64_t *ticketp)
+{
+    const uint64_t ticket = s->next_capture_ticket;
+    const size_t slot = (size_t)(ticket % s->nb_capture_slots);
+    int ret = s->cls->end_draw_async(s, t, slot);
+    if (ret < 0)
+        return ret;
+    s->next_capture_ticket++;
+    *ticketp = ticket;
+    return 0;
+}
+
+int ngli_gpu_ctx_capture_acquire(struct gpu_ctx *s, uint64_t ticket, const uint8_t **datap)
+{
+    if (ticket >= s->next_capture_ticket ||
+        s->next_capture_ticket - ticket > s->nb_capture_slots) {
+        LOG(ERROR, "capture ticket %" PRIu64 " is not available", ticket);
+        return NGL_ERROR_INVALID_ARG;
+    }
+    const size_t slot = (size_t)(ticket % s->nb_capture_slots);
+    return s->cls->capture_acquire(s, slot, datap);
+}
+
 int ngli_gpu_ctx_query_draw_time(struct gpu_ctx *s, int64_t *time)
 {
     return s->cls->query_draw_time(s, time);
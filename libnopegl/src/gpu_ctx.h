@@ -62,6 +62,8 @@ struct gpu_ctx_class {
     int (*end_update)(struct gpu_ctx *s, double t);
     int (*begin_draw)(struct gpu_ctx *s, double t);
     int (*end_draw)(struct gpu_ctx *s, double t);
+    int (*end_draw_async)(struct gpu_ctx *s, double t, size_t slot);
+    int (*capture_acquire)(struct gpu_ctx *s, size_t slot, const uint8_t **datap);
     int (*query_draw_time)(struct gpu_ctx *s, int64_t *time);
     void (*wait_idle)(struct gpu_ctx *s);
     void (*destroy)(struct gpu_ctx *s);
@@ -111,6 +113,8 @@ struct gpu_ctx_class {
     struct texture *(*texture_create)(struct gpu_ctx *ctx);
     int (*texture_init)(struct texture *s, const struct texture_params *params);
     int (*texture_upload)(struct texture *s, const uint8_t *data, int linesize);
+    int (*texture_upload_region)(struct texture *s, const uint8_t *data, int linesize,
+                                 int32_t x, int32_t y, int32_t width, int32_t height);
     int (*texture_generate_mipmap)(struct texture *s);
     void (*texture_freep)(struct texture **sp);
 };
@@ -128,6 +132,10 @@ struct gpu_ctx {
     int gpu_capture;
 #endif
 
+    /* Asynchronous capture */
+    size_t nb_capture_slots;
+    uint64_t next_capture_ticket;
+
     /* State */
     struct rendertarget *rendertarget;
     struct pipeline *pipeline;
@@ -147,6 +155,8 @@ int ngli_gpu_ctx_end_update(struct gpu_ctx *s, double t);
 int ngli_gpu_ctx_begin_draw(struct gpu_ctx *s, double t);
 int ngli_gpu_ctx_query_draw_time(struct gpu_ctx *s, int64_t *time);
 int ngli_gpu_ctx_end_draw(struct gpu_ctx *s, double t);
+int ngli_gpu_ctx_end_draw_async(struct gpu_ctx *s, double t, uint64_t *ticketp);
+int ngli_gpu_ctx_capture_acquire(struct gpu_ctx *s, uint64_t ticket, const uint8_t **datap);
 void ngli_gpu_ctx_wait_idle(struct gpu_ctx *s);
 void ngli_gpu_ctx_freep(struct gpu_ctx **sp);
 
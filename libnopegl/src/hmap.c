@@ -28,20 +28,37 @@
 #include "nopegl.h"
 #include "utils.h"
 
-struct bucket {
-    struct hmap_entry *entries;
-    int nb_entries;
+/*
+ * The entries are stored contiguously in insertion order, which gives the
+ * iteration order. Removed entries are left in place with a NULL key until
+ * the next rehash compacts the array.
+ *
+ * The lookups go through a separate open-addressing table (linear probing)
+ * of slots referencing the entries by index. Each slot also holds the upper
+ * bits of the key hash so that most mismatches are rejected without
+ * touching the entry and its key.
+ */
+
+#define SLOT_EMPTY   UINT32_MAX
+#define SLOT_DELETED (UINT32_MAX - 1)
+#define MAX_ENTRIES  (UINT32_MAX - 2)
+
+struct slot {
+    uint32_t tag;
+    uint32_t id;
 };
 
 struct hmap {
-    struct bucket *buckets;
-    size_t size;
+    struct hmap_entry *entries;
+    size_t nb_entries;      // number of entries in the array, including removed ones
+    size_t entries_cap;
+    struct slot *slots;
+    size_t size;            // number of slots, always a power of 2
     size_t mask;
-    size_t count; // total number of entries
+    size_t nb_used_slots;   // number of non-empty slots, including deleted ones
+    size_t count;           // number of live entries
     user_free_func_type user_free_func;
     void *user_arg;
-    struct hmap_ref first;
-    struct hmap_ref last;
 };
 
 void ngli_hmap_set_free(struct hmap *hm, user_free_func_type user_free_func, void *user_arg)
@@ -50,8 +67,16 @@ void ngli_hmap_set_free(struct hmap *hm, user_free_func_type user_free_func, voi
     hm->user_arg = user_arg;
 }
 
-#define NO_REF (struct hmap_ref){.bucket_id = -1}
-#define HAS_REF(ref) ((ref).bucket_id != -1)
+static uint32_t get_tag(uint64_t hash)
+{
+    return (uint32_t)(hash >> 32);
+}
+
+static void clear_slots(struct slot *slots, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        slots[i] = (struct slot){.id = SLOT_EMPTY};
+}
 
 struct hmap *ngli_hmap_create(void)
 {
@@ -60,12 +85,12 @@ struct hmap *ngli_hmap_create(void)
         return NULL;
     hm->size = 1 << HMAP_SIZE_NBIT;
     hm->mask = hm->size - 1;
-    hm->buckets = ngli_calloc(hm->size, sizeof(*hm->buckets));
-    if (!hm->buckets) {
+    hm->slots = ngli_calloc(hm->size, sizeof(*hm->slots));
+    if (!hm->slots) {
         ngli_free(hm);
         return NULL;
     }
-    hm->first = hm->last = NO_REF;
+    clear_slots(hm->slots, hm->size);
     return hm;
 }
 
@@ -74,246 +99,200 @@ size_t ngli_hmap_count(const struct hmap *hm)
     return hm->count;
 }
 
-static struct hmap_entry *entry_from_ref(const struct hmap *hm, struct hmap_ref ref)
+/* 64-bit FNV-1a followed by the MurmurHash3 finalizer to spread the low bits */
+uint64_t ngli_hmap_hash_key(const char *key)
 {
-    return HAS_REF(ref) ? &hm->buckets[ref.bucket_id].entries[ref.entry_id] : NULL;
+    uint64_t hash = 0xcbf29ce484222325;
+    for (; *key; key++) {
+        hash ^= (uint8_t)*key;
+        hash *= 0x100000001b3;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53;
+    hash ^= hash >> 33;
+    return hash;
 }
 
-static struct hmap_ref ref_from_entry(const struct hmap *hm, const struct hmap_entry *entry)
+static size_t find_slot(const struct hmap *hm, const char *key, uint64_t hash)
 {
-    if (!entry)
-        return NO_REF;
-    struct hmap_ref ref = {
-        .bucket_id = entry->bucket_id,
-        .entry_id  = (int)(entry - hm->buckets[entry->bucket_id].entries),
-    };
-    return ref;
+    const uint32_t tag = get_tag(hash);
+    for (size_t i = hash & hm->mask;; i = (i + 1) & hm->mask) {
+        const struct slot *slot = &hm->slots[i];
+        if (slot->id == SLOT_EMPTY)
+            return SIZE_MAX;
+        if (slot->id != SLOT_DELETED && slot->tag == tag && !strcmp(hm->entries[slot->id].key, key))
+            return i;
+    }
 }
 
-static struct hmap_entry *fixed_entry_from_ref(const struct hmap *hm, struct hmap_ref ref,
-                                               struct hmap_ref removed, int current_id)
+static void insert_slot(struct slot *slots, size_t mask, uint64_t hash, uint32_t id, size_t *nb_used_slots)
 {
-    if (!HAS_REF(ref))
-        return NULL;
-    const int need_fix =
-        /* Only the current bucket has entry references shifted */
-        ref.bucket_id == removed.bucket_id &&
-        /* Only the entries after the removed one are shifted */
-        ref.entry_id > removed.entry_id
-        /*
-         * The following last condition prevents from fixing the reference
-         * twice (and thus decrementing too much): if the passed reference
-         * `ref` (be it a next or prev, it doesn't matter) is located earlier
-         * in the current bucket, it means the complementary reference (prev if
-         * next, next if prev) in that particular entry was for sure already
-         * fixed. Indeed, since the current entry points to it, it means that
-         * the referred entry was also pointing to the current entry with its
-         * complementary reference.
-         */
-        && current_id < ref.entry_id - 1;
-    const int entry_id = ref.entry_id - need_fix;
-    return &hm->buckets[ref.bucket_id].entries[entry_id];
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        struct slot *slot = &slots[i];
+        if (slot->id == SLOT_EMPTY || slot->id == SLOT_DELETED) {
+            if (slot->id == SLOT_EMPTY)
+                (*nb_used_slots)++;
+            *slot = (struct slot){.tag = get_tag(hash), .id = id};
+            return;
+        }
+    }
 }
 
 /*
- * Every entry starting at removed.entry_id is offset by 1 (since the buffer
- * was memory moved after the target entry got removed). We need to fix the
- * references to all these entries, which can be simply done with a -1 on
- * entry indexes (or global pointers indexes) referencing them.
- *
- * Note that we can not use entry_from_ref() directly, because the
- * e->{prev,next} could be referencing an entry in the same bucket, and so we
- * need to offset them in this particular situation; see fixed_entry_from_ref().
+ * Drop the removed entries from the array and rebuild the slots table with
+ * the specified size. Nothing is modified if the allocation fails.
  */
-static void fix_refs(struct hmap *hm, struct bucket *b, struct hmap_ref removed)
+static int rehash(struct hmap *hm, size_t new_size)
 {
-    for (int i = removed.entry_id; i < b->nb_entries; i++) {
-        struct hmap_entry *e = &b->entries[i];
-        struct hmap_entry *prev = fixed_entry_from_ref(hm, e->prev, removed, i);
-        struct hmap_entry *next = fixed_entry_from_ref(hm, e->next, removed, i);
-        struct hmap_ref *prev_ref = prev ? &prev->next : &hm->first;
-        struct hmap_ref *next_ref = next ? &next->prev : &hm->last;
-        prev_ref->entry_id--;
-        next_ref->entry_id--;
-    }
+    struct slot *new_slots = ngli_calloc(new_size, sizeof(*new_slots));
+    if (!new_slots)
+        return NGL_ERROR_MEMORY;
+    clear_slots(new_slots, new_size);
+
+    size_t nb_entries = 0;
+    for (size_t i = 0; i < hm->nb_entries; i++)
+        if (hm->entries[i].key)
+            hm->entries[nb_entries++] = hm->entries[i];
+
+    ngli_free(hm->slots);
+    hm->slots = new_slots;
+    hm->size = new_size;
+    hm->mask = new_size - 1;
+    hm->nb_entries = nb_entries;
+    hm->nb_used_slots = 0;
+    for (size_t i = 0; i < nb_entries; i++)
+        insert_slot(hm->slots, hm->mask, hm->entries[i].hash, (uint32_t)i, &hm->nb_used_slots);
+    return 0;
 }
 
-static int add_entry(struct hmap *hm, struct bucket *b, char *key, void *data, int id)
+/* Make room for one more entry in both the entries array and the slots table */
+static int reserve_entry(struct hmap *hm)
 {
-    struct hmap_entry *entries = ngli_realloc(b->entries, b->nb_entries + 1, sizeof(*b->entries));
-    if (!entries)
-        return NGL_ERROR_MEMORY;
-    b->entries = entries;
-    struct hmap_entry *e = &entries[b->nb_entries++];
-    e->key = key;
-    e->data = data;
-    e->bucket_id = id;
-    e->prev = hm->last;
-    e->next = NO_REF;
-
-    /* update global first reference */
-    const struct hmap_ref ref = ref_from_entry(hm, e);
-    if (!HAS_REF(hm->first))
-        hm->first = ref;
-
-    /* update global last reference */
-    struct hmap_entry *last = entry_from_ref(hm, hm->last);
-    if (last)
-        last->next = ref;
-    hm->last = ref;
+    if (hm->nb_entries == hm->entries_cap) {
+        const size_t nb_removed = hm->nb_entries - hm->count;
+        if (nb_removed && nb_removed >= hm->nb_entries / 2)
+            return rehash(hm, hm->size);
+
+        if (hm->entries_cap >= MAX_ENTRIES)
+            return NGL_ERROR_LIMIT_EXCEEDED;
+        const size_t new_cap = hm->entries_cap ? NGLI_MIN(hm->entries_cap * 2, MAX_ENTRIES) : hm->size;
+        struct hmap_entry *entries = ngli_realloc(hm->entries, new_cap, sizeof(*hm->entries));
+        if (!entries)
+            return NGL_ERROR_MEMORY;
+        hm->entries = entries;
+        hm->entries_cap = new_cap;
+    }
+
+    /* Keep the load factor (deleted slots included) below 3/4 */
+    if ((hm->nb_used_slots + 1) * 4 > hm->size * 3) {
+        /* Only grow if purging the deleted slots is not enough */
+        size_t new_size = hm->size;
+        if ((hm->count + 1) * 2 > hm->size) {
+#if HAVE_BUILTIN_OVERFLOW
+            if (__builtin_mul_overflow(hm->size, 2, &new_size))
+                return NGL_ERROR_LIMIT_EXCEEDED;
+#else
+            /* Also includes the calloc overflow check */
+            if (hm->size >= 1ULL << (sizeof(hm->size)*8 - 5))
+                return NGL_ERROR_LIMIT_EXCEEDED;
+            new_size = hm->size * 2;
+#endif
+        }
+        return rehash(hm, new_size);
+    }
 
-    hm->count++;
     return 0;
 }
 
-int ngli_hmap_set(struct hmap *hm, const char *key, void *data)
+static void remove_entry(struct hmap *hm, size_t slot_id)
+{
+    struct slot *slot = &hm->slots[slot_id];
+    struct hmap_entry *e = &hm->entries[slot->id];
+
+    ngli_freep(&e->key);
+    if (hm->user_free_func)
+        hm->user_free_func(hm->user_arg, e->data);
+    e->data = NULL;
+    slot->id = SLOT_DELETED;
+    hm->count--;
+
+    /* Start over from a clean state when the map becomes empty */
+    if (!hm->count) {
+        clear_slots(hm->slots, hm->size);
+        hm->nb_used_slots = 0;
+        hm->nb_entries = 0;
+    }
+}
+
+int ngli_hmap_set_prehashed(struct hmap *hm, const char *key, uint64_t hash, void *data)
 {
     if (!key)
         return NGL_ERROR_INVALID_ARG;
 
-    const uint32_t hash = ngli_crc32(key);
-    int id = hash & hm->mask;
-    struct bucket *b = &hm->buckets[id];
+    const size_t slot_id = find_slot(hm, key, hash);
 
     /* Delete */
     if (!data) {
-        for (int i = 0; i < b->nb_entries; i++) {
-            struct hmap_entry *e = &b->entries[i];
-            if (!strcmp(e->key, key)) {
-
-                /* Link previous and next entries together */
-                struct hmap_entry *prev = entry_from_ref(hm, e->prev);
-                struct hmap_entry *next = entry_from_ref(hm, e->next);
-                struct hmap_ref *link_from_back  = prev ? &prev->next : &hm->first;
-                struct hmap_ref *link_from_front = next ? &next->prev : &hm->last;
-                *link_from_back = e->next;
-                *link_from_front = e->prev;
-
-                /* Keep a reference pre-remove for fixing the refs later */
-                const struct hmap_ref removed = ref_from_entry(hm, e);
-
-                ngli_free(e->key);
-                if (hm->user_free_func)
-                    hm->user_free_func(hm->user_arg, e->data);
-                hm->count--;
-                b->nb_entries--;
-                if (!b->nb_entries) {
-                    ngli_freep(&b->entries);
-                } else {
-                    memmove(e, e + 1, (b->nb_entries - i) * sizeof(*b->entries));
-                    struct hmap_entry *entries =
-                        ngli_realloc(b->entries, b->nb_entries, sizeof(*b->entries));
-                    if (!entries)
-                        return 0; // unable to realloc but entry got dropped, so this is OK
-                    b->entries = entries;
-                    fix_refs(hm, b, removed);
-                }
-                return 1;
-            }
-        }
-        return 0;
-    }
-
-    /* Replace */
-    for (int i = 0; i < b->nb_entries; i++) {
-        struct hmap_entry *e = &b->entries[i];
-        if (!strcmp(e->key, key)) {
-            if (hm->user_free_func)
-                hm->user_free_func(hm->user_arg, e->data);
-            e->data = data;
+        if (slot_id == SIZE_MAX)
             return 0;
-        }
+        remove_entry(hm, slot_id);
+        return 1;
     }
 
-    /* Resize check before addition  */
-    if (hm->count * 3 / 4 >= hm->size) {
-        struct hmap old_hm = *hm;
-
-#if HAVE_BUILTIN_OVERFLOW
-        size_t new_size;
-        if (__builtin_mul_overflow(hm->size, 2, &new_size))
-            return NGL_ERROR_LIMIT_EXCEEDED;
-#else
-        /* Also includes the realloc overflow check */
-        if (hm->size >= 1ULL << (sizeof(hm->size)*8 - 2))
-            return NGL_ERROR_LIMIT_EXCEEDED;
-        size_t new_size = hm->size * 2;
-#endif
-
-        struct bucket *new_buckets = ngli_calloc(new_size, sizeof(*new_buckets));
-        if (new_buckets) {
-            hm->buckets = new_buckets;
-            hm->count = 0;
-            hm->size = new_size;
-            hm->mask = hm->size - 1;
-            hm->first = hm->last = NO_REF;
-
-            if (old_hm.count) {
-                /* Transfer all entries to the new map */
-                const struct hmap_entry *e = NULL;
-                while ((e = ngli_hmap_next(&old_hm, e))) {
-                    const int new_id = ngli_crc32(e->key) & hm->mask;
-                    struct bucket *b = &hm->buckets[new_id];
-                    int ret = add_entry(hm, b, e->key, e->data, new_id);
-                    if (ret < 0) {
-                        /* Unable to allocate more, ngli_free the incomplete buckets
-                         * and restore the previous hashmap state */
-                        for (int j = 0; j < hm->size; j++)
-                            ngli_free(hm->buckets[j].entries);
-                        ngli_free(hm->buckets);
-                        *hm = old_hm;
-                        return NGL_ERROR_MEMORY;
-                    }
-                }
-
-                /* Destroy previous indexes in the old buckets */
-                for (int j = 0; j < old_hm.size; j++) {
-                    struct bucket *b = &old_hm.buckets[j];
-                    ngli_free(b->entries);
-                    old_hm.count -= b->nb_entries;
-                    if (old_hm.count == 0)
-                        break;
-                }
-            }
-
-            ngli_free(old_hm.buckets);
-
-            /* Fix the bucket position for the entry to add */
-            id = hash & hm->mask;
-            b = &hm->buckets[id];
-        }
+    /* Replace */
+    if (slot_id != SIZE_MAX) {
+        struct hmap_entry *e = &hm->entries[hm->slots[slot_id].id];
+        if (hm->user_free_func)
+            hm->user_free_func(hm->user_arg, e->data);
+        e->data = data;
+        return 0;
     }
 
     /* Add */
     char *new_key = ngli_strdup(key);
     if (!new_key)
         return NGL_ERROR_MEMORY;
-    int ret = add_entry(hm, b, new_key, data, id);
+
+    int ret = reserve_entry(hm);
     if (ret < 0) {
         ngli_free(new_key);
         return ret;
     }
 
+    const size_t id = hm->nb_entries++;
+    hm->entries[id] = (struct hmap_entry){.key = new_key, .data = data, .hash = hash};
+    insert_slot(hm->slots, hm->mask, hash, (uint32_t)id, &hm->nb_used_slots);
+    hm->count++;
     return 0;
 }
 
+int ngli_hmap_set(struct hmap *hm, const char *key, void *data)
+{
+    if (!key)
+        return NGL_ERROR_INVALID_ARG;
+    return ngli_hmap_set_prehashed(hm, key, ngli_hmap_hash_key(key), data);
+}
+
 struct hmap_entry *ngli_hmap_next(const struct hmap *hm,
                                   const struct hmap_entry *prev)
 {
-    return entry_from_ref(hm, prev ? prev->next : hm->first);
+    for (size_t i = prev ? prev - hm->entries + 1 : 0; i < hm->nb_entries; i++)
+        if (hm->entries[i].key)
+            return &hm->entries[i];
+    return NULL;
 }
 
-void *ngli_hmap_get(const struct hmap *hm, const char *key)
+void *ngli_hmap_get_prehashed(const struct hmap *hm, const char *key, uint64_t hash)
 {
-    const int id = ngli_crc32(key) & hm->mask;
-    const struct bucket *b = &hm->buckets[id];
+    const size_t slot_id = find_slot(hm, key, hash);
+    return slot_id != SIZE_MAX ? hm->entries[hm->slots[slot_id].id].data : NULL;
+}
 
-    for (int i = 0; i < b->nb_entries; i++) {
-        struct hmap_entry *e = &b->entries[i];
-        if (!strcmp(e->key, key))
-            return e->data;
-    }
-    return NULL;
+void *ngli_hmap_get(const struct hmap *hm, const char *key)
+{
+    return ngli_hmap_get_prehashed(hm, key, ngli_hmap_hash_key(key));
 }
 
 void ngli_hmap_freep(struct hmap **hmp)
@@ -323,22 +302,16 @@ void ngli_hmap_freep(struct hmap **hmp)
     if (!hm)
         return;
 
-    if (hm->count) {
-        for (int j = 0; j < hm->size; j++) {
-            struct bucket *b = &hm->buckets[j];
-            for (int i = 0; i < b->nb_entries; i++) {
-                struct hmap_entry *e = &b->entries[i];
-                ngli_free(e->key);
-                if (hm->user_free_func)
-                    hm->user_free_func(hm->user_arg, e->data);
-            }
-            ngli_free(b->entries);
-            hm->count -= b->nb_entries;
-            if (hm->count == 0)
-                break;
-        }
+    for (size_t i = 0; i < hm->nb_entries; i++) {
+        struct hmap_entry *e = &hm->entries[i];
+        if (!e->key)
+            continue;
+        ngli_free(e->key);
+        if (hm->user_free_func)
+            hm->user_free_func(hm->user_arg, e->data);
     }
 
-    ngli_free(hm->buckets);
+    ngli_free(hm->entries);
+    ngli_free(hm->slots);
     ngli_freep(hmp);
 }
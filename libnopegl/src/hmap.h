@@ -22,6 +22,7 @@
 #ifndef HMAP_H
 #define HMAP_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifndef HMAP_SIZE_NBIT
@@ -30,17 +31,10 @@
 
 struct hmap;
 
-struct hmap_ref { /* internal entry reference */
-    int bucket_id;
-    int entry_id;
-};
-
 struct hmap_entry {
     char *key;
     void *data;
-    int bucket_id;
-    struct hmap_ref prev;
-    struct hmap_ref next;
+    uint64_t hash;
 };
 
 typedef void (*user_free_func_type)(void *user_arg, void *data);
@@ -50,6 +44,17 @@ void ngli_hmap_set_free(struct hmap *hm, user_free_func_type user_free_func, voi
 size_t ngli_hmap_count(const struct hmap *hm);
 int ngli_hmap_set(struct hmap *hm, const char *key, void *data);
 void *ngli_hmap_get(const struct hmap *hm, const char *key);
+
+/*
+ * Variants of ngli_hmap_set() and ngli_hmap_get() taking the hash of the key
+ * computed ahead of time, typically with ngli_hmap_hash_key(). A caller may
+ * also provide its own well distributed 64-bit hash as long as every access
+ * to the map goes through these variants with the same hash for a given key.
+ */
+uint64_t ngli_hmap_hash_key(const char *key);
+int ngli_hmap_set_prehashed(struct hmap *hm, const char *key, uint64_t hash, void *data);
+void *ngli_hmap_get_prehashed(const struct hmap *hm, const char *key, uint64_t hash);
+
 struct hmap_entry *ngli_hmap_next(const struct hmap *hm, const struct hmap_entry *prev);
 void ngli_hmap_freep(struct hmap **hmp);
 
@@ -36,8 +36,6 @@
 #include "utils.h"
 
 /* GLSL fragments as string */
-#include "hdr_hlg2sdr_frag.h"
-#include "hdr_pq2sdr_frag.h"
 #include "hwconv_frag.h"
 #include "hwconv_vert.h"
 
@@ -96,22 +94,10 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
         {.name = "tex", .type = NGLI_PGCRAFT_SHADER_TEX_TYPE_VIDEO, .stage = NGLI_PROGRAM_SHADER_FRAG},
     };
 
-    const char *vert_base = hwconv_vert;
-    const char *frag_base = hwconv_frag;
-
-    const struct color_info *src_color_info = &src_params->color_info;
-    if (src_color_info->space == NMD_COL_SPC_BT2020_NCL) {
-        if (src_color_info->transfer == NMD_COL_TRC_ARIB_STD_B67) { // HLG
-            frag_base = hdr_hlg2sdr_frag;
-        } else if (src_color_info->transfer == NMD_COL_TRC_SMPTE2084)  { // PQ
-            frag_base = hdr_pq2sdr_frag;
-        }
-    }
-
     const struct pgcraft_params crafter_params = {
         .program_label    = "nopegl/hwconv",
-        .vert_base        = vert_base,
-        .frag_base        = frag_base,
+        .vert_base        = hwconv_vert,
+        .frag_base        = hwconv_frag,
         .textures         = textures,
         .nb_textures      = NGLI_ARRAY_NB(textures),
         .vert_out_vars    = vert_out_vars,
@@ -213,6 +199,7 @@ int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image)
     ngli_pipeline_compat_update_uniform(pipeline, fields[NGLI_INFO_FIELD_SAMPLING_MODE].index, &image->params.layout);
     ngli_pipeline_compat_update_uniform(pipeline, fields[NGLI_INFO_FIELD_COORDINATE_MATRIX].index, image->coordinates_matrix);
     ngli_pipeline_compat_update_uniform(pipeline, fields[NGLI_INFO_FIELD_COLOR_MATRIX].index, image->color_matrix);
+    ngli_pipeline_compat_update_uniform(pipeline, fields[NGLI_INFO_FIELD_TONEMAP].index, &image->tonemap);
 
     ngli_pipeline_compat_draw(pipeline, 3, 1);
 
@@ -208,6 +208,14 @@ static int is_hdr(int trc)
     }
 }
 
+static int support_fused_tonemapping(const struct hwmap *hwmap)
+{
+    const struct hwmap_params *params = &hwmap->params;
+
+    /* The mipmaps must be generated from the converted content */
+    return params->fused_tonemapping && params->texture_mipmap_filter == NGLI_MIPMAP_FILTER_NONE;
+}
+
 int ngli_hwmap_map_frame(struct hwmap *hwmap, struct nmd_frame *frame, struct image *image)
 {
     if (frame->width  != hwmap->width ||
@@ -242,7 +250,7 @@ int ngli_hwmap_map_frame(struct hwmap *hwmap, struct nmd_frame *frame, struct im
     if (ret < 0)
         goto end;
 
-    if (is_hdr(frame->color_trc))
+    if (is_hdr(frame->color_trc) && !support_fused_tonemapping(hwmap))
         hwmap->require_hwconv = 1;
 
     if (hwmap->require_hwconv) {
@@ -41,6 +41,8 @@ struct hwmap_params {
     int texture_wrap_s;
     int texture_wrap_t;
     int texture_usage;
+    /* The consumers apply the HDR to SDR conversion when sampling the image */
+    int fused_tonemapping;
 #if defined(TARGET_ANDROID)
     struct android_surface *android_surface;
     struct android_imagereader *android_imagereader;
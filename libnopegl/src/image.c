@@ -49,6 +49,21 @@ static const size_t nb_planes_map[] = {
 
 NGLI_STATIC_ASSERT(nb_planes_map, NGLI_ARRAY_NB(nb_planes_map) == NGLI_NB_IMAGE_LAYOUTS);
 
+static int get_tonemap(const struct color_info *color_info)
+{
+    if (color_info->space != NMD_COL_SPC_BT2020_NCL)
+        return NGLI_IMAGE_TONEMAP_NONE;
+
+    switch (color_info->transfer) {
+    case NMD_COL_TRC_ARIB_STD_B67:
+        return NGLI_IMAGE_TONEMAP_HLG;
+    case NMD_COL_TRC_SMPTE2084:
+        return NGLI_IMAGE_TONEMAP_PQ;
+    default:
+        return NGLI_IMAGE_TONEMAP_NONE;
+    }
+}
+
 void ngli_image_init(struct image *s, const struct image_params *params, struct texture **planes)
 {
     ngli_image_reset(s);
@@ -62,6 +77,7 @@ void ngli_image_init(struct image *s, const struct image_params *params, struct
         params->layout == NGLI_IMAGE_LAYOUT_YUV) {
         ngli_colorconv_get_ycbcr_to_rgb_color_matrix(s->color_matrix, &params->color_info, params->color_scale);
     }
+    s->tonemap = get_tonemap(&params->color_info);
 }
 
 void ngli_image_reset(struct image *s)
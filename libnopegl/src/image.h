@@ -54,6 +54,16 @@ enum image_layout {
     NGLI_NB_IMAGE_LAYOUTS
 };
 
+/*
+ * HDR to SDR conversion applied when sampling the image; the values are
+ * matched by the ngli_texvideo_tonemap() shader helper
+ */
+enum image_tonemap {
+    NGLI_IMAGE_TONEMAP_NONE = 0,
+    NGLI_IMAGE_TONEMAP_HLG  = 1,
+    NGLI_IMAGE_TONEMAP_PQ   = 2,
+};
+
 struct image_params {
     int32_t width;
     int32_t height;
@@ -68,6 +78,7 @@ struct image {
     struct texture *planes[4];
     size_t nb_planes;
     NGLI_ALIGNED_MAT(color_matrix);
+    int tonemap;
     /* mutable fields after initialization */
     NGLI_ALIGNED_MAT(coordinates_matrix);
     float ts;
@@ -41,7 +41,9 @@
 #include "animation.h"
 #include "atlas.h"
 #include "block.h"
+#include "drawlist.h"
 #include "drawutils.h"
+#include "glyphcache.h"
 #include "graphics_state.h"
 #include "hmap.h"
 #include "hud.h"
@@ -59,6 +61,8 @@
 #include "rendertarget.h"
 #include "rnode.h"
 #include "texture.h"
+#include "texturepool.h"
+#include "threadpool.h"
 
 struct node_class;
 
@@ -71,6 +75,8 @@ struct api_impl {
     int (*set_scene)(struct ngl_ctx *s, struct ngl_scene *scene);
     int (*prepare_draw)(struct ngl_ctx *s, double t);
     int (*draw)(struct ngl_ctx *s, double t);
+    int (*draw_async)(struct ngl_ctx *s, double t, uint64_t *ticketp);
+    int (*capture_acquire)(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp);
     void (*reset)(struct ngl_ctx *s, int action);
 
     /* OpenGL */
@@ -87,6 +93,7 @@ struct ngl_ctx {
     struct gpu_ctx *gpu_ctx;
     struct rnode rnode;
     struct rnode *rnode_pos;
+    struct drawlist drawlist;
     struct ngl_scene *scene;
     struct ngl_config config;
     struct rendertarget *available_rendertargets[2];
@@ -102,8 +109,24 @@ struct ngl_ctx {
      */
     struct darray activitycheck_nodes;
 
+    /*
+     * Nodes implementing the update_prepare callback, registered when they are
+     * attached to the context. Their prepare stage is dispatched to the update
+     * thread pool (if enabled) before the update of the scene.
+     */
+    struct darray update_prepare_nodes;
+    struct threadpool *update_pool;
+
+    /* Upcoming draw times announced with ngl_hint_timeline() */
+    double hint_t0;
+    double hint_dt;
+    int32_t hint_nb_frames;
+
     struct atlas *font_atlas;
     int32_t char_map[256];
+    struct glyphcache *glyphcache;
+    struct glyphcache *sdf_glyphcache;
+    struct texturepool *transient_textures;
 
     struct pgcache pgcache;
 #if defined(HAVE_VAAPI)
@@ -136,6 +159,8 @@ int ngli_ctx_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer);
 int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene);
 int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t);
 int ngli_ctx_draw(struct ngl_ctx *s, double t);
+int ngli_ctx_draw_async(struct ngl_ctx *s, double t, uint64_t *ticketp);
+int ngli_ctx_capture_acquire(struct ngl_ctx *s, uint64_t ticket, const uint8_t **bufp);
 void ngli_ctx_reset(struct ngl_ctx *s, int action);
 
 #define NGLI_NODE_NONE 0xffffffff
@@ -150,6 +175,7 @@ struct ngl_node {
     int is_active;
 
     double visit_time;
+    double prepared_time;
     double last_update_time;
 
     int draw_count;
@@ -186,6 +212,8 @@ struct buffer_layout {
 
 #define NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD (1 << 0) /* The buffer is responsible for uploading its data to the GPU */
 #define NGLI_BUFFER_INFO_FLAG_DYNAMIC    (1 << 1) /* The buffer CPU data may change at every update */
+#define NGLI_BUFFER_INFO_FLAG_READ_ONLY  (1 << 2) /* The buffer CPU data is a read-only file mapping and must never be written */
+#define NGLI_BUFFER_INFO_FLAG_GPU_ONLY   (1 << 3) /* The buffer data is only updated on the GPU and can not be read by the CPU */
 
 struct buffer_info {
     struct buffer_layout layout;
@@ -205,6 +233,18 @@ void ngli_node_buffer_extend_usage(struct ngl_node *node, int usage);
 size_t ngli_node_buffer_get_cpu_size(struct ngl_node *node);
 size_t ngli_node_buffer_get_gpu_size(struct ngl_node *node);
 
+/*
+ * Check that the CPU data of the given Buffer* node can be used, which is not
+ * the case of the buffers only updated on the GPU.
+ */
+int ngli_node_buffer_check_cpu_usage(const struct ngl_node *node);
+
+/*
+ * Hint that the given byte range of a Buffer* node data is about to be
+ * accessed. Only has an effect for the file-backed buffers.
+ */
+void ngli_node_buffer_prefetch(struct ngl_node *node, size_t offset, size_t size);
+
 struct livectl {
     union ngl_livectl_data val;
     char *id;
@@ -231,6 +271,7 @@ struct variable_info {
     size_t data_size;
     int data_type;          // any of NGLI_TYPE_*
     int dynamic;
+    size_t rev;             // incremented every time data may have changed
 };
 
 int ngli_velocity_evaluate(struct ngl_node *node, void *dst, double t);
@@ -250,6 +291,19 @@ void ngli_node_block_extend_usage(struct ngl_node *node, int usage);
 size_t ngli_node_block_get_cpu_size(struct ngl_node *node);
 size_t ngli_node_block_get_gpu_size(struct ngl_node *node);
 
+/*
+ * Draw batching: consecutive siblings made of a transformation chain (which
+ * can be empty) ending with a compatible RenderColor or RenderTexture node
+ * can be rendered with a single instanced draw call
+ */
+struct render_batch;
+struct ngl_node *ngli_render_batch_get_leaf(struct ngl_node *node);
+int ngli_render_batch_is_compatible(const struct ngl_node *leaf_a, const struct ngl_node *leaf_b);
+struct render_batch *ngli_render_batch_create(struct ngl_ctx *ctx);
+int ngli_render_batch_init(struct render_batch *s, struct ngl_node **children, size_t nb_children);
+void ngli_render_batch_draw(struct render_batch *s);
+void ngli_render_batch_freep(struct render_batch **sp);
+
 struct program_opts {
     const char *vertex;
     const char *fragment;
@@ -281,12 +335,14 @@ struct texture_priv {
     struct texture *texture;
     struct image image;
     struct hwmap hwmap;
+    size_t rev;             // incremented every time the texture content may have changed
 };
 
 struct media_priv {
     struct nmd_ctx *player;
     struct nmd_frame *frame;
     size_t nb_parents;
+    struct mediaqueue *queue;
 
 #if defined(TARGET_ANDROID)
     struct android_surface *android_surface;
@@ -468,6 +524,13 @@ enum {
  */
 #define NGLI_NODE_FLAG_LIVECTL (1 << 0)
 
+/*
+ * The node output depends on the time in a way that can not be deduced from
+ * its children (such as a time range or a GPU computation), so any drawing
+ * involving it must be executed again at every frame.
+ */
+#define NGLI_NODE_FLAG_TIME_DEPENDENT (1 << 1)
+
 /*
  * Specifications of a node.
  *
@@ -525,6 +588,23 @@ struct node_class {
      */
     int (*prepare)(struct ngl_node *node);
 
+    /*
+     * Record the draw of the node into the context draw list, which is then
+     * replayed at every draw instead of walking the graph.
+     *
+     * Nodes only applying a state around the draw of their children (such as
+     * transforms) are expected to record that state with push/pop operations
+     * and forward the call to their children, updating ctx->rnode_pos the same
+     * way as in the draw callback if they split the tree in branches.
+     *
+     * reentrant: yes (there is a different rnode per path)
+     * execution-order: root first
+     * dispatch: delegated (the node is recorded as a single draw operation
+     *           executing its draw callback by default)
+     * when: called during set_scene() (after prepare)
+     */
+    int (*record)(struct ngl_node *node, struct drawlist *drawlist);
+
 
     /*******************************
      * Draw/update stage callbacks *
@@ -571,6 +651,27 @@ struct node_class {
      */
     int (*invalidate)(struct ngl_node *node);
 
+    /*
+     * Compute the CPU side of the update according to the time, ahead of the
+     * update callback. The callback may be executed concurrently with the one
+     * of other nodes from a thread that is not the worker, so it MUST NOT
+     * access the GPU, the rendering context, or the private data of any other
+     * node. It is only allowed to read the node options and its children
+     * options (which cannot change during a draw call).
+     *
+     * A prepare for a given time is always followed by an update for the same
+     * time, so the update callback is expected to only contain the work that
+     * needs to be serialized (typically the GPU uploads).
+     *
+     * reentrant: no (based on node prepared_time and last_update_time)
+     * execution-order: none
+     * dispatch: managed
+     * when: between ngli_node_honor_release_prefetch() and the update phase
+     *       when the update threads are enabled, as part of ngli_node_update()
+     *       otherwise
+     */
+    int (*update_prepare)(struct ngl_node *node, double t);
+
     /*
      * Update CPU/GPU resources according to the time.
      *
@@ -635,7 +736,11 @@ struct node_class {
 
 /* Internal scene API */
 int ngli_scene_deserialize(struct ngl_scene *scene, const char *str);
+int ngli_scene_deserialize_mem(struct ngl_scene *scene, const void *data, size_t size);
+int ngli_scene_apply_patch(struct ngl_scene *scene, const char *patch);
 char *ngli_scene_serialize(const struct ngl_scene *scene);
+int ngli_scene_get_nodes(const struct ngl_scene *scene, struct darray *nodes);
+void *ngli_scene_serialize_binary(const struct ngl_scene *scene, size_t *sizep);
 char *ngli_scene_dot(const struct ngl_scene *scene);
 
 void ngli_node_print_specs(void);
@@ -645,10 +750,12 @@ int ngli_node_prepare_children(struct ngl_node *node);
 int ngli_node_visit(struct ngl_node *node, int is_active, double t);
 int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t);
 int ngli_node_update(struct ngl_node *node, double t);
+int ngli_node_update_prepare_parallel(struct ngl_ctx *s, double t);
 int ngli_node_update_children(struct ngl_node *node, double t);
 void *ngli_node_get_data_ptr(struct ngl_node *var_node, void *data_fallback);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
 void ngli_node_draw(struct ngl_node *node);
+int ngli_node_record(struct ngl_node *node, struct drawlist *drawlist);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
@@ -660,5 +767,8 @@ char *ngli_node_default_label(const char *class_name);
 int ngli_is_default_label(const char *class_name, const char *str);
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp);
+int ngli_node_param_is_value_allowed(struct ngl_node *node, const char *key,
+                                     const uint8_t *ptr, const struct node_param *par);
+int ngli_node_param_update(struct ngl_node *node, const struct node_param *par);
 
 #endif
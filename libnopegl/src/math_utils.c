@@ -118,6 +118,12 @@ float ngli_vec4_dot(const float *v1, const float *v2)
          + v1[3]*v2[3];
 }
 
+void ngli_vec_lerp_c(float *dst, const float *v1, const float *v2, float c, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = NGLI_MIX_F32(v1[i], v2[i], c);
+}
+
 void ngli_vec4_lerp(float *dst, const float *v1, const float *v2, float c)
 {
     const float a[4] = {NGLI_ARG_VEC4(v1)};
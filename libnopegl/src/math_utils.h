@@ -22,6 +22,8 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include <stddef.h>
+
 #include "config.h"
 
 #define PI_F32 3.14159265358979323846f
@@ -98,6 +100,8 @@ void ngli_mat3_inverse(float *dst, const float *m);
                             0.0f, 0.0f, 1.0f, 0.0f, \
                             0.0f, 0.0f, 0.0f, 1.0f} \
 
+void ngli_vec_lerp_c(float *dst, const float *v1, const float *v2, float c, size_t n);
+
 void ngli_mat4_identity(float *dst);
 void ngli_mat4_mul_c(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v);
@@ -115,18 +119,23 @@ void ngli_mat4_skew(float * restrict dst, float x, float y, float z, const float
 #ifdef ARCH_AARCH64
 # define ngli_mat4_mul          ngli_mat4_mul_aarch64
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
+# define ngli_vec_lerp          ngli_vec_lerp_aarch64
 #elif defined(HAVE_X86_INTR)
 # define ngli_mat4_mul          ngli_mat4_mul_sse
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_sse
+# define ngli_vec_lerp          ngli_vec_lerp_sse
 #else
 # define ngli_mat4_mul          ngli_mat4_mul_c
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
+# define ngli_vec_lerp          ngli_vec_lerp_c
 #endif
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
+void ngli_vec_lerp_aarch64(float *dst, const float *v1, const float *v2, float c, size_t n);
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v);
+void ngli_vec_lerp_sse(float *dst, const float *v1, const float *v2, float c, size_t n);
 
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "log.h"
+#include "mediaqueue.h"
+#include "memory.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+enum {
+    ENTRY_PENDING,
+    ENTRY_DECODING,
+    ENTRY_READY,
+};
+
+struct entry {
+    double t;
+    struct nmd_frame *frame;
+    int state;
+};
+
+struct mediaqueue {
+    struct nmd_ctx *player;
+    struct entry *entries; // ring buffer
+    size_t size;
+    size_t head;
+    size_t count;
+    size_t nb_hits;
+    size_t nb_misses;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_work;
+    pthread_cond_t cond_done;
+    int thread_started;
+    int stop;
+};
+
+static struct entry *get_entry(struct mediaqueue *s, size_t i)
+{
+    return &s->entries[(s->head + i) % s->size];
+}
+
+/* The entries are always decoded in order so there is at most one in progress */
+static struct entry *get_pending_entry(struct mediaqueue *s)
+{
+    for (size_t i = 0; i < s->count; i++) {
+        struct entry *e = get_entry(s, i);
+        if (e->state == ENTRY_PENDING)
+            return e;
+    }
+    return NULL;
+}
+
+static void *worker_thread(void *arg)
+{
+    struct mediaqueue *s = arg;
+
+    ngli_thread_set_name("ngl-media");
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        struct entry *e;
+        while (!s->stop && !(e = get_pending_entry(s)))
+            pthread_cond_wait(&s->cond_work, &s->lock);
+        if (s->stop)
+            break;
+
+        /* The entry can not be dropped while it is being decoded */
+        e->state = ENTRY_DECODING;
+        const double t = e->t;
+        pthread_mutex_unlock(&s->lock);
+        struct nmd_frame *frame = nmd_get_frame(s->player, t);
+        pthread_mutex_lock(&s->lock);
+        e->frame = frame;
+        e->state = ENTRY_READY;
+        pthread_cond_broadcast(&s->cond_done);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+struct mediaqueue *ngli_mediaqueue_create(struct nmd_ctx *player, size_t size)
+{
+    struct mediaqueue *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->player = player;
+    s->size = size;
+    s->entries = ngli_calloc(size, sizeof(*s->entries));
+    if (!s->entries) {
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->cond_work, NULL) ||
+        pthread_cond_init(&s->cond_done, NULL)) {
+        pthread_cond_destroy(&s->cond_work);
+        pthread_cond_destroy(&s->cond_done);
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s->entries);
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_create(&s->thread, NULL, worker_thread, s)) {
+        LOG(ERROR, "could not create media queue thread");
+        ngli_mediaqueue_freep(&s);
+        return NULL;
+    }
+    s->thread_started = 1;
+
+    return s;
+}
+
+/* Must be called with the lock held */
+static void pop_entry(struct mediaqueue *s)
+{
+    struct entry *e = get_entry(s, 0);
+    while (e->state == ENTRY_DECODING)
+        pthread_cond_wait(&s->cond_done, &s->lock);
+    nmd_release_frame(e->frame);
+    e->frame = NULL;
+    s->head = (s->head + 1) % s->size;
+    s->count--;
+}
+
+struct nmd_frame *ngli_mediaqueue_get_frame(struct mediaqueue *s, double t,
+                                            const double *next_times, size_t nb_next_times)
+{
+    struct nmd_frame *frame = NULL;
+    int found = 0;
+
+    pthread_mutex_lock(&s->lock);
+
+    /* Drop the frames that are not going to be used anymore */
+    while (s->count && get_entry(s, 0)->t < t)
+        pop_entry(s);
+
+    if (s->count && get_entry(s, 0)->t == t) {
+        struct entry *e = get_entry(s, 0);
+        while (e->state != ENTRY_READY)
+            pthread_cond_wait(&s->cond_done, &s->lock);
+        frame = e->frame;
+        e->frame = NULL;
+        pop_entry(s);
+        found = 1;
+        s->nb_hits++;
+    } else {
+        /*
+         * The time is not the expected one (seek, irregular times): the
+         * pending requests are dropped so that the thread is idle while the
+         * frame is retrieved synchronously.
+         */
+        while (s->count)
+            pop_entry(s);
+        s->nb_misses++;
+    }
+
+    if (!found)
+        frame = nmd_get_frame(s->player, t);
+
+    double last_time = s->count ? get_entry(s, s->count - 1)->t : t;
+    int queued = 0;
+    for (size_t i = 0; i < nb_next_times && s->count < s->size; i++) {
+        if (next_times[i] <= last_time)
+            continue;
+        struct entry *e = get_entry(s, s->count++);
+        *e = (struct entry){.t = next_times[i], .state = ENTRY_PENDING};
+        last_time = next_times[i];
+        queued = 1;
+    }
+    if (queued)
+        pthread_cond_signal(&s->cond_work);
+
+    pthread_mutex_unlock(&s->lock);
+
+    return frame;
+}
+
+void ngli_mediaqueue_flush(struct mediaqueue *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->count)
+        pop_entry(s);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_mediaqueue_freep(struct mediaqueue **sp)
+{
+    struct mediaqueue *s = *sp;
+    if (!s)
+        return;
+
+    if (s->thread_started) {
+        pthread_mutex_lock(&s->lock);
+        s->stop = 1;
+        pthread_cond_signal(&s->cond_work);
+        pthread_mutex_unlock(&s->lock);
+        pthread_join(s->thread, NULL);
+    }
+
+    /* The thread is stopped so no entry can be in progress */
+    for (size_t i = 0; i < s->count; i++)
+        nmd_release_frame(get_entry(s, i)->frame);
+
+    LOG(DEBUG, "media queue: %zu hits, %zu misses", s->nb_hits, s->nb_misses);
+
+    pthread_cond_destroy(&s->cond_done);
+    pthread_cond_destroy(&s->cond_work);
+    pthread_mutex_destroy(&s->lock);
+    ngli_free(s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef MEDIAQUEUE_H
+#define MEDIAQUEUE_H
+
+#include <stddef.h>
+#include <nopemd.h>
+
+/*
+ * Look-ahead queue of nope.media frames.
+ *
+ * The frames at the upcoming times are requested from a dedicated thread so
+ * that they are already decoded when the corresponding update happens. Once
+ * the queue is created, the player must only be accessed through the queue,
+ * except after a ngli_mediaqueue_flush() and until the next frame request.
+ */
+struct mediaqueue;
+
+struct mediaqueue *ngli_mediaqueue_create(struct nmd_ctx *player, size_t size);
+
+/*
+ * Return the frame at time t, which is owned by the caller, and queue the
+ * requests for the increasing upcoming times. A queued frame is only used if
+ * it was requested for the exact same time, otherwise the frame is retrieved
+ * synchronously.
+ */
+struct nmd_frame *ngli_mediaqueue_get_frame(struct mediaqueue *s, double t,
+                                            const double *next_times, size_t nb_next_times);
+
+/* Drop all the queued frames and wait for the thread to be idle */
+void ngli_mediaqueue_flush(struct mediaqueue *s);
+
+void ngli_mediaqueue_freep(struct mediaqueue **sp);
+
+#endif
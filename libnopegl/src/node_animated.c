@@ -283,7 +283,8 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
         node->cls->id == NGL_NODE_VELOCITYVEC4)
         return ngli_velocity_evaluate(node, dst, t);
 
-    if (node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
+    if (node->cls->id != NGL_NODE_ANIMATEDTIME &&
+        node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
         node->cls->id != NGL_NODE_ANIMATEDVEC2 &&
         node->cls->id != NGL_NODE_ANIMATEDVEC3 &&
         node->cls->id != NGL_NODE_ANIMATEDVEC4 &&
@@ -23,21 +23,48 @@
 #include <stddef.h>
 #include <string.h>
 #include "animation.h"
+#include "block.h"
+#include "gpu_ctx.h"
+#include "gpu_limits.h"
 #include "log.h"
 #include "math_utils.h"
 #include "memory.h"
 #include "nopegl.h"
 #include "internal.h"
+#include "pipeline_compat.h"
 #include "type.h"
 
+/* Compute shaders */
+#include "animatedbuffer_mix_comp.h"
+
+/* Always within the minimum work group limits mandated by OpenGLES 3.1 and Vulkan */
+#define MIX_GROUP_SIZE 128
+
 struct animatedbuffer_opts {
     struct ngl_node **animkf;
     size_t nb_animkf;
+    int32_t gpu_interpolation;
 };
 
 struct animatedbuffer_priv {
     struct buffer_info buf;
     struct animation anim;
+
+    /* GPU interpolation */
+    int use_gpu;
+    int32_t kf0, kf1;
+    float ratio;
+    int32_t nb_values;
+    uint32_t wg_count;
+    struct block kf_block;
+    struct block dst_block;
+    struct buffer *kf_buffer;
+    struct pgcraft *crafter;
+    struct pipeline_compat *pipeline_compat;
+    int32_t kf0_index;
+    int32_t kf1_index;
+    int32_t ratio_index;
+    int32_t nb_values_index;
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct animatedbuffer_priv, buf) == 0);
@@ -48,6 +75,10 @@ static const struct node_param animatedbuffer_params[] = {
                   .node_types=(const uint32_t[]){NGL_NODE_ANIMKEYFRAMEBUFFER, NGLI_NODE_NONE},
                   .flags=NGLI_PARAM_FLAG_DOT_DISPLAY_PACKED,
                   .desc=NGLI_DOCSTRING("key frame buffers to interpolate from")},
+    {"gpu_interpolation", NGLI_PARAM_TYPE_BOOL, OFFSET(gpu_interpolation), {.i32=0},
+                          .desc=NGLI_DOCSTRING("interpolate the key frames with a compute shader instead of the CPU; "
+                                               "the CPU data is then left untouched so the buffer must only be used "
+                                               "as a geometry or attribute buffer")},
     {NULL}
 };
 
@@ -56,16 +87,13 @@ static void mix_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_opts *kf1,
                        double ratio)
 {
-    float *dstf = dst;
     const struct animatedbuffer_priv *s = user_arg;
     const struct buffer_info *info = &s->buf;
     const float *d0 = (const float *)kf0->data;
     const float *d1 = (const float *)kf1->data;
     const struct buffer_layout *layout = &info->layout;
-    const size_t comp = layout->comp;
-    for (size_t k = 0; k < layout->count; k++)
-        for (size_t i = 0; i < comp; i++)
-            dstf[k*comp + i] = NGLI_MIX_F32(d0[k*comp + i], d1[k*comp + i], (float)ratio);
+    /* The components are tightly packed so the buffer is mixed as a flat array */
+    ngli_vec_lerp(dst, d0, d1, (float)ratio, layout->count * layout->comp);
 }
 
 static void cpy_buffer(void *user_arg, void *dst,
@@ -76,17 +104,53 @@ static void cpy_buffer(void *user_arg, void *dst,
     memcpy(dst, kf->data, info->data_size);
 }
 
-static int animatedbuffer_update(struct ngl_node *node, double t)
+/*
+ * With GPU interpolation, the animation only selects the key frames and the
+ * easing ratio; the actual mixing is done in the compute shader.
+ */
+static void mix_gpu(void *user_arg, void *dst,
+                    const struct animkeyframe_opts *kf0,
+                    const struct animkeyframe_opts *kf1,
+                    double ratio)
+{
+    struct animatedbuffer_priv *s = user_arg;
+    s->kf0 = (int32_t)s->anim.current_kf;
+    s->kf1 = s->kf0 + 1;
+    s->ratio = (float)ratio;
+}
+
+static void cpy_gpu(void *user_arg, void *dst,
+                    const struct animkeyframe_opts *kf)
+{
+    struct animatedbuffer_priv *s = user_arg;
+    const struct animkeyframe_opts *kf0 = s->anim.kfs[0]->opts;
+    s->kf0 = kf == kf0 ? 0 : (int32_t)s->anim.nb_kfs - 1;
+    s->kf1 = s->kf0;
+    s->ratio = 0.f;
+}
+
+static int animatedbuffer_update_prepare(struct ngl_node *node, double t)
 {
     struct animatedbuffer_priv *s = node->priv_data;
     struct buffer_info *info = &s->buf;
-    int ret = ngli_animation_evaluate(&s->anim, info->data, t);
-    if (ret < 0)
-        return ret;
+    return ngli_animation_evaluate(&s->anim, info->data, t);
+}
 
+static int animatedbuffer_update(struct ngl_node *node, double t)
+{
+    struct animatedbuffer_priv *s = node->priv_data;
+    struct buffer_info *info = &s->buf;
     if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD))
         return 0;
 
+    if (s->use_gpu) {
+        ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->kf0_index, &s->kf0);
+        ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->kf1_index, &s->kf1);
+        ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->ratio_index, &s->ratio);
+        ngli_pipeline_compat_dispatch(s->pipeline_compat, s->wg_count, 1, 1);
+        return 0;
+    }
+
     return ngli_buffer_upload(info->buffer, info->data, info->data_size, 0);
 }
 
@@ -98,6 +162,8 @@ static int animatedbuffer_init(struct ngl_node *node)
     struct buffer_layout *layout = &info->layout;
 
     info->flags |= NGLI_BUFFER_INFO_FLAG_DYNAMIC;
+    if (o->gpu_interpolation)
+        info->flags |= NGLI_BUFFER_INFO_FLAG_GPU_ONLY;
     info->usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT | NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
     layout->comp = ngli_format_get_nb_comp(layout->format);
     layout->stride = ngli_format_get_bytes_per_pixel(layout->format);
@@ -142,21 +208,184 @@ static int animatedbuffer_init(struct ngl_node *node)
     return 0;
 }
 
+static int init_gpu_block(struct block *block)
+{
+    ngli_block_init(block, NGLI_BLOCK_LAYOUT_STD430);
+    /* The components are tightly packed so the buffers are exposed as flat arrays */
+    return ngli_block_add_field(block, "data", NGLI_TYPE_F32, NGLI_BLOCK_VARIADIC_COUNT);
+}
+
+static int upload_keyframes(struct ngl_node *node)
+{
+    struct animatedbuffer_priv *s = node->priv_data;
+    const struct animatedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+
+    s->kf_buffer = ngli_buffer_create(node->ctx->gpu_ctx);
+    if (!s->kf_buffer)
+        return NGL_ERROR_MEMORY;
+
+    const int usage = NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT | NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
+    int ret = ngli_buffer_init(s->kf_buffer, o->nb_animkf * info->data_size, usage);
+    if (ret < 0)
+        return ret;
+
+    /* Key frames may have trailing bytes so they are uploaded one by one */
+    for (size_t i = 0; i < o->nb_animkf; i++) {
+        const struct animkeyframe_opts *kf = o->animkf[i]->opts;
+        ret = ngli_buffer_upload(s->kf_buffer, kf->data, info->data_size, i * info->data_size);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int init_gpu_interpolation(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct animatedbuffer_priv *s = node->priv_data;
+    const struct animatedbuffer_opts *o = node->opts;
+    struct buffer_info *info = &s->buf;
+    const struct buffer_layout *layout = &info->layout;
+
+    s->nb_values = (int32_t)(layout->count * layout->comp);
+    s->wg_count = (uint32_t)NGLI_ALIGN((size_t)s->nb_values, MIX_GROUP_SIZE) / MIX_GROUP_SIZE;
+
+    int ret;
+    if ((ret = init_gpu_block(&s->kf_block)) < 0 ||
+        (ret = init_gpu_block(&s->dst_block)) < 0 ||
+        (ret = upload_keyframes(node)) < 0)
+        return ret;
+
+    s->crafter = ngli_pgcraft_create(ctx);
+    s->pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
+    if (!s->crafter || !s->pipeline_compat)
+        return NGL_ERROR_MEMORY;
+
+    const struct pgcraft_uniform uniforms[] = {
+        {.name="kf0",       .type=NGLI_TYPE_I32, .stage=NGLI_PROGRAM_SHADER_COMP},
+        {.name="kf1",       .type=NGLI_TYPE_I32, .stage=NGLI_PROGRAM_SHADER_COMP},
+        {.name="ratio",     .type=NGLI_TYPE_F32, .stage=NGLI_PROGRAM_SHADER_COMP},
+        {.name="nb_values", .type=NGLI_TYPE_I32, .stage=NGLI_PROGRAM_SHADER_COMP},
+    };
+
+    const struct pgcraft_block blocks[] = {
+        {
+            .name   = "keyframes",
+            .type   = NGLI_TYPE_STORAGE_BUFFER,
+            .stage  = NGLI_PROGRAM_SHADER_COMP,
+            .block  = &s->kf_block,
+            .buffer = s->kf_buffer,
+        }, {
+            .name     = "dst",
+            .type     = NGLI_TYPE_STORAGE_BUFFER,
+            .stage    = NGLI_PROGRAM_SHADER_COMP,
+            .writable = 1,
+            .block    = &s->dst_block,
+            .buffer   = info->buffer,
+        },
+    };
+
+    const struct pgcraft_params crafter_params = {
+        .comp_base      = animatedbuffer_mix_comp,
+        .uniforms       = uniforms,
+        .nb_uniforms    = NGLI_ARRAY_NB(uniforms),
+        .blocks         = blocks,
+        .nb_blocks      = NGLI_ARRAY_NB(blocks),
+        .workgroup_size = {MIX_GROUP_SIZE, 1, 1},
+    };
+
+    ret = ngli_pgcraft_craft(s->crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    const struct pipeline_params pipeline_params = {
+        .type    = NGLI_PIPELINE_TYPE_COMPUTE,
+        .program = ngli_pgcraft_get_program(s->crafter),
+        .layout  = ngli_pgcraft_get_pipeline_layout(s->crafter),
+    };
+
+    const struct pipeline_resources pipeline_resources = ngli_pgcraft_get_pipeline_resources(s->crafter);
+    const struct pgcraft_compat_info *compat_info = ngli_pgcraft_get_compat_info(s->crafter);
+
+    const struct pipeline_compat_params params = {
+        .params      = &pipeline_params,
+        .resources   = &pipeline_resources,
+        .compat_info = compat_info,
+    };
+
+    ret = ngli_pipeline_compat_init(s->pipeline_compat, &params);
+    if (ret < 0)
+        return ret;
+
+    s->kf0_index       = ngli_pgcraft_get_uniform_index(s->crafter, "kf0",       NGLI_PROGRAM_SHADER_COMP);
+    s->kf1_index       = ngli_pgcraft_get_uniform_index(s->crafter, "kf1",       NGLI_PROGRAM_SHADER_COMP);
+    s->ratio_index     = ngli_pgcraft_get_uniform_index(s->crafter, "ratio",     NGLI_PROGRAM_SHADER_COMP);
+    s->nb_values_index = ngli_pgcraft_get_uniform_index(s->crafter, "nb_values", NGLI_PROGRAM_SHADER_COMP);
+    ngli_pipeline_compat_update_uniform(s->pipeline_compat, s->nb_values_index, &s->nb_values);
+
+    /* From now on, the animation only selects the key frames to mix */
+    return ngli_animation_init(&s->anim, s, o->animkf, o->nb_animkf, mix_gpu, cpy_gpu);
+}
+
+static int can_use_gpu_interpolation(struct ngl_node *node)
+{
+    const struct animatedbuffer_opts *o = node->opts;
+    if (!o->gpu_interpolation)
+        return 0;
+
+    const struct gpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+    if (!(gpu_ctx->features & NGLI_FEATURE_COMPUTE)) {
+        LOG(WARNING, "compute shaders are not supported by this context, "
+            "falling back on CPU interpolation");
+        return 0;
+    }
+
+    const struct animatedbuffer_priv *s = node->priv_data;
+    const struct buffer_layout *layout = &s->buf.layout;
+    const size_t wg_count = NGLI_ALIGN(layout->count * layout->comp, MIX_GROUP_SIZE) / MIX_GROUP_SIZE;
+    if (wg_count > gpu_ctx->limits.max_compute_work_group_count[0]) {
+        LOG(WARNING, "buffer is too large to be interpolated by the GPU, "
+            "falling back on CPU interpolation");
+        return 0;
+    }
+
+    return 1;
+}
+
 static int animatedbuffer_prepare(struct ngl_node *node)
 {
     struct animatedbuffer_priv *s = node->priv_data;
     struct buffer_info *info = &s->buf;
 
-    if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD))
+    if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD)) {
+        if (info->flags & NGLI_BUFFER_INFO_FLAG_GPU_ONLY) {
+            LOG(ERROR, "%s: GPU interpolation requires the buffer to be used as a geometry or attribute buffer",
+                node->label);
+            return NGL_ERROR_INVALID_USAGE;
+        }
         return ngli_node_prepare_children(node);
+    }
 
     if (info->buffer->size)
         return 0;
 
+    s->use_gpu = can_use_gpu_interpolation(node);
+    if (s->use_gpu)
+        info->usage |= NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
     int ret = ngli_buffer_init(info->buffer, info->data_size, info->usage);
     if (ret < 0)
         return ret;
 
+    if (s->use_gpu) {
+        ret = init_gpu_interpolation(node);
+        if (ret < 0)
+            return ret;
+    }
+
     return ngli_node_prepare_children(node);
 }
 
@@ -165,6 +394,11 @@ static void animatedbuffer_uninit(struct ngl_node *node)
     struct animatedbuffer_priv *s = node->priv_data;
     struct buffer_info *info = &s->buf;
 
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_pipeline_compat_freep(&s->pipeline_compat);
+    ngli_buffer_freep(&s->kf_buffer);
+    ngli_block_reset(&s->kf_block);
+    ngli_block_reset(&s->dst_block);
     ngli_buffer_freep(&info->buffer);
     ngli_freep(&info->data);
 }
@@ -185,6 +419,7 @@ const struct node_class ngli_animatedbuffer##type_name##_class = {
     .name      = class_name,                                                       \
     .init      = animatedbuffer##type_name##_init,                                 \
     .prepare   = animatedbuffer_prepare,                                           \
+    .update_prepare = animatedbuffer_update_prepare,                               \
     .update    = animatedbuffer_update,                                            \
     .uninit    = animatedbuffer_uninit,                                            \
     .opts_size = sizeof(struct animatedbuffer_opts),                               \
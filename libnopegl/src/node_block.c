@@ -295,6 +295,10 @@ static int block_init(struct ngl_node *node)
                 LOG(ERROR, "buffers used as a block field referencing a block are not supported");
                 return NGL_ERROR_UNSUPPORTED;
             }
+
+            int ret = ngli_node_buffer_check_cpu_usage(field_node);
+            if (ret < 0)
+                return ret;
         }
 
         const int type  = get_node_data_type(field_node);
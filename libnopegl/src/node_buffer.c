@@ -28,6 +28,7 @@
 #include <sys/stat.h>
 
 #include "buffer.h"
+#include "filemap.h"
 #include "log.h"
 #include "memory.h"
 #include "nopegl.h"
@@ -46,7 +47,7 @@ struct buffer_opts {
 
 struct buffer_priv {
     struct buffer_info buf;
-    FILE *fp;
+    struct filemap filemap;
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct buffer_priv, buf) == 0);
@@ -90,6 +91,24 @@ size_t ngli_node_buffer_get_gpu_size(struct ngl_node *node)
     return s->block || !(s->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD) ? 0 : s->data_size;
 }
 
+int ngli_node_buffer_check_cpu_usage(const struct ngl_node *node)
+{
+    const struct buffer_info *s = node->priv_data;
+    if (s->flags & NGLI_BUFFER_INFO_FLAG_GPU_ONLY) {
+        LOG(ERROR, "%s is only updated on the GPU and can not be used as CPU data "
+            "(block field, uniform or texture data source)", node->label);
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    return 0;
+}
+
+void ngli_node_buffer_prefetch(struct ngl_node *node, size_t offset, size_t size)
+{
+    struct buffer_priv *s = node->priv_data;
+    if (s->filemap.data)
+        ngli_filemap_prefetch(&s->filemap, offset, size);
+}
+
 static int buffer_init_from_data(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
@@ -117,17 +136,22 @@ static int buffer_init_from_filename(struct ngl_node *node)
     const struct buffer_opts *o = node->opts;
     struct buffer_layout *layout = &s->buf.layout;
 
-    int64_t size;
-    int ret = ngli_get_filesize(o->filename, &size);
+    /*
+     * The file is memory mapped instead of being read entirely: pages are
+     * only loaded when accessed, which allows streaming large files through
+     * a StreamedBuffer* node without ever holding them in memory.
+     */
+    int ret = ngli_filemap_open(&s->filemap, o->filename);
     if (ret < 0)
         return ret;
 
-    if (size > SIZE_MAX) {
-        LOG(ERROR, "'%s' size (%" PRId64 ") exceeds supported limit (%zu)", o->filename, size, SIZE_MAX);
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
-    s->buf.data_size = (size_t)size;
+    /*
+     * The mapping is read-only: writing to it would fault, so the buffer is
+     * flagged as such and every writable usage of its data is rejected.
+     */
+    s->buf.data = (uint8_t *)s->filemap.data;
+    s->buf.data_size = s->filemap.size;
+    s->buf.flags |= NGLI_BUFFER_INFO_FLAG_READ_ONLY;
     layout->count = layout->count ? layout->count : s->buf.data_size / layout->stride;
 
     if (s->buf.data_size != layout->count * layout->stride) {
@@ -139,27 +163,6 @@ static int buffer_init_from_filename(struct ngl_node *node)
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->buf.data = ngli_calloc(layout->count, layout->stride);
-    if (!s->buf.data)
-        return NGL_ERROR_MEMORY;
-
-    s->fp = fopen(o->filename, "rb");
-    if (!s->fp) {
-        LOG(ERROR, "could not open '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    size_t n = fread(s->buf.data, 1, s->buf.data_size, s->fp);
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "could not read '%s'", o->filename);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->buf.data_size) {
-        LOG(ERROR, "read %zu bytes does not match expected size of %zu bytes", n, s->buf.data_size);
-        return NGL_ERROR_IO;
-    }
-
     return 0;
 }
 
@@ -324,18 +327,12 @@ static void buffer_uninit(struct ngl_node *node)
     else
         ngli_buffer_freep(&s->buf.buffer);
 
-    if (!o->data && !o->block)
-        ngli_freep(&s->buf.data);
-
     if (o->filename) {
+        ngli_filemap_close(&s->filemap);
+        s->buf.data = NULL;
         s->buf.data_size = 0;
-
-        if (s->fp) {
-            int ret = fclose(s->fp);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", o->filename);
-            }
-        }
+    } else if (!o->data && !o->block) {
+        ngli_freep(&s->buf.data);
     }
 }
 
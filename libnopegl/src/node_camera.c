@@ -266,12 +266,29 @@ static void camera_draw(struct ngl_node *node)
     ngli_darray_pop(&ctx->projection_matrix_stack);
 }
 
+static int camera_record(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct camera_priv *s = node->priv_data;
+    struct camera_opts *o = node->opts;
+
+    int ret = ngli_drawlist_push_camera(drawlist, node, s->modelview_matrix, s->projection_matrix);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_node_record(o->child, drawlist);
+    if (ret < 0)
+        return ret;
+
+    return ngli_drawlist_pop(drawlist);
+}
+
 const struct node_class ngli_camera_class = {
     .id        = NGL_NODE_CAMERA,
     .name      = "Camera",
     .init      = camera_init,
     .update    = camera_update,
     .draw      = camera_draw,
+    .record    = camera_record,
     .opts_size = sizeof(struct camera_opts),
     .priv_size = sizeof(struct camera_priv),
     .params    = camera_params,
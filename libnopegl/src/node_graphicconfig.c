@@ -315,6 +315,22 @@ static void graphicconfig_draw(struct ngl_node *node)
         ngli_gpu_ctx_set_scissor(gpu_ctx, &prev_scissor);
 }
 
+static int graphicconfig_record(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct graphicconfig_priv *s = node->priv_data;
+    const struct graphicconfig_opts *o = node->opts;
+
+    int ret = ngli_drawlist_push_scissor(drawlist, node, s->use_scissor ? o->scissor : NULL);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_node_record(o->child, drawlist);
+    if (ret < 0)
+        return ret;
+
+    return ngli_drawlist_pop(drawlist);
+}
+
 const struct node_class ngli_graphicconfig_class = {
     .id        = NGL_NODE_GRAPHICCONFIG,
     .name      = "GraphicConfig",
@@ -322,6 +338,7 @@ const struct node_class ngli_graphicconfig_class = {
     .prepare   = graphicconfig_prepare,
     .update    = ngli_node_update_children,
     .draw      = graphicconfig_draw,
+    .record    = graphicconfig_record,
     .opts_size = sizeof(struct graphicconfig_opts),
     .priv_size = sizeof(struct graphicconfig_priv),
     .params    = graphicconfig_params,
@@ -22,21 +22,96 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include "darray.h"
 #include "nopegl.h"
 #include "internal.h"
+#include "log.h"
 
 struct group_opts {
     struct ngl_node **children;
     size_t nb_children;
+    int batch;
+};
+
+struct group_batch {
+    size_t start;
+    size_t count;
+    struct render_batch *render_batch;
+};
+
+struct group_priv {
+    struct darray batches_per_rnode; // struct darray of struct group_batch
 };
 
 #define OFFSET(x) offsetof(struct group_opts, x)
 static const struct node_param group_params[] = {
     {"children", NGLI_PARAM_TYPE_NODELIST, OFFSET(children),
                  .desc=NGLI_DOCSTRING("a set of scenes")},
+    {"batch",    NGLI_PARAM_TYPE_BOOL, OFFSET(batch),
+                 .desc=NGLI_DOCSTRING("merge consecutive children rendering a `RenderColor` or a `RenderTexture` "
+                                      "(optionally through a transformation chain) into instanced draw calls "
+                                      "whenever they are compatible")},
     {NULL}
 };
 
+static int group_init(struct ngl_node *node)
+{
+    struct group_priv *s = node->priv_data;
+    ngli_darray_init(&s->batches_per_rnode, sizeof(struct darray), 0);
+    return 0;
+}
+
+static int prepare_batches(struct ngl_node *node, struct darray *batches)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct group_opts *o = node->opts;
+
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+
+    size_t i = 0;
+    while (i < o->nb_children) {
+        const struct ngl_node *leaf = ngli_render_batch_get_leaf(o->children[i]);
+        size_t j = i + 1;
+        if (leaf) {
+            while (j < o->nb_children) {
+                const struct ngl_node *next_leaf = ngli_render_batch_get_leaf(o->children[j]);
+                if (!next_leaf || !ngli_render_batch_is_compatible(leaf, next_leaf))
+                    break;
+                j++;
+            }
+        }
+
+        const size_t count = j - i;
+        if (count < 2) {
+            i = j;
+            continue;
+        }
+
+        struct group_batch *batch = ngli_darray_push(batches, NULL);
+        if (!batch)
+            return NGL_ERROR_MEMORY;
+        *batch = (struct group_batch){.start = i, .count = count};
+
+        batch->render_batch = ngli_render_batch_create(ctx);
+        if (!batch->render_batch)
+            return NGL_ERROR_MEMORY;
+
+        /* Transformation chains do not alter the render state so the first
+         * child render node is representative of the whole batch */
+        ctx->rnode_pos = &rnodes[i];
+        int ret = ngli_render_batch_init(batch->render_batch, &o->children[i], count);
+        ctx->rnode_pos = rnode_pos;
+        if (ret < 0)
+            return ret;
+
+        LOG(DEBUG, "batching %zu draws starting at child %zu of %s", count, i, node->label);
+        i = j;
+    }
+
+    return 0;
+}
+
 static int group_prepare(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -58,31 +133,97 @@ static int group_prepare(struct ngl_node *node)
 
 done:
     ctx->rnode_pos = rnode_pos;
-    return ret;
+    if (ret < 0 || !o->batch)
+        return ret;
+
+    struct group_priv *s = node->priv_data;
+    struct darray *batches = ngli_darray_push(&s->batches_per_rnode, NULL);
+    if (!batches)
+        return NGL_ERROR_MEMORY;
+    ngli_darray_init(batches, sizeof(struct group_batch), 0);
+    rnode_pos->id = ngli_darray_count(&s->batches_per_rnode) - 1;
+
+    return prepare_batches(node, batches);
 }
 
 static void group_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
+    struct group_priv *s = node->priv_data;
     const struct group_opts *o = node->opts;
 
     struct rnode *rnode_pos = ctx->rnode_pos;
     struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+
+    const struct group_batch *batches = NULL;
+    size_t nb_batches = 0;
+    if (o->batch) {
+        struct darray *batches_array = ngli_darray_get(&s->batches_per_rnode, rnode_pos->id);
+        batches = ngli_darray_data(batches_array);
+        nb_batches = ngli_darray_count(batches_array);
+    }
+
+    size_t batch_id = 0;
     for (size_t i = 0; i < o->nb_children; i++) {
         ctx->rnode_pos = &rnodes[i];
+        if (batch_id < nb_batches && batches[batch_id].start == i) {
+            const struct group_batch *batch = &batches[batch_id++];
+            ngli_render_batch_draw(batch->render_batch);
+            i += batch->count - 1;
+            continue;
+        }
         struct ngl_node *child = o->children[i];
         ngli_node_draw(child);
     }
     ctx->rnode_pos = rnode_pos;
 }
 
+static int group_record(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct group_opts *o = node->opts;
+
+    /* The batches are drawn as a whole by the group */
+    if (o->batch)
+        return ngli_drawlist_add_draw(drawlist, node);
+
+    int ret = 0;
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+    for (size_t i = 0; i < o->nb_children; i++) {
+        ctx->rnode_pos = &rnodes[i];
+        ret = ngli_node_record(o->children[i], drawlist);
+        if (ret < 0)
+            break;
+    }
+    ctx->rnode_pos = rnode_pos;
+    return ret;
+}
+
+static void group_uninit(struct ngl_node *node)
+{
+    struct group_priv *s = node->priv_data;
+    struct darray *batches_arrays = ngli_darray_data(&s->batches_per_rnode);
+    for (size_t i = 0; i < ngli_darray_count(&s->batches_per_rnode); i++) {
+        struct group_batch *batches = ngli_darray_data(&batches_arrays[i]);
+        for (size_t j = 0; j < ngli_darray_count(&batches_arrays[i]); j++)
+            ngli_render_batch_freep(&batches[j].render_batch);
+        ngli_darray_reset(&batches_arrays[i]);
+    }
+    ngli_darray_reset(&s->batches_per_rnode);
+}
+
 const struct node_class ngli_group_class = {
     .id        = NGL_NODE_GROUP,
     .name      = "Group",
+    .init      = group_init,
     .prepare   = group_prepare,
     .update    = ngli_node_update_children,
     .draw      = group_draw,
+    .record    = group_record,
+    .uninit    = group_uninit,
     .opts_size = sizeof(struct group_opts),
+    .priv_size = sizeof(struct group_priv),
     .params    = group_params,
     .file      = __FILE__,
 };
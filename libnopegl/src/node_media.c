@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -32,6 +33,7 @@
 #endif
 
 #include "log.h"
+#include "mediaqueue.h"
 #include "memory.h"
 #include "nopegl.h"
 #include "internal.h"
@@ -54,6 +56,7 @@ struct media_opts {
     int hwaccel;
     char *filters;
     char *vt_pix_fmt;
+    int32_t prefetch_frames;
 };
 
 static const struct param_choices nopemd_log_level_choices = {
@@ -80,6 +83,8 @@ static const struct param_choices nopemd_hwaccel_choices = {
     }
 };
 
+#define MAX_PREFETCH_FRAMES 64
+
 #define OFFSET(x) offsetof(struct media_opts, x)
 static const struct node_param media_params[] = {
     {"filename", NGLI_PARAM_TYPE_STR, OFFSET(filename), {.str=NULL}, NGLI_PARAM_FLAG_NON_NULL,
@@ -109,6 +114,9 @@ static const struct node_param media_params[] = {
                        .desc=NGLI_DOCSTRING("filters to apply on the media (nope.media/libavfilter)")},
     {"vt_pix_fmt",     NGLI_PARAM_TYPE_STR, OFFSET(vt_pix_fmt),  {.str="auto"},
                        .desc=NGLI_DOCSTRING("auto or a comma or space separated list of VideoToolbox (Apple) allowed output pixel formats")},
+    {"prefetch_frames", NGLI_PARAM_TYPE_I32, OFFSET(prefetch_frames), {.i32=0},
+                        .desc=NGLI_DOCSTRING("number of frames to retrieve ahead of time on a dedicated thread, "
+                                             "following the upcoming draw times announced with `ngl_hint_timeline()`")},
     {NULL}
 };
 
@@ -220,6 +228,17 @@ static int media_init(struct ngl_node *node)
     nmd_set_option(s->player, "vt_pix_fmt", vt_pix_fmt);
 #endif
 
+    if (o->prefetch_frames < 0 || o->prefetch_frames > MAX_PREFETCH_FRAMES) {
+        LOG(ERROR, "the number of prefetched frames must be in [0,%d]", MAX_PREFETCH_FRAMES);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (o->prefetch_frames) {
+        s->queue = ngli_mediaqueue_create(s->player, o->prefetch_frames);
+        if (!s->queue)
+            return NGL_ERROR_MEMORY;
+    }
+
     if (o->audio_tex) {
         nmd_set_option(s->player, "avselect", NMD_SELECT_AUDIO);
         nmd_set_option(s->player, "audio_texture", 1);
@@ -291,6 +310,48 @@ static const char * const pix_fmt_names[] = {
     [NMD_PIXFMT_YUV444P10LE] = "yuv444p10le",
 };
 
+static double get_initial_seek(const struct ngl_node *anim_node)
+{
+    const struct variable_opts *anim_o = anim_node->opts;
+    const struct animkeyframe_opts *kf0 = anim_o->animkf[0]->opts;
+    return kf0->scalar;
+}
+
+/*
+ * Compute the media times of the upcoming draws following t, according to the
+ * timeline hint of the context.
+ */
+static int get_next_media_times(struct ngl_node *node, double t, double *times, size_t *nb_timesp)
+{
+    const struct ngl_ctx *ctx = node->ctx;
+    const struct media_opts *o = node->opts;
+
+    *nb_timesp = 0;
+    if (!ctx->hint_nb_frames)
+        return 0;
+
+    const double pos = (t - ctx->hint_t0) / ctx->hint_dt;
+    const double index = round(pos);
+    if (index < 0. || index >= ctx->hint_nb_frames || ctx->hint_t0 + index * ctx->hint_dt != t)
+        return 0;
+
+    size_t nb_times = 0;
+    for (int32_t i = 1; i <= o->prefetch_frames && index + i < ctx->hint_nb_frames; i++) {
+        const double next_t = ctx->hint_t0 + (index + i) * ctx->hint_dt;
+        double media_time = next_t;
+        if (o->anim) {
+            double dval;
+            int ret = ngl_anim_evaluate(o->anim, &dval, next_t);
+            if (ret < 0)
+                return ret;
+            media_time = NGLI_MAX(0, dval - get_initial_seek(o->anim));
+        }
+        times[nb_times++] = media_time;
+    }
+    *nb_timesp = nb_times;
+    return 0;
+}
+
 static int media_update(struct ngl_node *node, double t)
 {
     struct media_priv *s = node->priv_data;
@@ -300,9 +361,7 @@ static int media_update(struct ngl_node *node, double t)
 
     if (anim_node) {
         struct variable_info *anim = anim_node->priv_data;
-        const struct variable_opts *anim_o = anim_node->opts;
-        const struct animkeyframe_opts *kf0 = anim_o->animkf[0]->opts;
-        const double initial_seek = kf0->scalar;
+        const double initial_seek = get_initial_seek(anim_node);
         int ret = ngli_node_update(anim_node, t);
         if (ret < 0)
             return ret;
@@ -313,9 +372,20 @@ static int media_update(struct ngl_node *node, double t)
     }
 
     nmd_release_frame(s->frame);
+    s->frame = NULL;
 
     TRACE("get frame from %s at t=%g", node->label, media_time);
-    struct nmd_frame *frame = nmd_get_frame(s->player, media_time);
+    struct nmd_frame *frame;
+    if (s->queue) {
+        double next_times[MAX_PREFETCH_FRAMES];
+        size_t nb_next_times;
+        int ret = get_next_media_times(node, t, next_times, &nb_next_times);
+        if (ret < 0)
+            return ret;
+        frame = ngli_mediaqueue_get_frame(s->queue, media_time, next_times, nb_next_times);
+    } else {
+        frame = nmd_get_frame(s->player, media_time);
+    }
     if (frame) {
         const char *pix_fmt_str = frame->pix_fmt >= 0 &&
                                   frame->pix_fmt < NGLI_ARRAY_NB(pix_fmt_names) ? pix_fmt_names[frame->pix_fmt]
@@ -343,12 +413,15 @@ static void media_release(struct ngl_node *node)
     struct media_priv *s = node->priv_data;
     nmd_release_frame(s->frame);
     s->frame = NULL;
+    if (s->queue)
+        ngli_mediaqueue_flush(s->queue);
     nmd_stop(s->player);
 }
 
 static void media_uninit(struct ngl_node *node)
 {
     struct media_priv *s = node->priv_data;
+    ngli_mediaqueue_freep(&s->queue);
     nmd_free(&s->player);
 
 #if defined(TARGET_ANDROID)
@@ -75,7 +75,7 @@ static const struct node_param noise_params[] = {
 
 NGLI_STATIC_ASSERT(variable_info_is_first, offsetof(struct noise_priv, var) == 0);
 
-static int noisevec_update(struct ngl_node *node, double t, int n)
+static int noisevec_update_prepare(struct ngl_node *node, double t, int n)
 {
     struct noise_priv *s = node->priv_data;
     const struct noise_opts *o = node->opts;
@@ -85,24 +85,24 @@ static int noisevec_update(struct ngl_node *node, double t, int n)
     return 0;
 }
 
-static int noisefloat_update(struct ngl_node *node, double t)
+static int noisefloat_update_prepare(struct ngl_node *node, double t)
 {
-    return noisevec_update(node, t, 1);
+    return noisevec_update_prepare(node, t, 1);
 }
 
-static int noisevec2_update(struct ngl_node *node, double t)
+static int noisevec2_update_prepare(struct ngl_node *node, double t)
 {
-    return noisevec_update(node, t, 2);
+    return noisevec_update_prepare(node, t, 2);
 }
 
-static int noisevec3_update(struct ngl_node *node, double t)
+static int noisevec3_update_prepare(struct ngl_node *node, double t)
 {
-    return noisevec_update(node, t, 3);
+    return noisevec_update_prepare(node, t, 3);
 }
 
-static int noisevec4_update(struct ngl_node *node, double t)
+static int noisevec4_update_prepare(struct ngl_node *node, double t)
 {
-    return noisevec_update(node, t, 4);
+    return noisevec_update_prepare(node, t, 4);
 }
 
 static int init_noise_generators(struct noise_priv *s, const struct noise_opts *o, int n)
@@ -142,7 +142,7 @@ const struct node_class ngli_noise##type##_class = {                        \
     .category  = NGLI_NODE_CATEGORY_VARIABLE,                               \
     .name      = class_name,                                                \
     .init      = noise##type##_init,                                        \
-    .update    = noise##type##_update,                                      \
+    .update_prepare = noise##type##_update_prepare,                         \
     .opts_size = sizeof(struct noise_opts),                                 \
     .priv_size = sizeof(struct noise_priv),                                 \
     .params    = noise_params,                                              \
@@ -30,6 +30,7 @@
 #include "gpu_ctx.h"
 #include "internal.h"
 #include "log.h"
+#include "math_utils.h"
 #include "memory.h"
 #include "pgcraft.h"
 #include "pipeline_compat.h"
@@ -40,6 +41,7 @@
 /* GLSL fragments as string */
 #include "source_color_frag.h"
 #include "source_color_vert.h"
+#include "source_color_batch_vert.h"
 #include "source_displace_frag.h"
 #include "source_displace_vert.h"
 #include "source_gradient_frag.h"
@@ -1013,6 +1015,26 @@ static int renderhistogram_prepare(struct ngl_node *node)
     return 0;
 }
 
+static struct pgcraft_texture get_rendertexture_source(struct ngl_node *texture_node)
+{
+    struct texture_priv *texture_priv = texture_node->priv_data;
+    const struct texture_opts *texture_opts = texture_node->opts;
+    struct pgcraft_texture texture = {
+        .name        = "tex",
+        .stage       = NGLI_PROGRAM_SHADER_FRAG,
+        .image       = &texture_priv->image,
+        .format      = texture_priv->params.format,
+        .clamp_video = texture_opts->clamp_video,
+    };
+
+    if (texture_opts->data_src && texture_opts->data_src->cls->id == NGL_NODE_MEDIA)
+        texture.type = NGLI_PGCRAFT_SHADER_TEX_TYPE_VIDEO;
+    else
+        texture.type = NGLI_PGCRAFT_SHADER_TEX_TYPE_2D;
+
+    return texture;
+}
+
 static int rendertexture_prepare(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -1029,22 +1051,7 @@ static int rendertexture_prepare(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
-    struct texture_priv *texture_priv = o->texture_node->priv_data;
-    const struct texture_opts *texture_opts = o->texture_node->opts;
-    struct pgcraft_texture textures[] = {
-        {
-            .name        = "tex",
-            .stage       = NGLI_PROGRAM_SHADER_FRAG,
-            .image       = &texture_priv->image,
-            .format      = texture_priv->params.format,
-            .clamp_video = texture_opts->clamp_video,
-        },
-    };
-
-    if (texture_opts->data_src && texture_opts->data_src->cls->id == NGL_NODE_MEDIA)
-        textures[0].type = NGLI_PGCRAFT_SHADER_TEX_TYPE_VIDEO;
-    else
-        textures[0].type = NGLI_PGCRAFT_SHADER_TEX_TYPE_2D;
+    const struct pgcraft_texture textures[] = {get_rendertexture_source(o->texture_node)};
 
     static const struct pgcraft_iovar vert_out_vars[] = {
         {.name = "uv",        .type = NGLI_TYPE_VEC2},
@@ -1204,6 +1211,352 @@ static void renderother_uninit(struct ngl_node *node, struct render_common *s)
     ngli_darray_reset(&s->draw_resources);
 }
 
+static const struct render_common_opts *get_common_opts(const struct ngl_node *node)
+{
+    switch (node->cls->id) {
+    case NGL_NODE_RENDERCOLOR:   return &((const struct rendercolor_opts *)node->opts)->common;
+    case NGL_NODE_RENDERTEXTURE: return &((const struct rendertexture_opts *)node->opts)->common;
+    default:                     return NULL;
+    }
+}
+
+static struct render_common *get_common_priv(const struct ngl_node *node)
+{
+    switch (node->cls->id) {
+    case NGL_NODE_RENDERCOLOR:   return &((struct rendercolor_priv *)node->priv_data)->common;
+    case NGL_NODE_RENDERTEXTURE: return &((struct rendertexture_priv *)node->priv_data)->common;
+    default:                     return NULL;
+    }
+}
+
+struct ngl_node *ngli_render_batch_get_leaf(struct ngl_node *node)
+{
+    while (node) {
+        switch (node->cls->id) {
+        case NGL_NODE_ROTATE:
+        case NGL_NODE_ROTATEQUAT:
+        case NGL_NODE_SCALE:
+        case NGL_NODE_SKEW:
+        case NGL_NODE_TRANSFORM:
+        case NGL_NODE_TRANSLATE: {
+            const struct transform *trf = node->priv_data;
+            node = trf->child;
+            break;
+        }
+        case NGL_NODE_RENDERCOLOR:
+        case NGL_NODE_RENDERTEXTURE: {
+            /* Filters may carry their own uniforms, which are not instanced */
+            const struct render_common_opts *o = get_common_opts(node);
+            return o->nb_filters ? NULL : node;
+        }
+        default:
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+int ngli_render_batch_is_compatible(const struct ngl_node *leaf_a, const struct ngl_node *leaf_b)
+{
+    if (leaf_a->cls->id != leaf_b->cls->id)
+        return 0;
+
+    const struct render_common_opts *o_a = get_common_opts(leaf_a);
+    const struct render_common_opts *o_b = get_common_opts(leaf_b);
+    if (o_a->blending != o_b->blending || o_a->geometry != o_b->geometry)
+        return 0;
+
+    if (leaf_a->cls->id == NGL_NODE_RENDERTEXTURE) {
+        const struct rendertexture_opts *to_a = leaf_a->opts;
+        const struct rendertexture_opts *to_b = leaf_b->opts;
+        return to_a->texture_node == to_b->texture_node;
+    }
+
+    return 1;
+}
+
+/*
+ * Per instance data, must match the instanced attributes declared in
+ * ngli_render_batch_init()
+ */
+struct instance_color {
+    float modelview_matrix[4 * 4];
+    float color[3];
+    float opacity;
+};
+
+struct instance_texture {
+    float modelview_matrix[4 * 4];
+};
+
+struct render_batch {
+    struct ngl_ctx *ctx;
+    struct ngl_node **children;
+    struct ngl_node **leaves;
+    size_t nb_instances;
+    size_t instance_size;
+    uint8_t *instances_data;
+    int instances_uploaded;
+    struct buffer *instances;
+    struct pgcraft *crafter;
+    struct pipeline_compat *pipeline_compat;
+    int32_t projection_matrix_index;
+};
+
+struct render_batch *ngli_render_batch_create(struct ngl_ctx *ctx)
+{
+    struct render_batch *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    return s;
+}
+
+int ngli_render_batch_init(struct render_batch *s, struct ngl_node **children, size_t nb_children)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    struct rnode *rnode = ctx->rnode_pos;
+
+    s->children = ngli_calloc(nb_children, sizeof(*s->children));
+    s->leaves = ngli_calloc(nb_children, sizeof(*s->leaves));
+    if (!s->children || !s->leaves)
+        return NGL_ERROR_MEMORY;
+    for (size_t i = 0; i < nb_children; i++) {
+        s->children[i] = children[i];
+        s->leaves[i] = ngli_render_batch_get_leaf(children[i]);
+        ngli_assert(s->leaves[i]);
+    }
+    s->nb_instances = nb_children;
+
+    const struct ngl_node *leaf = s->leaves[0];
+    const struct render_common *c = get_common_priv(leaf);
+    const struct render_common_opts *co = get_common_opts(leaf);
+    const int is_texture = leaf->cls->id == NGL_NODE_RENDERTEXTURE;
+
+    s->instance_size = is_texture ? sizeof(struct instance_texture) : sizeof(struct instance_color);
+    s->instances_data = ngli_calloc(s->nb_instances, s->instance_size);
+    s->instances = ngli_buffer_create(gpu_ctx);
+    if (!s->instances_data || !s->instances)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_buffer_init(s->instances, s->nb_instances * s->instance_size,
+                               NGLI_BUFFER_USAGE_DYNAMIC_BIT | VERTEX_USAGE_FLAGS);
+    if (ret < 0)
+        return ret;
+
+    static const struct pgcraft_uniform uniforms[] = {
+        {.name="projection_matrix", .type=NGLI_TYPE_MAT4, .stage=NGLI_PROGRAM_SHADER_VERT},
+    };
+
+    const struct pgcraft_attribute attributes[] = {
+        c->position_attr,
+        c->uvcoord_attr,
+        {
+            .name   = "modelview_matrix",
+            .type   = NGLI_TYPE_MAT4,
+            .format = NGLI_FORMAT_R32G32B32A32_SFLOAT,
+            .stride = s->instance_size,
+            .offset = offsetof(struct instance_color, modelview_matrix),
+            .buffer = s->instances,
+            .rate   = 1,
+        }, {
+            .name   = "instance_color",
+            .type   = NGLI_TYPE_VEC3,
+            .format = NGLI_FORMAT_R32G32B32_SFLOAT,
+            .stride = s->instance_size,
+            .offset = offsetof(struct instance_color, color),
+            .buffer = s->instances,
+            .rate   = 1,
+        }, {
+            .name   = "instance_opacity",
+            .type   = NGLI_TYPE_F32,
+            .format = NGLI_FORMAT_R32_SFLOAT,
+            .stride = s->instance_size,
+            .offset = offsetof(struct instance_color, opacity),
+            .buffer = s->instances,
+            .rate   = 1,
+        },
+    };
+
+    static const struct pgcraft_iovar color_vert_out_vars[] = {
+        {.name = "uv",      .type = NGLI_TYPE_VEC2},
+        {.name = "color",   .type = NGLI_TYPE_VEC3},
+        {.name = "opacity", .type = NGLI_TYPE_F32},
+    };
+
+    static const struct pgcraft_iovar texture_vert_out_vars[] = {
+        {.name = "uv",        .type = NGLI_TYPE_VEC2},
+        {.name = "tex_coord", .type = NGLI_TYPE_VEC2},
+    };
+
+    struct pgcraft_texture textures[1];
+    if (is_texture) {
+        const struct rendertexture_opts *o = leaf->opts;
+        textures[0] = get_rendertexture_source(o->texture_node);
+    }
+
+    /* The modelview matrix is the only instanced attribute of RenderTexture */
+    const struct pgcraft_params crafter_params = {
+        .program_label    = is_texture ? "nopegl/rendertexture-batch" : "nopegl/rendercolor-batch",
+        .vert_base        = is_texture ? source_texture_vert : source_color_batch_vert,
+        .frag_base        = c->combined_fragment,
+        .uniforms         = uniforms,
+        .nb_uniforms      = NGLI_ARRAY_NB(uniforms),
+        .textures         = is_texture ? textures : NULL,
+        .nb_textures      = is_texture ? 1 : 0,
+        .attributes       = attributes,
+        .nb_attributes    = is_texture ? 3 : NGLI_ARRAY_NB(attributes),
+        .vert_out_vars    = is_texture ? texture_vert_out_vars : color_vert_out_vars,
+        .nb_vert_out_vars = is_texture ? NGLI_ARRAY_NB(texture_vert_out_vars) : NGLI_ARRAY_NB(color_vert_out_vars),
+    };
+
+    struct graphics_state state = rnode->graphics_state;
+    ret = ngli_blending_apply_preset(&state, co->blending);
+    if (ret < 0)
+        return ret;
+
+    s->crafter = ngli_pgcraft_create(ctx);
+    if (!s->crafter)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngli_pgcraft_craft(s->crafter, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    s->pipeline_compat = ngli_pipeline_compat_create(gpu_ctx);
+    if (!s->pipeline_compat)
+        return NGL_ERROR_MEMORY;
+
+    const struct pipeline_params pipeline_params = {
+        .type = NGLI_PIPELINE_TYPE_GRAPHICS,
+        .graphics = {
+            .topology     = c->topology,
+            .state        = state,
+            .rt_layout    = rnode->rendertarget_layout,
+            .vertex_state = ngli_pgcraft_get_vertex_state(s->crafter),
+        },
+        .program = ngli_pgcraft_get_program(s->crafter),
+        .layout  = ngli_pgcraft_get_pipeline_layout(s->crafter),
+    };
+
+    const struct pipeline_resources pipeline_resources = ngli_pgcraft_get_pipeline_resources(s->crafter);
+    const struct pgcraft_compat_info *compat_info = ngli_pgcraft_get_compat_info(s->crafter);
+
+    const struct pipeline_compat_params params = {
+        .params      = &pipeline_params,
+        .resources   = &pipeline_resources,
+        .compat_info = compat_info,
+    };
+
+    ret = ngli_pipeline_compat_init(s->pipeline_compat, &params);
+    if (ret < 0)
+        return ret;
+
+    s->projection_matrix_index = ngli_pgcraft_get_uniform_index(s->crafter, "projection_matrix", NGLI_PROGRAM_SHADER_VERT);
+
+    return 0;
+}
+
+static int update_instances(struct render_batch *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+
+    int changed = !s->instances_uploaded;
+    for (size_t i = 0; i < s->nb_instances; i++) {
+        /* Same as ngli_transform_draw() down the transformation chain */
+        NGLI_ALIGNED_MAT(matrix);
+        memcpy(matrix, modelview_matrix, sizeof(matrix));
+        const struct ngl_node *node = s->children[i];
+        while (node != s->leaves[i]) {
+            const struct transform *trf = node->priv_data;
+            ngli_mat4_mul(matrix, matrix, trf->matrix);
+            node = trf->child;
+        }
+
+        uint8_t *dst = s->instances_data + i * s->instance_size;
+        if (s->leaves[i]->cls->id == NGL_NODE_RENDERCOLOR) {
+            struct rendercolor_opts *o = s->leaves[i]->opts;
+            struct instance_color instance;
+            memcpy(instance.modelview_matrix, matrix, sizeof(instance.modelview_matrix));
+            memcpy(instance.color, ngli_node_get_data_ptr(o->color_node, o->color), sizeof(instance.color));
+            instance.opacity = *(const float *)ngli_node_get_data_ptr(o->opacity_node, &o->opacity);
+            if (memcmp(dst, &instance, sizeof(instance))) {
+                memcpy(dst, &instance, sizeof(instance));
+                changed = 1;
+            }
+        } else {
+            if (memcmp(dst, matrix, sizeof(matrix))) {
+                memcpy(dst, matrix, sizeof(matrix));
+                changed = 1;
+            }
+        }
+    }
+
+    if (!changed)
+        return 0;
+
+    int ret = ngli_buffer_upload(s->instances, s->instances_data, s->nb_instances * s->instance_size, 0);
+    if (ret < 0)
+        return ret;
+    s->instances_uploaded = 1;
+    return 0;
+}
+
+void ngli_render_batch_draw(struct render_batch *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct pipeline_compat *pl_compat = s->pipeline_compat;
+    const struct render_common *c = get_common_priv(s->leaves[0]);
+
+    int ret = update_instances(s);
+    if (ret < 0) {
+        LOG(ERROR, "could not update batch instances: %s", NGLI_RET_STR(ret));
+        return;
+    }
+
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+    ngli_pipeline_compat_update_uniform(pl_compat, s->projection_matrix_index, projection_matrix);
+
+    const struct darray *texture_infos_array = ngli_pgcraft_get_texture_infos(s->crafter);
+    const struct pgcraft_texture_info *texture_info = ngli_darray_data(texture_infos_array);
+    for (size_t i = 0; i < ngli_darray_count(texture_infos_array); i++)
+        ngli_pipeline_compat_update_texture_info(pl_compat, &texture_info[i]);
+
+    if (!ctx->render_pass_started) {
+        struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+        ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
+        ctx->render_pass_started = 1;
+    }
+
+    const int nb_instances = (int)s->nb_instances;
+    if (c->geometry && c->geometry->indices_buffer)
+        ngli_pipeline_compat_draw_indexed(pl_compat,
+                                          c->geometry->indices_buffer,
+                                          c->geometry->indices_layout.format,
+                                          (int)c->geometry->indices_layout.count, nb_instances);
+    else
+        ngli_pipeline_compat_draw(pl_compat, c->nb_vertices, nb_instances);
+
+    /* Account for the single draw call issued on behalf of the whole batch */
+    s->leaves[0]->draw_count++;
+}
+
+void ngli_render_batch_freep(struct render_batch **sp)
+{
+    struct render_batch *s = *sp;
+    if (!s)
+        return;
+    ngli_pipeline_compat_freep(&s->pipeline_compat);
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_buffer_freep(&s->instances);
+    ngli_freep(&s->instances_data);
+    ngli_freep(&s->leaves);
+    ngli_freep(&s->children);
+    ngli_freep(sp);
+}
+
 #define DECLARE_RENDEROTHER(type, cls_id, cls_name) \
 static void type##_draw(struct ngl_node *node)      \
 {                                                   \
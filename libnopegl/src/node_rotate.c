@@ -114,6 +114,7 @@ const struct node_class ngli_rotate_class = {
     .init      = rotate_init,
     .update    = rotate_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct rotate_opts),
     .priv_size = sizeof(struct rotate_priv),
     .params    = rotate_params,
@@ -103,6 +103,7 @@ const struct node_class ngli_rotatequat_class = {
     .init      = rotatequat_init,
     .update    = rotatequat_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct rotatequat_opts),
     .priv_size = sizeof(struct rotatequat_priv),
     .params    = rotatequat_params,
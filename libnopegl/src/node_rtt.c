@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "config.h"
+#include "darray.h"
 #include "rendertarget.h"
 #include "format.h"
 #include "gpu_ctx.h"
@@ -57,9 +58,19 @@ struct rtt_priv {
     struct rendertarget *available_rendertargets[2];
     struct texture *depth;
 
+    int transient_attachments;
     struct texture *ms_colors[NGLI_MAX_COLOR_ATTACHMENTS];
     size_t nb_ms_colors;
     struct texture *ms_depth;
+
+    /* Memoization of the rendered content */
+    int time_dependent;
+    struct darray sampled_textures; // struct texture_priv pointers
+    int content_valid;
+    size_t sampled_textures_rev;
+    size_t targets_rev;
+    float modelview_matrix[4 * 4];
+    float projection_matrix[4 * 4];
 };
 
 #define FEATURE_DEPTH       (1 << 0)
@@ -142,8 +153,11 @@ static int rtt_init(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
     const struct gpu_limits *limits = &gpu_ctx->limits;
+    struct rtt_priv *s = node->priv_data;
     const struct rtt_opts *o = node->opts;
 
+    ngli_darray_init(&s->sampled_textures, sizeof(struct texture_priv *), 0);
+
     if (!o->nb_color_textures) {
         LOG(ERROR, "at least one color texture must be specified");
         return NGL_ERROR_INVALID_ARG;
@@ -255,6 +269,128 @@ static int rtt_prepare(struct ngl_node *node)
     return ngli_node_prepare_children(node);
 }
 
+/*
+ * Return 1 if the content rendered by the branch may change with the time, 0
+ * otherwise. In the latter case, the content can only change because of a
+ * live change (notified through the invalidate callback) or because one of
+ * the textures it samples has been updated (tracked with their revision).
+ */
+static int track_time_dependency(struct rtt_priv *s, const struct ngl_node *node)
+{
+    const struct node_class *cls = node->cls;
+    if (cls->flags & NGLI_NODE_FLAG_TIME_DEPENDENT)
+        return 1;
+
+    if (cls->category == NGLI_NODE_CATEGORY_VARIABLE) {
+        const struct variable_info *var = node->priv_data;
+        if (var->dynamic)
+            return 1;
+    } else if (cls->category == NGLI_NODE_CATEGORY_BUFFER) {
+        const struct buffer_info *buffer = node->priv_data;
+        if (buffer->flags & NGLI_BUFFER_INFO_FLAG_DYNAMIC)
+            return 1;
+    } else if (cls->category == NGLI_NODE_CATEGORY_BLOCK) {
+        /* Storage blocks may be written by any compute in the graph */
+        const struct block_info *block = node->priv_data;
+        if (block->usage & NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+            return 1;
+    } else if (cls->category == NGLI_NODE_CATEGORY_TEXTURE) {
+        /* Same for the textures used with image load/store */
+        struct texture_priv *texture_priv = node->priv_data;
+        if (texture_priv->params.usage & NGLI_TEXTURE_USAGE_STORAGE_BIT)
+            return 1;
+        if (!ngli_darray_push(&s->sampled_textures, &texture_priv))
+            return NGL_ERROR_MEMORY;
+    }
+
+    const struct ngl_node **children = ngli_darray_data(&node->children);
+    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+        int ret = track_time_dependency(s, children[i]);
+        if (ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+static size_t get_sampled_textures_rev(const struct rtt_priv *s)
+{
+    size_t rev = 0;
+    struct texture_priv **texture_privs = ngli_darray_data(&s->sampled_textures);
+    for (size_t i = 0; i < ngli_darray_count(&s->sampled_textures); i++)
+        rev += texture_privs[i]->rev;
+    return rev;
+}
+
+/*
+ * The targets may also be written by other passes (another RenderToTexture
+ * using the same textures), in which case their revision is bumped as well
+ */
+static size_t get_targets_rev(const struct rtt_opts *o)
+{
+    size_t rev = 0;
+    for (size_t i = 0; i < o->nb_color_textures; i++)
+        rev += get_rtt_texture_info(o->color_textures[i]).texture_priv->rev;
+    if (o->depth_texture)
+        rev += get_rtt_texture_info(o->depth_texture).texture_priv->rev;
+    return rev;
+}
+
+/*
+ * Return 1 if one of the targets can be written with image load/store, in
+ * which case their content can change at any time without notice
+ */
+static int has_storage_target(const struct rtt_opts *o)
+{
+    for (size_t i = 0; i < o->nb_color_textures; i++) {
+        const struct texture_priv *texture_priv = get_rtt_texture_info(o->color_textures[i]).texture_priv;
+        if (texture_priv->params.usage & NGLI_TEXTURE_USAGE_STORAGE_BIT)
+            return 1;
+    }
+    if (o->depth_texture) {
+        const struct texture_priv *texture_priv = get_rtt_texture_info(o->depth_texture).texture_priv;
+        if (texture_priv->params.usage & NGLI_TEXTURE_USAGE_STORAGE_BIT)
+            return 1;
+    }
+    return 0;
+}
+
+/*
+ * The attachments not exposed in the graph which content is discarded at the
+ * end of the render pass are shared with the other render passes
+ */
+static int create_attachment(struct ngl_node *node, const struct texture_params *params,
+                             size_t index, struct texture **texturep)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct rtt_priv *s = node->priv_data;
+
+    if (s->transient_attachments) {
+        if (!ctx->transient_textures) {
+            ctx->transient_textures = ngli_texturepool_create(ctx->gpu_ctx);
+            if (!ctx->transient_textures)
+                return NGL_ERROR_MEMORY;
+        }
+        return ngli_texturepool_get(ctx->transient_textures, params, index, texturep);
+    }
+
+    struct texture *texture = ngli_texture_create(ctx->gpu_ctx);
+    if (!texture)
+        return NGL_ERROR_MEMORY;
+    *texturep = texture;
+    return ngli_texture_init(texture, params);
+}
+
+static void release_attachment(struct ngl_node *node, struct texture **texturep)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct rtt_priv *s = node->priv_data;
+
+    if (s->transient_attachments)
+        ngli_texturepool_release(ctx->transient_textures, texturep);
+    else
+        ngli_texture_freep(texturep);
+}
+
 static int rtt_prefetch(struct ngl_node *node)
 {
     int ret = 0;
@@ -291,7 +427,19 @@ static int rtt_prefetch(struct ngl_node *node)
         }
     }
 
+    /*
+     * The dependencies are collected here because the resources usage is only
+     * known once the whole graph is prepared
+     */
+    ngli_darray_clear(&s->sampled_textures);
+    ret = track_time_dependency(s, o->child);
+    if (ret < 0)
+        return ret;
+    s->time_dependent = ret || has_storage_target(o);
+    s->content_valid = 0;
+
     const int transient_usage = nb_interruptions == 0 ? NGLI_TEXTURE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0;
+    s->transient_attachments = nb_interruptions == 0;
 
     struct rendertarget_params rt_params = {
         .width = s->width,
@@ -306,11 +454,7 @@ static int rtt_prefetch(struct ngl_node *node)
         const int32_t layer_end = info.layer_base + info.layer_count;
         for (int32_t j = info.layer_base; j < layer_end; j++) {
             if (o->samples) {
-                struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-                if (!ms_texture)
-                    return NGL_ERROR_MEMORY;
-                s->ms_colors[s->nb_ms_colors++] = ms_texture;
-                struct texture_params attachment_params = {
+                const struct texture_params attachment_params = {
                     .type    = NGLI_TEXTURE_TYPE_2D,
                     .format  = params->format,
                     .width   = s->width,
@@ -318,9 +462,11 @@ static int rtt_prefetch(struct ngl_node *node)
                     .samples = o->samples,
                     .usage   = NGLI_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | transient_usage,
                 };
-                ret = ngli_texture_init(ms_texture, &attachment_params);
+                const size_t index = s->nb_ms_colors++;
+                ret = create_attachment(node, &attachment_params, index, &s->ms_colors[index]);
                 if (ret < 0)
                     return ret;
+                struct texture *ms_texture = s->ms_colors[index];
                 rt_params.colors[rt_params.nb_colors].attachment = ms_texture;
                 rt_params.colors[rt_params.nb_colors].attachment_layer = 0;
                 rt_params.colors[rt_params.nb_colors].resolve_target = texture;
@@ -350,11 +496,7 @@ static int rtt_prefetch(struct ngl_node *node)
         struct texture_params *params = &texture->params;
 
         if (o->samples) {
-            struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_depth = ms_texture;
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = params->format,
                 .width   = s->width,
@@ -362,10 +504,10 @@ static int rtt_prefetch(struct ngl_node *node)
                 .samples = o->samples,
                 .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            ret = ngli_texture_init(ms_texture, &attachment_params);
+            ret = create_attachment(node, &attachment_params, 0, &s->ms_depth);
             if (ret < 0)
                 return ret;
-            rt_params.depth_stencil.attachment = ms_texture;
+            rt_params.depth_stencil.attachment = s->ms_depth;
             rt_params.depth_stencil.attachment_layer = 0;
             rt_params.depth_stencil.resolve_target = texture;
             rt_params.depth_stencil.resolve_target_layer = info.layer_base;
@@ -385,11 +527,7 @@ static int rtt_prefetch(struct ngl_node *node)
             depth_format = ngli_gpu_ctx_get_preferred_depth_format(gpu_ctx);
 
         if (depth_format != NGLI_FORMAT_UNDEFINED) {
-            struct texture *depth = ngli_texture_create(gpu_ctx);
-            if (!depth)
-                return NGL_ERROR_MEMORY;
-            s->depth = depth;
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = depth_format,
                 .width   = s->width,
@@ -397,10 +535,10 @@ static int rtt_prefetch(struct ngl_node *node)
                 .samples = o->samples,
                 .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            ret = ngli_texture_init(depth, &attachment_params);
+            ret = create_attachment(node, &attachment_params, 0, &s->depth);
             if (ret < 0)
                 return ret;
-            rt_params.depth_stencil.attachment = depth;
+            rt_params.depth_stencil.attachment = s->depth;
             rt_params.depth_stencil.load_op = NGLI_LOAD_OP_CLEAR;
             /*
              * For the first rendertarget with load operations set to clear, if
@@ -472,6 +610,32 @@ static int rtt_prefetch(struct ngl_node *node)
     return 0;
 }
 
+static int rtt_invalidate(struct ngl_node *node)
+{
+    struct rtt_priv *s = node->priv_data;
+    s->content_valid = 0;
+    return 0;
+}
+
+/*
+ * The rendered content can be re-used if nothing it depends on changed since
+ * the last render, including the transforms inherited from the parents, and
+ * if no other pass wrote to the targets in the meantime
+ */
+static int is_content_valid(const struct ngl_ctx *ctx, const struct rtt_priv *s,
+                            const struct rtt_opts *o)
+{
+    if (!s->content_valid || s->time_dependent)
+        return 0;
+
+    const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+    return !memcmp(s->modelview_matrix, modelview_matrix, sizeof(s->modelview_matrix)) &&
+           !memcmp(s->projection_matrix, projection_matrix, sizeof(s->projection_matrix)) &&
+           s->sampled_textures_rev == get_sampled_textures_rev(s) &&
+           s->targets_rev == get_targets_rev(o);
+}
+
 static void rtt_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -479,6 +643,16 @@ static void rtt_draw(struct ngl_node *node)
     struct rtt_priv *s = node->priv_data;
     const struct rtt_opts *o = node->opts;
 
+    if (is_content_valid(ctx, s, o)) {
+        TRACE("%s content is unchanged, skip rendering", node->label);
+        return;
+    }
+
+    const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
+    const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
+    memcpy(s->modelview_matrix, modelview_matrix, sizeof(s->modelview_matrix));
+    memcpy(s->projection_matrix, projection_matrix, sizeof(s->projection_matrix));
+
     const struct viewport prev_vp = ngli_gpu_ctx_get_viewport(gpu_ctx);
 
     const struct viewport vp = {0, 0, s->width, s->height};
@@ -528,7 +702,18 @@ static void rtt_draw(struct ngl_node *node)
         const struct texture_params *texture_params = &texture->params;
         if (texture_params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
             ngli_texture_generate_mipmap(texture);
+        texture_priv->rev++;
     }
+
+    if (o->depth_texture) {
+        const struct rtt_texture_info info = get_rtt_texture_info(o->depth_texture);
+        info.texture_priv->rev++;
+    }
+
+    /* Nested render passes may have updated some of the sampled textures */
+    s->sampled_textures_rev = get_sampled_textures_rev(s);
+    s->targets_rev = get_targets_rev(o);
+    s->content_valid = 1;
 }
 
 static void rtt_release(struct ngl_node *node)
@@ -540,12 +725,20 @@ static void rtt_release(struct ngl_node *node)
 
     ngli_rendertarget_freep(&s->rt);
     ngli_rendertarget_freep(&s->rt_resume);
-    ngli_texture_freep(&s->depth);
+    release_attachment(node, &s->depth);
 
     for (size_t i = 0; i < s->nb_ms_colors; i++)
-        ngli_texture_freep(&s->ms_colors[i]);
+        release_attachment(node, &s->ms_colors[i]);
     s->nb_ms_colors = 0;
-    ngli_texture_freep(&s->ms_depth);
+    release_attachment(node, &s->ms_depth);
+
+    s->content_valid = 0;
+}
+
+static void rtt_uninit(struct ngl_node *node)
+{
+    struct rtt_priv *s = node->priv_data;
+    ngli_darray_reset(&s->sampled_textures);
 }
 
 const struct node_class ngli_rtt_class = {
@@ -554,9 +747,11 @@ const struct node_class ngli_rtt_class = {
     .init      = rtt_init,
     .prepare   = rtt_prepare,
     .prefetch  = rtt_prefetch,
+    .invalidate = rtt_invalidate,
     .update    = ngli_node_update_children,
     .draw      = rtt_draw,
     .release   = rtt_release,
+    .uninit    = rtt_uninit,
     .opts_size = sizeof(struct rtt_opts),
     .priv_size = sizeof(struct rtt_priv),
     .params    = rtt_params,
@@ -103,6 +103,7 @@ const struct node_class ngli_scale_class = {
     .init      = scale_init,
     .update    = scale_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct scale_opts),
     .priv_size = sizeof(struct scale_priv),
     .params    = scale_params,
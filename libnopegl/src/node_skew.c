@@ -117,6 +117,7 @@ const struct node_class ngli_skew_class = {
     .init      = skew_init,
     .update    = skew_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct skew_opts),
     .priv_size = sizeof(struct skew_priv),
     .params    = skew_params,
@@ -27,6 +27,7 @@
 #include "log.h"
 #include "nopegl.h"
 #include "internal.h"
+#include "timeindex.h"
 #include "type.h"
 
 struct streamedbuffer_opts {
@@ -40,6 +41,7 @@ struct streamedbuffer_opts {
 struct streamedbuffer_priv {
     struct buffer_info buf;
     size_t last_index;
+    int prefetched;
 };
 
 NGLI_STATIC_ASSERT(buffer_info_is_first, offsetof(struct streamedbuffer_priv, buf) == 0);
@@ -78,21 +80,14 @@ DECLARE_STREAMED_PARAMS(vec3,   NGL_NODE_BUFFERVEC3)
 DECLARE_STREAMED_PARAMS(vec4,   NGL_NODE_BUFFERVEC4)
 DECLARE_STREAMED_PARAMS(mat4,   NGL_NODE_BUFFERMAT4)
 
-static size_t get_data_index(const struct ngl_node *node, size_t start, int64_t t64)
+static size_t get_data_index(const struct ngl_node *node, size_t hint, int64_t t64)
 {
     const struct streamedbuffer_opts *o = node->opts;
     const struct buffer_info *timestamps_priv = o->timestamps->priv_data;
     const int64_t *timestamps = (int64_t *)timestamps_priv->data;
     const size_t nb_timestamps = timestamps_priv->layout.count;
 
-    size_t ret = SIZE_MAX;
-    for (size_t i = start; i < nb_timestamps; i++) {
-        const int64_t ts = timestamps[i];
-        if (ts > t64)
-            break;
-        ret = i;
-    }
-    return ret;
+    return ngli_timeindex_search_i64(timestamps, nb_timestamps, hint, t64);
 }
 
 static int streamedbuffer_update(struct ngl_node *node, double t)
@@ -120,16 +115,21 @@ static int streamedbuffer_update(struct ngl_node *node, double t)
 
     const int64_t t64 = llrint(rt * o->timebase[1] / (double)o->timebase[0]);
     size_t index = get_data_index(node, s->last_index, t64);
-    if (index == SIZE_MAX) {
-        index = get_data_index(node, 0, t64);
-        if (index == SIZE_MAX) // the requested time `t` is before the first user timestamp
-            index = 0;
-    }
-    s->last_index = index;
-
+    if (index == SIZE_MAX) // the requested time `t` is before the first user timestamp
+        index = 0;
     const struct buffer_info *buffer_info = o->buffer_node->priv_data;
     const struct buffer_layout *layout = &info->layout;
-    info->data = buffer_info->data + layout->stride * layout->count * index;
+    const size_t chunk_size = layout->stride * layout->count;
+    info->data = buffer_info->data + chunk_size * index;
+
+    /*
+     * Only the current chunk is accessed: with a file-backed source buffer,
+     * hint the system to read the next one ahead while it is being used.
+     */
+    if (index != s->last_index || !s->prefetched)
+        ngli_node_buffer_prefetch(o->buffer_node, chunk_size * (index + 1), chunk_size);
+    s->prefetched = 1;
+    s->last_index = index;
 
     if (!(info->flags & NGLI_BUFFER_INFO_FLAG_GPU_UPLOAD))
         return 0;
@@ -198,9 +198,10 @@ static int streamedbuffer_init(struct ngl_node *node)
     }
 
     info->data = buffer_info->data;
-    info->data_size = buffer_info->data_size / layout->count;
+    info->data_size = layout->count * layout->stride;
     info->usage = buffer_info->usage;
     info->flags |= NGLI_BUFFER_INFO_FLAG_DYNAMIC;
+    info->flags |= buffer_info->flags & NGLI_BUFFER_INFO_FLAG_READ_ONLY;
 
     if (!o->timebase[1]) {
         LOG(ERROR, "invalid timebase: %d/%d", o->timebase[0], o->timebase[1]);
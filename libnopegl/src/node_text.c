@@ -41,6 +41,7 @@
 #include "text_bg_frag.h"
 #include "text_bg_vert.h"
 #include "text_chars_frag.h"
+#include "text_chars_sdf_frag.h"
 #include "text_chars_vert.h"
 
 #define VERTEX_USAGE_FLAGS (NGLI_BUFFER_USAGE_TRANSFER_DST_BIT | \
@@ -96,6 +97,7 @@ struct text_opts {
     int valign, halign;
     int writing_mode;
     int32_t aspect_ratio[2];
+    int distance_field;
 };
 
 struct text_priv {
@@ -112,6 +114,7 @@ struct text_priv {
     struct buffer *bg_vertices;
 
     struct darray pipeline_descs;
+    const struct texture *bound_atlas_texture;
     int live_changed;
 };
 
@@ -205,6 +208,9 @@ static const struct node_param text_params[] = {
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
                      .update_func=set_live_changed,
                      .desc=NGLI_DOCSTRING("box aspect ratio")},
+    {"distance_field", NGLI_PARAM_TYPE_BOOL, OFFSET(distance_field), {.i32=0},
+                     .desc=NGLI_DOCSTRING("rasterize the glyphs as signed distance fields to keep their edges sharp at any scale "
+                                          "(require build with external text libraries and `font_files`)")},
     {NULL}
 };
 
@@ -222,6 +228,33 @@ static void destroy_characters_resources(struct text_priv *s)
     s->nb_chars = 0;
 }
 
+/*
+ * The atlas texture of a mutable atlas may be replaced at any time (even by
+ * another Text node when the atlas is shared), so the pipelines need to be
+ * checked before every draw
+ */
+static int refresh_atlas_texture(struct text_priv *s)
+{
+    struct text *text = s->text_ctx;
+    if (!(text->cls->flags & NGLI_TEXT_FLAG_MUTABLE_ATLAS))
+        return 0;
+
+    const struct texture *atlas_texture = ngli_text_get_atlas_texture(text);
+    if (atlas_texture == s->bound_atlas_texture)
+        return 0;
+
+    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    for (size_t i = 0; i < ngli_darray_count(&s->pipeline_descs); i++) {
+        struct pipeline_desc_fg *desc_fg = &descs[i].fg;
+        struct pipeline_desc_common *desc = &desc_fg->common;
+        int ret = ngli_pipeline_compat_update_texture(desc->pipeline_compat, 0, atlas_texture);
+        if (ret < 0)
+            return ret;
+    }
+    s->bound_atlas_texture = atlas_texture;
+    return 0;
+}
+
 static int update_text_content(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -356,16 +389,9 @@ static int update_text_content(struct ngl_node *node)
         }
     }
 
-    if (text->cls->flags & NGLI_TEXT_FLAG_MUTABLE_ATLAS) {
-        struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
-        for (size_t i = 0; i < ngli_darray_count(&s->pipeline_descs); i++) {
-            struct pipeline_desc_fg *desc_fg = &descs[i].fg;
-            struct pipeline_desc_common *desc = &desc_fg->common;
-            int ret = ngli_pipeline_compat_update_texture(desc->pipeline_compat, 0, text->atlas_texture);
-            if (ret < 0)
-                goto end;
-        }
-    }
+    ret = refresh_atlas_texture(s);
+    if (ret < 0)
+        goto end;
 
     if ((ret = ngli_buffer_upload(s->transforms, transforms, text_nbchr * 4 * 4 * sizeof(*transforms), 0)) < 0 ||
         (ret = ngli_buffer_upload(s->atlas_coords, atlas_coords, text_nbchr * 4 * sizeof(*atlas_coords), 0)) < 0)
@@ -439,6 +465,7 @@ static int text_init(struct ngl_node *node)
         .valign = o->valign,
         .halign = o->halign,
         .writing_mode = o->writing_mode,
+        .distance_field = o->distance_field,
         .effect_nodes = o->effect_nodes,
         .nb_effect_nodes = o->nb_effect_nodes,
         .defaults = {
@@ -645,7 +672,7 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_desc_fg *desc)
     const struct pgcraft_params crafter_params = {
         .program_label    = "nopegl/text-fg",
         .vert_base        = text_chars_vert,
-        .frag_base        = text_chars_frag,
+        .frag_base        = s->text_ctx->config.distance_field ? text_chars_sdf_frag : text_chars_frag,
         .uniforms         = uniforms,
         .nb_uniforms      = NGLI_ARRAY_NB(uniforms),
         .textures         = textures,
@@ -674,6 +701,11 @@ static int text_prepare(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     struct text_priv *s = node->priv_data;
 
+    /* Make sure all the pipelines share the same (current) atlas texture */
+    int ret = refresh_atlas_texture(s);
+    if (ret < 0)
+        return ret;
+
     struct pipeline_desc *desc = ngli_darray_push(&s->pipeline_descs, NULL);
     if (!desc)
         return NGL_ERROR_MEMORY;
@@ -681,7 +713,7 @@ static int text_prepare(struct ngl_node *node)
 
     memset(desc, 0, sizeof(*desc));
 
-    int ret = bg_prepare(node, &desc->bg);
+    ret = bg_prepare(node, &desc->bg);
     if (ret < 0)
         return ret;
 
@@ -747,6 +779,11 @@ static void text_draw(struct ngl_node *node)
     ngli_pipeline_compat_draw(bg_desc->common.pipeline_compat, 4, 1);
 
     if (s->nb_chars) {
+        if (refresh_atlas_texture(s) < 0) {
+            LOG(ERROR, "unable to update the text atlas texture");
+            return;
+        }
+
         struct pipeline_desc_fg *fg_desc = &desc->fg;
         ngli_pipeline_compat_update_uniform(fg_desc->common.pipeline_compat, fg_desc->common.modelview_matrix_index, modelview_matrix);
         ngli_pipeline_compat_update_uniform(fg_desc->common.pipeline_compat, fg_desc->common.projection_matrix_index, projection_matrix);
@@ -304,6 +304,11 @@ static int texture_prefetch(struct ngl_node *node)
                 .texture_wrap_s        = params->wrap_s,
                 .texture_wrap_t        = params->wrap_t,
                 .texture_usage         = params->usage,
+                /*
+                 * With direct rendering, the consumers sample the image with
+                 * ngl_texvideo() which also handles the HDR conversion
+                 */
+                .fused_tonemapping     = s->supported_image_layouts != (1 << NGLI_IMAGE_LAYOUT_DEFAULT),
 #if defined(TARGET_ANDROID)
                 .android_surface       = media_priv->android_surface,
                 .android_imagereader   = media_priv->android_imagereader,
@@ -410,6 +415,7 @@ static int handle_media_frame(struct ngl_node *node)
 
     /* Reset destination image */
     ngli_image_reset(&s->image);
+    s->rev++;
 
     int ret = ngli_hwmap_map_frame(&s->hwmap, frame, &s->image);
     if (ret < 0) {
@@ -432,6 +438,7 @@ static int handle_buffer_frame(struct ngl_node *node)
         LOG(ERROR, "could not upload texture buffer");
         return ret;
     }
+    s->rev++;
 
     return 0;
 }
@@ -489,6 +496,14 @@ static int get_preferred_format(struct gpu_ctx *gpu_ctx, int format)
     }
 }
 
+/* Buffers used as a data source are uploaded from their CPU data */
+static int check_data_src(const struct ngl_node *data_src)
+{
+    if (data_src && data_src->cls->category == NGLI_NODE_CATEGORY_BUFFER)
+        return ngli_node_buffer_check_cpu_usage(data_src);
+    return 0;
+}
+
 static int texture2d_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -498,6 +513,10 @@ static int texture2d_init(struct ngl_node *node)
 
     s->params = o->params;
 
+    int ret = check_data_src(o->data_src);
+    if (ret < 0)
+        return ret;
+
     const int max_dimension = gpu_ctx->limits.max_texture_dimension_2d;
     if (s->params.width  > max_dimension ||
         s->params.height > max_dimension) {
@@ -543,6 +562,10 @@ static int texture2d_array_init(struct ngl_node *node)
 
     s->params = o->params;
 
+    int ret = check_data_src(o->data_src);
+    if (ret < 0)
+        return ret;
+
     const int max_dimension = gpu_ctx->limits.max_texture_dimension_2d;
     const int max_layers = gpu_ctx->limits.max_texture_array_layers;
     if (s->params.width  <= 0 || s->params.width  > max_dimension ||
@@ -568,6 +591,10 @@ static int texture3d_init(struct ngl_node *node)
 
     s->params = o->params;
 
+    int ret = check_data_src(o->data_src);
+    if (ret < 0)
+        return ret;
+
     const int max_dimension = gpu_ctx->limits.max_texture_dimension_3d;
     if (s->params.width  <= 0 || s->params.width  > max_dimension ||
         s->params.height <= 0 || s->params.height > max_dimension ||
@@ -591,6 +618,11 @@ static int texturecube_init(struct ngl_node *node)
     const struct texture_opts *o = node->opts;
 
     s->params = o->params;
+
+    int ret = check_data_src(o->data_src);
+    if (ret < 0)
+        return ret;
+
     s->params.height = s->params.width;
 
     const int max_dimension = gpu_ctx->limits.max_texture_dimension_cube;
@@ -78,6 +78,7 @@ const struct node_class ngli_transform_class = {
     .init      = transform_init,
     .update    = transform_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct transform_opts),
     .priv_size = sizeof(struct transform_priv),
     .params    = transform_params,
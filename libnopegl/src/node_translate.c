@@ -93,6 +93,7 @@ const struct node_class ngli_translate_class = {
     .init      = translate_init,
     .update    = translate_update,
     .draw      = ngli_transform_draw,
+    .record    = ngli_transform_record,
     .opts_size = sizeof(struct translate_opts),
     .priv_size = sizeof(struct translate_priv),
     .params    = translate_params,
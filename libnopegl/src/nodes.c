@@ -82,6 +82,7 @@ static struct ngl_node *node_create(const struct node_class *cls)
     ngli_assert((((uintptr_t)node->priv_data) & ~(NGLI_ALIGN_VAL - 1)) == (uintptr_t)node->priv_data);
 
     node->cls = cls;
+    node->prepared_time = -1.;
     node->last_update_time = -1.;
     node->visit_time = -1.;
 
@@ -170,6 +171,7 @@ static void node_release(struct ngl_node *node)
         node->cls->release(node);
     }
     node->state = STATE_INITIALIZED;
+    node->prepared_time = -1.;
     node->last_update_time = -1.;
 }
 
@@ -520,6 +522,20 @@ static int node_set_children_ctx(uint8_t *base_ptr, const struct node_param *par
     return 0;
 }
 
+static void unregister_update_prepare(struct ngl_node *node, struct ngl_ctx *ctx)
+{
+    if (!node->cls->update_prepare)
+        return;
+    struct darray *nodes_array = &ctx->update_prepare_nodes;
+    struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
+        if (nodes[i] == node) {
+            ngli_darray_remove(nodes_array, i);
+            return;
+        }
+    }
+}
+
 static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx, struct ngl_ctx *pctx)
 {
     int ret;
@@ -541,6 +557,7 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx, struct ngl_c
             if (node->ctx != pctx)
                 return 0;
             if (node->ctx_refcount-- == 1) {
+                unregister_update_prepare(node, pctx);
                 node_uninit(node);
                 node->ctx = NULL;
             }
@@ -559,6 +576,9 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx, struct ngl_c
             node->ctx = NULL;
             return ret;
         }
+        if (!node->ctx_refcount && node->cls->update_prepare &&
+            !ngli_darray_push(&ctx->update_prepare_nodes, &node))
+            return NGL_ERROR_MEMORY;
         node->ctx_refcount++;
     }
 
@@ -728,23 +748,96 @@ int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
     return 0;
 }
 
+static int node_update_prepare(struct ngl_node *node, double t)
+{
+    TRACE("UPDATE PREPARE %s @ %p with t=%g", node->label, node, t);
+    int ret = node->cls->update_prepare(node, t);
+    if (ret < 0) {
+        LOG(ERROR, "preparing update of node %s failed: %s", node->label, NGLI_RET_STR(ret));
+        return ret;
+    }
+    node->prepared_time = t;
+    return 0;
+}
+
+struct update_prepare_batch {
+    struct ngl_node **nodes;
+    double t;
+};
+
+static int update_prepare_job(void *user_arg, size_t index)
+{
+    const struct update_prepare_batch *batch = user_arg;
+    struct ngl_node *node = batch->nodes[index];
+    if (node->state != STATE_READY || !node->is_active || node->last_update_time == batch->t)
+        return 0;
+    return node_update_prepare(node, batch->t);
+}
+
+int ngli_node_update_prepare_parallel(struct ngl_ctx *s, double t)
+{
+    struct darray *nodes_array = &s->update_prepare_nodes;
+    struct update_prepare_batch batch = {
+        .nodes = ngli_darray_data(nodes_array),
+        .t     = t,
+    };
+    return ngli_threadpool_run(s->update_pool, update_prepare_job, &batch, ngli_darray_count(nodes_array));
+}
+
+/*
+ * Signal to the variable consumers (passes) that the data must be written
+ * again. Nodes are not required to do it themselves: it happens after every
+ * update of a dynamic variable and after every live change.
+ */
+static void bump_variable_rev(struct ngl_node *node)
+{
+    if (node->cls->category != NGLI_NODE_CATEGORY_VARIABLE)
+        return;
+    struct variable_info *var = node->priv_data;
+    var->rev++;
+}
+
 int ngli_node_update(struct ngl_node *node, double t)
 {
     ngli_assert(node->state == STATE_READY);
-    if (node->cls->update) {
-        if (node->last_update_time != t) {
-            TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
-            int ret = node->cls->update(node, t);
-            if (ret < 0) {
-                LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
-                return ret;
-            }
-            node->last_update_time = t;
-            node->draw_count = 0;
-        } else {
-            TRACE("%s already updated for t=%g, skip it", node->label, t);
+    const struct node_class *cls = node->cls;
+    if (!cls->update_prepare && !cls->update)
+        return 0;
+
+    /*
+     * The parallel prepare stage is executed with the scene time: if the node
+     * is reached with a different time (through a time remapping), its
+     * prepared state is invalid even if it has already been updated for that
+     * time.
+     */
+    const int stale_prepare = node->prepared_time != -1. && node->prepared_time != t;
+    if (node->last_update_time == t && !stale_prepare) {
+        TRACE("%s already updated for t=%g, skip it", node->label, t);
+        return 0;
+    }
+
+    if (cls->update_prepare && node->prepared_time != t) {
+        int ret = node_update_prepare(node, t);
+        if (ret < 0)
+            return ret;
+    }
+    node->prepared_time = -1.;
+
+    if (cls->update) {
+        TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+        int ret = cls->update(node, t);
+        if (ret < 0) {
+            LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
+            return ret;
         }
     }
+    if (cls->category == NGLI_NODE_CATEGORY_VARIABLE) {
+        struct variable_info *var = node->priv_data;
+        if (var->dynamic)
+            var->rev++;
+    }
+    node->last_update_time = t;
+    node->draw_count = 0;
 
     return 0;
 }
@@ -779,6 +872,15 @@ void ngli_node_draw(struct ngl_node *node)
     }
 }
 
+int ngli_node_record(struct ngl_node *node, struct drawlist *drawlist)
+{
+    if (node->cls->record)
+        return node->cls->record(node, drawlist);
+    if (!node->cls->draw)
+        return 0;
+    return ngli_drawlist_add_draw(drawlist, node);
+}
+
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp)
 {
@@ -817,6 +919,9 @@ static int param_add(struct ngl_node *node, const char *key, size_t nb_elems, vo
     if (node->ctx && par->update_func)
         ret = par->update_func(node);
 
+    if (node->ctx)
+        bump_variable_rev(node);
+
     return ret;
 }
 
@@ -834,6 +939,7 @@ int ngl_node_param_add_f64s(struct ngl_node *node, const char *key,
 
 static int node_invalidate_branch(struct ngl_node *node)
 {
+    node->prepared_time = -1;
     node->last_update_time = -1;
     if (node->cls->invalidate) {
         int ret = node->cls->invalidate(node);
@@ -849,8 +955,8 @@ static int node_invalidate_branch(struct ngl_node *node)
     return 0;
 }
 
-static int node_param_is_value_allowed(struct ngl_node *node, const char *key,
-                                       const uint8_t *ptr, const struct node_param *par)
+int ngli_node_param_is_value_allowed(struct ngl_node *node, const char *key,
+                                     const uint8_t *ptr, const struct node_param *par)
 {
     if (!node->ctx)
         return 0;
@@ -871,7 +977,7 @@ static int node_param_is_value_allowed(struct ngl_node *node, const char *key,
     return 0;
 }
 
-static int node_param_update(struct ngl_node *node, const struct node_param *par)
+int ngli_node_param_update(struct ngl_node *node, const struct node_param *par)
 {
     if (!node->ctx)
         return 0;
@@ -882,21 +988,23 @@ static int node_param_update(struct ngl_node *node, const struct node_param *par
             return ret;
     }
 
+    bump_variable_rev(node);
+
     return node_invalidate_branch(node);
 }
 
-#define FORWARD_TO_PARAM(type, ...)                                     \
-    int ret;                                                            \
-    uint8_t *base_ptr;                                                  \
-    const struct node_param *par =                                      \
-        ngli_node_param_find(node, key, &base_ptr);                     \
-    if (!par)                                                           \
-        return NGL_ERROR_NOT_FOUND;                                     \
-    uint8_t *dst = base_ptr + par->offset;                              \
-    if ((ret = node_param_is_value_allowed(node, key, dst, par)) < 0 || \
-        (ret = ngli_params_set_##type(dst, par, __VA_ARGS__)) < 0 ||    \
-        (ret = node_param_update(node, par)) < 0)                       \
-        return ret;                                                     \
+#define FORWARD_TO_PARAM(type, ...)                                          \
+    int ret;                                                                 \
+    uint8_t *base_ptr;                                                       \
+    const struct node_param *par =                                           \
+        ngli_node_param_find(node, key, &base_ptr);                          \
+    if (!par)                                                                \
+        return NGL_ERROR_NOT_FOUND;                                          \
+    uint8_t *dst = base_ptr + par->offset;                                   \
+    if ((ret = ngli_node_param_is_value_allowed(node, key, dst, par)) < 0 || \
+        (ret = ngli_params_set_##type(dst, par, __VA_ARGS__)) < 0 ||         \
+        (ret = ngli_node_param_update(node, par)) < 0)                       \
+        return ret;                                                          \
     return 0
 
 int ngl_node_param_set_bool(struct ngl_node *node, const char *key, int value)
@@ -51,6 +51,8 @@
 struct uniform_map {
     int32_t index;
     const void *data;
+    const struct variable_info *var;
+    size_t rev;
 };
 
 struct resource_map {
@@ -66,6 +68,8 @@ struct pipeline_desc {
     int32_t projection_matrix_index;
     int32_t normal_matrix_index;
     int32_t resolution_index;
+    int has_normal_matrix;
+    float normal_modelview_matrix[4*4]; // modelview the normal matrix has been derived from
     struct darray uniforms_map;
     struct darray blocks_map;
 };
@@ -73,10 +77,14 @@ struct pipeline_desc {
 static int register_uniform(struct pass *s, const char *name, struct ngl_node *uniform, int stage)
 {
     struct pgcraft_uniform crafter_uniform = {.stage = stage};
+    const struct variable_info *var = NULL;
     snprintf(crafter_uniform.name, sizeof(crafter_uniform.name), "%s", name);
 
     if (uniform->cls->category == NGLI_NODE_CATEGORY_BUFFER) {
         struct buffer_info *buffer_info = uniform->priv_data;
+        int ret = ngli_node_buffer_check_cpu_usage(uniform);
+        if (ret < 0)
+            return ret;
         crafter_uniform.type  = buffer_info->layout.type;
         crafter_uniform.count = buffer_info->layout.count;
         crafter_uniform.data  = buffer_info->data;
@@ -84,6 +92,7 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
         struct variable_info *variable_info = uniform->priv_data;
         crafter_uniform.type  = variable_info->data_type;
         crafter_uniform.data  = variable_info->data;
+        var = variable_info;
     } else {
         ngli_assert(0);
     }
@@ -93,11 +102,19 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
         struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
         if (resprops_node) {
             const struct resourceprops_opts *resprops = resprops_node->opts;
+            if (resprops->writable && uniform->cls->category == NGLI_NODE_CATEGORY_BUFFER) {
+                const struct buffer_info *buffer_info = uniform->priv_data;
+                if (buffer_info->flags & NGLI_BUFFER_INFO_FLAG_READ_ONLY) {
+                    LOG(ERROR, "%s is backed by a read-only file and can not be writable", name);
+                    return NGL_ERROR_INVALID_USAGE;
+                }
+            }
             crafter_uniform.precision = resprops->precision;
         }
     }
 
-    if (!ngli_darray_push(&s->crafter_uniforms, &crafter_uniform))
+    if (!ngli_darray_push(&s->crafter_uniforms, &crafter_uniform) ||
+        !ngli_darray_push(&s->crafter_uniform_vars, &var))
         return NGL_ERROR_MEMORY;
 
     return 0;
@@ -114,7 +131,9 @@ static int register_builtin_uniforms(struct pass *s)
 
     for (size_t i = 0; i < NGLI_ARRAY_NB(crafter_uniforms); i++) {
         struct pgcraft_uniform *crafter_uniform = &crafter_uniforms[i];
-        if (!ngli_darray_push(&s->crafter_uniforms, crafter_uniform))
+        const struct variable_info *var = NULL;
+        if (!ngli_darray_push(&s->crafter_uniforms, crafter_uniform) ||
+            !ngli_darray_push(&s->crafter_uniform_vars, &var))
             return NGL_ERROR_MEMORY;
     }
 
@@ -456,11 +475,13 @@ static int pass_compute_init(struct pass *s)
     return 0;
 }
 
-static int build_uniforms_map(struct pipeline_desc *desc, struct darray *crafter_uniforms)
+static int build_uniforms_map(struct pass *s, struct pipeline_desc *desc)
 {
     ngli_darray_init(&desc->uniforms_map, sizeof(struct uniform_map), 0);
 
-    struct pgcraft_uniform *uniforms = ngli_darray_data(crafter_uniforms);
+    const struct darray *crafter_uniforms = &s->crafter_uniforms;
+    const struct pgcraft_uniform *uniforms = ngli_darray_data(crafter_uniforms);
+    const struct variable_info **vars = ngli_darray_data(&s->crafter_uniform_vars);
     for (size_t i = 0; i < ngli_darray_count(crafter_uniforms); i++) {
         const struct pgcraft_uniform *uniform = &uniforms[i];
         const int32_t index = ngli_pgcraft_get_uniform_index(desc->crafter, uniform->name, uniform->stage);
@@ -475,7 +496,7 @@ static int build_uniforms_map(struct pipeline_desc *desc, struct darray *crafter
         if (!uniform->data)
             continue;
 
-        const struct uniform_map map = {.index=index, .data=uniform->data};
+        const struct uniform_map map = {.index=index, .data=uniform->data, .var=vars[i], .rev=SIZE_MAX};
         if (!ngli_darray_push(&desc->uniforms_map, &map))
             return NGL_ERROR_MEMORY;
     }
@@ -609,7 +630,7 @@ int ngli_pass_prepare(struct pass *s)
     if (ret < 0)
         return ret;
 
-    ret = build_uniforms_map(desc, &s->crafter_uniforms);
+    ret = build_uniforms_map(s, desc);
     if (ret < 0)
         return ret;
 
@@ -633,6 +654,7 @@ int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params
     ngli_darray_init(&s->crafter_attributes, sizeof(struct pgcraft_attribute), 0);
     ngli_darray_init(&s->crafter_textures, sizeof(struct pgcraft_texture), 0);
     ngli_darray_init(&s->crafter_uniforms, sizeof(struct pgcraft_uniform), 0);
+    ngli_darray_init(&s->crafter_uniform_vars, sizeof(const struct variable_info *), 0);
     ngli_darray_init(&s->crafter_blocks, sizeof(struct pgcraft_block), 0);
 
     ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
@@ -669,6 +691,7 @@ void ngli_pass_uninit(struct pass *s)
     ngli_darray_reset(&s->crafter_attributes);
     ngli_darray_reset(&s->crafter_textures);
     ngli_darray_reset(&s->crafter_uniforms);
+    ngli_darray_reset(&s->crafter_uniform_vars);
     ngli_darray_reset(&s->crafter_blocks);
 
     memset(s, 0, sizeof(*s));
@@ -697,7 +720,12 @@ int ngli_pass_exec(struct pass *s)
     const float resolution[2] = {(float)viewport.width, (float)viewport.height};
     ngli_pipeline_compat_update_uniform(pipeline_compat, desc->resolution_index, resolution);
 
-    if (desc->normal_matrix_index >= 0) {
+    /* The inverse transpose is only recomputed when the modelview changes */
+    if (desc->normal_matrix_index >= 0 &&
+        (!desc->has_normal_matrix ||
+         memcmp(desc->normal_modelview_matrix, modelview_matrix, sizeof(desc->normal_modelview_matrix)))) {
+        memcpy(desc->normal_modelview_matrix, modelview_matrix, sizeof(desc->normal_modelview_matrix));
+        desc->has_normal_matrix = 1;
         float normal_matrix[3*3];
         ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
         ngli_mat3_inverse(normal_matrix, normal_matrix);
@@ -705,9 +733,17 @@ int ngli_pass_exec(struct pass *s)
         ngli_pipeline_compat_update_uniform(pipeline_compat, desc->normal_matrix_index, normal_matrix);
     }
 
-    const struct uniform_map *uniform_map = ngli_darray_data(&desc->uniforms_map);
-    for (size_t i = 0; i < ngli_darray_count(&desc->uniforms_map); i++)
+    /* Variables are only written when their revision changed, other uniforms
+     * (buffers) are compared against the previous value by pipeline_compat */
+    struct uniform_map *uniform_map = ngli_darray_data(&desc->uniforms_map);
+    for (size_t i = 0; i < ngli_darray_count(&desc->uniforms_map); i++) {
+        const struct variable_info *var = uniform_map[i].var;
+        if (var && uniform_map[i].rev == var->rev)
+            continue;
         ngli_pipeline_compat_update_uniform(pipeline_compat, uniform_map[i].index, uniform_map[i].data);
+        if (var)
+            uniform_map[i].rev = var->rev;
+    }
 
     const struct darray *texture_infos_array = ngli_pgcraft_get_texture_infos(desc->crafter);
     const struct pgcraft_texture_info *texture_infos = ngli_darray_data(texture_infos_array);
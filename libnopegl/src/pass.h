@@ -73,6 +73,7 @@ struct pass {
     struct pipeline_graphics pipeline_graphics;
     struct darray crafter_attributes;
     struct darray crafter_uniforms;
+    struct darray crafter_uniform_vars; // variable_info of each crafter uniform, if any
     struct darray crafter_textures;
     struct darray crafter_blocks;
     struct darray pipeline_descs;
@@ -19,107 +19,217 @@
  * under the License.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
+#include "log.h"
 #include "memory.h"
-#include "internal.h"
+#include "nopegl.h"
 #include "pgcache.h"
 #include "utils.h"
 
-static void reset_cached_program(void *user_arg, void *data)
+struct pgcache_entry {
+    struct pgcache_key key;
+    char *sources[NGLI_PROGRAM_SHADER_NB]; /* stored once on insertion */
+    struct program *program;
+    struct pgcache_entry *next; /* programs colliding on the same hashes */
+};
+
+static void free_entry(struct pgcache_entry *entry)
 {
-    struct program *p = data;
-    ngli_program_freep(&p);
+    ngli_program_freep(&entry->program);
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        ngli_freep(&entry->sources[i]);
+    ngli_free(entry);
 }
 
-static void reset_cached_frag_map(void *user_arg, void *data)
+static void reset_cached_entry(void *user_arg, void *data)
 {
-    struct hmap *p = data;
-    ngli_hmap_freep(&p);
+    struct pgcache_entry *entry = data;
+    while (entry) {
+        struct pgcache_entry *next = entry->next;
+        free_entry(entry);
+        entry = next;
+    }
 }
 
 int ngli_pgcache_init(struct pgcache *s, struct gpu_ctx *gpu_ctx)
 {
     s->gpu_ctx = gpu_ctx;
-    s->graphics_cache = ngli_hmap_create();
-    s->compute_cache = ngli_hmap_create();
-    if (!s->graphics_cache || !s->compute_cache)
+    s->cache = ngli_hmap_create();
+    if (!s->cache)
         return NGL_ERROR_MEMORY;
-    ngli_hmap_set_free(s->graphics_cache, reset_cached_frag_map, s);
-    ngli_hmap_set_free(s->compute_cache, reset_cached_program, s);
+    ngli_hmap_set_free(s->cache, reset_cached_entry, s);
     return 0;
 }
 
-static int query_cache(struct pgcache *s, struct program **dstp,
-                       struct hmap *cache, const char *cache_key,
-                       const struct program_params *params)
+static void get_sources(const struct program_params *params, const char **sources)
 {
-    struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    sources[NGLI_PROGRAM_SHADER_VERT] = params->vertex;
+    sources[NGLI_PROGRAM_SHADER_FRAG] = params->fragment;
+    sources[NGLI_PROGRAM_SHADER_COMP] = params->compute;
+}
 
-    struct program *cached_program = ngli_hmap_get(cache, cache_key);
-    if (cached_program) {
-        /* make sure the cached program has not been reset by the user */
-        ngli_assert(cached_program->gpu_ctx);
+static int keys_equal(const struct pgcache_key *a, const struct pgcache_key *b)
+{
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        if (a->hash[i] != b->hash[i] || a->size[i] != b->size[i])
+            return 0;
+    return 1;
+}
 
-        *dstp = cached_program;
-        return 0;
+static int sources_equal(const struct pgcache_entry *entry, const char **sources)
+{
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
+        if (!entry->sources[i] != !sources[i])
+            return 0;
+        if (sources[i] && memcmp(entry->sources[i], sources[i], entry->key.size[i]))
+            return 0;
     }
+    return 1;
+}
 
-    /* this is free'd by the reset_cached_program() when destroying the cache */
-    struct program *new_program = ngli_program_create(gpu_ctx);
-    if (!new_program)
-        return NGL_ERROR_MEMORY;
+static struct pgcache_entry *find_entry(struct pgcache_entry *entry,
+                                        const struct pgcache_key *key, const char **sources)
+{
+    /*
+     * Without any collision on these hashes, the key alone identifies the
+     * program and the sources never need to be compared.
+     */
+    if (!entry->next)
+        return keys_equal(&entry->key, key) ? entry : NULL;
 
-    int ret = ngli_program_init(new_program, params);
-    if (ret < 0) {
-        ngli_program_freep(&new_program);
-        return ret;
+    for (; entry; entry = entry->next)
+        if (keys_equal(&entry->key, key) && sources_equal(entry, sources))
+            return entry;
+    return NULL;
+}
+
+static struct pgcache_entry *create_entry(struct pgcache *s, const struct pgcache_key *key,
+                                          const char **sources, const struct program_params *params,
+                                          int *retp)
+{
+    struct pgcache_entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry) {
+        *retp = NGL_ERROR_MEMORY;
+        return NULL;
+    }
+    entry->key = *key;
+
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
+        if (!sources[i])
+            continue;
+        entry->sources[i] = ngli_strdup(sources[i]);
+        if (!entry->sources[i]) {
+            free_entry(entry);
+            *retp = NGL_ERROR_MEMORY;
+            return NULL;
+        }
     }
 
-    ret = ngli_hmap_set(cache, cache_key, new_program);
+    entry->program = ngli_program_create(s->gpu_ctx);
+    if (!entry->program) {
+        free_entry(entry);
+        *retp = NGL_ERROR_MEMORY;
+        return NULL;
+    }
+
+    int ret = ngli_program_init(entry->program, params);
     if (ret < 0) {
-        ngli_program_freep(&new_program);
-        return ret;
+        free_entry(entry);
+        *retp = ret;
+        return NULL;
     }
 
-    *dstp = new_program;
-    return 0;
+    return entry;
 }
 
-int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp, const struct program_params *params)
+static int query_cache(struct pgcache *s, struct program **dstp,
+                       const struct pgcache_key *key,
+                       const struct program_params *params)
 {
-    /*
-     * The first dimension of the graphics_cache hmap is another hmap: what we
-     * do is basically graphics_cache[vert][frag] to obtain the program. If the
-     * 2nd hmap is not yet allocated, we do create a new one here.
-     */
-    struct hmap *frag_map = ngli_hmap_get(s->graphics_cache, params->vertex);
-    if (!frag_map) {
-        frag_map = ngli_hmap_create();
-        if (!frag_map)
-            return NGL_ERROR_MEMORY;
-        ngli_hmap_set_free(frag_map, reset_cached_program, s);
-
-        int ret = ngli_hmap_set(s->graphics_cache, params->vertex, frag_map);
+    /* The map key only carries the hashes, the sizes are checked separately */
+    char cache_key[NGLI_PROGRAM_SHADER_NB * 16 + 1];
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        snprintf(cache_key + i * 16, sizeof(cache_key) - i * 16, "%016" PRIx64, key->hash[i]);
+
+    /* The content hashes are already well distributed, no need to hash the map key again */
+    uint64_t hash = 0;
+    for (size_t i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        hash ^= key->hash[i] + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+
+    const char *sources[NGLI_PROGRAM_SHADER_NB];
+    get_sources(params, sources);
+
+    struct pgcache_entry *cached_entry = ngli_hmap_get_prehashed(s->cache, cache_key, hash);
+    if (cached_entry) {
+        const struct pgcache_entry *entry = find_entry(cached_entry, key, sources);
+        if (entry) {
+            /* make sure the cached program has not been reset by the user */
+            ngli_assert(entry->program->gpu_ctx);
+
+            s->nb_hits++;
+            *dstp = entry->program;
+            return 0;
+        }
+    }
+
+    s->nb_misses++;
+    LOG(DEBUG, "program cache miss on key %s (%zu hits, %zu misses)", cache_key, s->nb_hits, s->nb_misses);
+
+    /* this is free'd by the reset_cached_entry() when destroying the cache */
+    int ret = 0;
+    struct pgcache_entry *new_entry = create_entry(s, key, sources, params, &ret);
+    if (!new_entry)
+        return ret;
+
+    if (cached_entry) {
+        /*
+         * The sources of the colliding program are kept along with the others
+         * so that the next lookups on these hashes compare them and find it
+         * back instead of rebuilding it.
+         */
+        LOG(WARNING, "program cache collision on key %s", cache_key);
+        new_entry->next = cached_entry->next;
+        cached_entry->next = new_entry;
+    } else {
+        ret = ngli_hmap_set_prehashed(s->cache, cache_key, hash, new_entry);
         if (ret < 0) {
-            ngli_hmap_freep(&frag_map);
-            return NGL_ERROR_MEMORY;
+            free_entry(new_entry);
+            return ret;
         }
     }
 
-    return query_cache(s, dstp, frag_map, params->fragment, params);
+    *dstp = new_entry->program;
+    return 0;
+}
+
+int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp,
+                                      const struct pgcache_key *key, const struct program_params *params)
+{
+    ngli_assert(key->size[NGLI_PROGRAM_SHADER_VERT] && key->size[NGLI_PROGRAM_SHADER_FRAG]);
+    return query_cache(s, dstp, key, params);
+}
+
+int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp,
+                                     const struct pgcache_key *key, const struct program_params *params)
+{
+    ngli_assert(key->size[NGLI_PROGRAM_SHADER_COMP]);
+    return query_cache(s, dstp, key, params);
 }
 
-int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp, const struct program_params *params)
+void ngli_pgcache_get_stats(const struct pgcache *s, size_t *nb_hitsp, size_t *nb_missesp)
 {
-    return query_cache(s, dstp, s->compute_cache, params->compute, params);
+    *nb_hitsp = s->nb_hits;
+    *nb_missesp = s->nb_misses;
 }
 
 void ngli_pgcache_reset(struct pgcache *s)
 {
     if (!s->gpu_ctx)
         return;
-    ngli_hmap_freep(&s->compute_cache);
-    ngli_hmap_freep(&s->graphics_cache);
+    LOG(DEBUG, "program cache: %zu hits, %zu misses", s->nb_hits, s->nb_misses);
+    ngli_hmap_freep(&s->cache);
     memset(s, 0, sizeof(*s));
 }
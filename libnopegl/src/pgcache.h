@@ -22,18 +22,36 @@
 #ifndef PGCACHE_H
 #define PGCACHE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "hmap.h"
 #include "program.h"
 
+/*
+ * Fixed-size identifier of a program: the 64-bit hash and the size of the
+ * source of every shader stage (unused stages are left zeroed). The hashes are
+ * computed incrementally while the shaders are crafted (see ngli_bstr_hash())
+ * so that looking up the cache never needs another pass over the sources.
+ */
+struct pgcache_key {
+    uint64_t hash[NGLI_PROGRAM_SHADER_NB];
+    size_t size[NGLI_PROGRAM_SHADER_NB];
+};
+
 struct pgcache {
     struct gpu_ctx *gpu_ctx;
-    struct hmap *graphics_cache;
-    struct hmap *compute_cache;
+    struct hmap *cache;
+    size_t nb_hits;
+    size_t nb_misses;
 };
 
 int ngli_pgcache_init(struct pgcache *s, struct gpu_ctx *ctx);
-int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp, const struct program_params *params);
-int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp, const struct program_params *params);
+int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp,
+                                      const struct pgcache_key *key, const struct program_params *params);
+int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp,
+                                     const struct pgcache_key *key, const struct program_params *params);
+void ngli_pgcache_get_stats(const struct pgcache *s, size_t *nb_hitsp, size_t *nb_missesp);
 void ngli_pgcache_reset(struct pgcache *s);
 
 #endif
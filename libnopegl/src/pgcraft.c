@@ -37,6 +37,9 @@
 #include "type.h"
 #include "utils.h"
 
+/* GLSL fragments as string */
+#include "helper_hdr_glsl.h"
+
 #if defined(BACKEND_GL) || defined(BACKEND_GLES)
 #include "backends/gl/gpu_ctx_gl.h"
 #include "backends/gl/feature_gl.h"
@@ -294,6 +297,7 @@ static const char * const texture_info_suffixes[NGLI_INFO_FIELD_NB] = {
     [NGLI_INFO_FIELD_SAMPLING_MODE]     = "_sampling_mode",
     [NGLI_INFO_FIELD_COORDINATE_MATRIX] = "_coord_matrix",
     [NGLI_INFO_FIELD_COLOR_MATRIX]      = "_color_matrix",
+    [NGLI_INFO_FIELD_TONEMAP]           = "_tonemap",
     [NGLI_INFO_FIELD_DIMENSIONS]        = "_dimensions",
     [NGLI_INFO_FIELD_TIMESTAMP]         = "_ts",
     [NGLI_INFO_FIELD_SAMPLER_0]         = "",
@@ -310,6 +314,7 @@ static const int texture_types_map[NGLI_PGCRAFT_SHADER_TEX_TYPE_NB][NGLI_INFO_FI
         [NGLI_INFO_FIELD_DIMENSIONS]        = NGLI_TYPE_VEC2,
         [NGLI_INFO_FIELD_TIMESTAMP]         = NGLI_TYPE_F32,
         [NGLI_INFO_FIELD_COLOR_MATRIX]      = NGLI_TYPE_MAT4,
+        [NGLI_INFO_FIELD_TONEMAP]           = NGLI_TYPE_I32,
         [NGLI_INFO_FIELD_SAMPLING_MODE]     = NGLI_TYPE_I32,
         [NGLI_INFO_FIELD_SAMPLER_0]         = NGLI_TYPE_SAMPLER_2D,
         [NGLI_INFO_FIELD_SAMPLER_1]         = NGLI_TYPE_SAMPLER_2D,
@@ -518,6 +523,7 @@ static int inject_texture_info(struct pgcraft *s, struct pgcraft_texture_info *i
 
 static int inject_texture_infos(struct pgcraft *s, const struct pgcraft_params *params, int stage)
 {
+    int need_tonemap = 0;
     struct darray *texture_infos_array = &s->texture_infos;
     struct pgcraft_texture_info *texture_infos = ngli_darray_data(texture_infos_array);
     for (size_t i = 0; i < ngli_darray_count(texture_infos_array); i++) {
@@ -525,7 +531,15 @@ static int inject_texture_infos(struct pgcraft *s, const struct pgcraft_params *
         int ret = inject_texture_info(s, info, stage);
         if (ret < 0)
             return ret;
+        const struct pgcraft_texture_info_field *field = &info->fields[NGLI_INFO_FIELD_TONEMAP];
+        if (field->type != NGLI_TYPE_NONE && field->stage == stage)
+            need_tonemap = 1;
     }
+
+    /* HDR to SDR conversion helpers used by ngl_texvideo() */
+    if (need_tonemap)
+        ngli_bstr_print(s->shaders[stage], helper_hdr_glsl);
+
     return 0;
 }
 
@@ -893,6 +907,12 @@ static int handle_token(struct pgcraft *s, const struct pgcraft_params *params,
         if (clamp)
             ngli_bstr_print(dst, "clamp(");
 
+        /*
+         * The HDR to SDR conversion is fused in the sampling instead of
+         * requiring an intermediate conversion pass
+         */
+        ngli_bstr_print(dst, "ngli_texvideo_tonemap(");
+
         ngli_bstr_print(dst, "(");
 
         if (ngli_hwmap_is_image_layout_supported(config->backend, NGLI_IMAGE_LAYOUT_MEDIACODEC)) {
@@ -943,6 +963,7 @@ static int handle_token(struct pgcraft *s, const struct pgcraft_params *params,
         }
 
         ngli_bstr_print(dst, ")");
+        ngli_bstr_printf(dst, ", %.*s_tonemap)", ARG_FMT(arg0));
         if (clamp)
             ngli_bstr_print(dst, ", 0.0, 1.0)");
         ngli_bstr_print(dst, p);
@@ -1446,6 +1467,13 @@ static int alloc_shader(struct pgcraft *s, int stage)
     return 0;
 }
 
+static void set_cache_key_shader(const struct pgcraft *s, struct pgcache_key *key, int stage)
+{
+    const struct bstr *b = s->shaders[stage];
+    key->hash[stage] = ngli_bstr_hash(b);
+    key->size[stage] = ngli_bstr_len(b);
+}
+
 static int get_program_compute(struct pgcraft *s, const struct pgcraft_params *params)
 {
     int ret;
@@ -1459,7 +1487,9 @@ static int get_program_compute(struct pgcraft *s, const struct pgcraft_params *p
         .label   = params->program_label,
         .compute = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_COMP]),
     };
-    ret = ngli_pgcache_get_compute_program(&s->ctx->pgcache, &s->program, &program_params);
+    struct pgcache_key key = {0};
+    set_cache_key_shader(s, &key, NGLI_PROGRAM_SHADER_COMP);
+    ret = ngli_pgcache_get_compute_program(&s->ctx->pgcache, &s->program, &key, &program_params);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_COMP]);
     return ret;
 }
@@ -1487,7 +1517,10 @@ static int get_program_graphics(struct pgcraft *s, const struct pgcraft_params *
         .vertex   = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_VERT]),
         .fragment = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_FRAG]),
     };
-    ret = ngli_pgcache_get_graphics_program(&s->ctx->pgcache, &s->program, &program_params);
+    struct pgcache_key key = {0};
+    set_cache_key_shader(s, &key, NGLI_PROGRAM_SHADER_VERT);
+    set_cache_key_shader(s, &key, NGLI_PROGRAM_SHADER_FRAG);
+    ret = ngli_pgcache_get_graphics_program(&s->ctx->pgcache, &s->program, &key, &program_params);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_VERT]);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_FRAG]);
     return ret;
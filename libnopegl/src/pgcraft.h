@@ -128,6 +128,7 @@ enum {
     NGLI_INFO_FIELD_SAMPLING_MODE,
     NGLI_INFO_FIELD_COORDINATE_MATRIX,
     NGLI_INFO_FIELD_COLOR_MATRIX,
+    NGLI_INFO_FIELD_TONEMAP,
     NGLI_INFO_FIELD_DIMENSIONS,
     NGLI_INFO_FIELD_TIMESTAMP,
     NGLI_INFO_FIELD_SAMPLER_0,
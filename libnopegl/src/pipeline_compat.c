@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <string.h>
+
 #include "darray.h"
 #include "gpu_ctx.h"
 #include "gpu_limits.h"
@@ -35,6 +37,7 @@ struct pipeline_compat {
     const struct pgcraft_compat_info *compat_info;
     struct buffer *ubuffers[NGLI_PROGRAM_SHADER_NB];
     uint8_t *mapped_datas[NGLI_PROGRAM_SHADER_NB];
+    uint8_t *shadow_datas[NGLI_PROGRAM_SHADER_NB];
 };
 
 static int map_buffer(struct pipeline_compat *s, int stage)
@@ -87,10 +90,22 @@ static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_
         if (ret < 0)
             return ret;
 
-        if (gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT) {
-            ret = ngli_buffer_map(buffer, buffer->size, 0, (void **)&s->mapped_datas[i]);
-            if (ret < 0)
-                return ret;
+        /*
+         * Keep a CPU copy of the uniform block so that writing an unchanged
+         * value is a no-op (and does not even require mapping the buffer).
+         * Both copies start zeroed to be in sync.
+         */
+        s->shadow_datas[i] = ngli_calloc(1, block_size);
+        if (!s->shadow_datas[i])
+            return NGL_ERROR_MEMORY;
+
+        ret = ngli_buffer_map(buffer, buffer->size, 0, (void **)&s->mapped_datas[i]);
+        if (ret < 0)
+            return ret;
+        memset(s->mapped_datas[i], 0, block_size);
+        if (!(gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT)) {
+            ngli_buffer_unmap(buffer);
+            s->mapped_datas[i] = NULL;
         }
 
         ngli_pipeline_update_buffer(s->pipeline, s->compat_info->uindices[i], buffer, 0, buffer->size);
@@ -154,6 +169,11 @@ int ngli_pipeline_compat_update_uniform(struct pipeline_compat *s, int32_t index
     const struct block_field *fields = ngli_darray_data(&block->fields);
     const struct block_field *field = &fields[field_index];
     if (value) {
+        uint8_t *shadow = s->shadow_datas[stage] + field->offset;
+        if (ngli_block_field_equal(field, shadow, value))
+            return 0;
+        ngli_block_field_copy(field, shadow, value);
+
         if (!(gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT)) {
             int ret = map_buffer(s, stage);
             if (ret < 0)
@@ -183,6 +203,7 @@ void ngli_pipeline_compat_update_texture_info(struct pipeline_compat *s, const s
 
     ngli_pipeline_compat_update_uniform(s, fields[NGLI_INFO_FIELD_COORDINATE_MATRIX].index, image->coordinates_matrix);
     ngli_pipeline_compat_update_uniform(s, fields[NGLI_INFO_FIELD_COLOR_MATRIX].index, image->color_matrix);
+    ngli_pipeline_compat_update_uniform(s, fields[NGLI_INFO_FIELD_TONEMAP].index, &image->tonemap);
     ngli_pipeline_compat_update_uniform(s, fields[NGLI_INFO_FIELD_TIMESTAMP].index, &image->ts);
 
     if (image->params.layout) {
@@ -299,6 +320,7 @@ void ngli_pipeline_compat_freep(struct pipeline_compat **sp)
                     ngli_buffer_unmap(s->ubuffers[i]);
                 ngli_buffer_freep(&s->ubuffers[i]);
             }
+            ngli_freep(&s->shadow_datas[i]);
         }
     }
     ngli_freep(sp);
@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include "filemap.h"
 #include "nopegl.h"
 #include "internal.h"
 #include "memory.h"
@@ -49,11 +50,40 @@ int ngl_scene_init_from_str(struct ngl_scene *s, const char *str)
     return ngli_scene_deserialize(s, str);
 }
 
+int ngl_scene_init_from_mem(struct ngl_scene *s, const void *data, size_t size)
+{
+    ngl_node_unrefp(&s->root);
+    return ngli_scene_deserialize_mem(s, data, size);
+}
+
+int ngl_scene_init_from_file(struct ngl_scene *s, const char *filename)
+{
+    ngl_node_unrefp(&s->root);
+
+    struct filemap filemap;
+    int ret = ngli_filemap_open(&filemap, filename);
+    if (ret < 0)
+        return ret;
+    ret = ngli_scene_deserialize_mem(s, filemap.data, filemap.size);
+    ngli_filemap_close(&filemap);
+    return ret;
+}
+
+int ngl_scene_apply_patch(struct ngl_scene *s, const char *patch)
+{
+    return ngli_scene_apply_patch(s, patch);
+}
+
 char *ngl_scene_serialize(const struct ngl_scene *s)
 {
     return ngli_scene_serialize(s);
 }
 
+void *ngl_scene_serialize_binary(const struct ngl_scene *s, size_t *sizep)
+{
+    return ngli_scene_serialize_binary(s, sizep);
+}
+
 char *ngl_scene_dot(const struct ngl_scene *s)
 {
     return ngli_scene_dot(s);
@@ -29,6 +29,7 @@
 #include "memory.h"
 #include "internal.h"
 #include "nopegl.h"
+#include "serialize.h"
 #include "utils.h"
 
 extern const struct node_param ngli_base_node_params[];
@@ -39,8 +40,12 @@ static void free_func(void *arg, void *data)
 }
 
 static int register_node(struct hmap *nlist,
-                          const struct ngl_node *node)
+                         struct darray *nodes,
+                         const struct ngl_node *node)
 {
+    if (nodes && !ngli_darray_push(nodes, &node))
+        return NGL_ERROR_MEMORY;
+
     char key[32];
     int ret = snprintf(key, sizeof(key), "%p", node);
     if (ret < 0)
@@ -207,15 +212,24 @@ static void serialize_str(struct bstr *b, const uint8_t *srcp,
             ngli_bstr_printf(b, "%%%02x", s[i] & 0xff);
 }
 
-static void serialize_data(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static int serialize_data(struct bstr *b, const uint8_t *srcp,
+                          const struct node_param *par, struct darray *blobs)
 {
     const uint8_t *data = *(uint8_t **)srcp;
     const size_t size = *(size_t *)(srcp + sizeof(uint8_t *));
     if (!data || !size)
-        return;
+        return 0;
+    if (blobs) {
+        const struct serialize_blob blob = {.data = data, .size = size};
+        if (!ngli_darray_push(blobs, &blob))
+            return NGL_ERROR_MEMORY;
+        ngli_bstr_printf(b, " %s:@%zx", par->key, ngli_darray_count(blobs) - 1);
+        return 0;
+    }
     ngli_bstr_printf(b, " %s:%zu,", par->key, size);
     for (size_t i = 0; i < size; i++)
         ngli_bstr_printf(b, "%02x", data[i]);
+    return 0;
 }
 
 static void serialize_ivec(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
@@ -320,6 +334,7 @@ static int serialize_nodedict(struct bstr *b, const uint8_t *srcp,
 }
 
 static int serialize_options(struct hmap *nlist,
+                             struct darray *blobs,
                              struct bstr *b,
                              const struct ngl_node *node,
                              uint8_t *priv,
@@ -354,7 +369,7 @@ static int serialize_options(struct hmap *nlist,
         case NGLI_PARAM_TYPE_F64:       serialize_f64(b, srcp, p);                      break;
         case NGLI_PARAM_TYPE_RATIONAL:  serialize_rational(b, srcp, p);                 break;
         case NGLI_PARAM_TYPE_STR:       serialize_str(b, srcp, p, label);               break;
-        case NGLI_PARAM_TYPE_DATA:      serialize_data(b, srcp, p);                     break;
+        case NGLI_PARAM_TYPE_DATA:      ret = serialize_data(b, srcp, p, blobs);        break;
         case NGLI_PARAM_TYPE_IVEC2:
         case NGLI_PARAM_TYPE_IVEC3:
         case NGLI_PARAM_TYPE_IVEC4:     serialize_ivec(b, srcp, p);                     break;
@@ -381,10 +396,14 @@ static int serialize_options(struct hmap *nlist,
 }
 
 static int serialize(struct hmap *nlist,
+                     struct darray *nodes,
+                     struct darray *blobs,
                      struct bstr *b,
                      const struct ngl_node *node);
 
 static int serialize_children(struct hmap *nlist,
+                               struct darray *nodes,
+                               struct darray *blobs,
                                struct bstr *b,
                                const struct ngl_node *node,
                                uint8_t *priv,
@@ -400,7 +419,7 @@ static int serialize_children(struct hmap *nlist,
             case NGLI_PARAM_TYPE_NODE: {
                 const struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize(nlist, nodes, blobs, b, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -411,7 +430,7 @@ static int serialize_children(struct hmap *nlist,
                 const size_t nb_children = *(size_t *)(srcp + sizeof(struct ngl_node **));
 
                 for (size_t i = 0; i < nb_children; i++) {
-                    int ret = serialize(nlist, b, children[i]);
+                    int ret = serialize(nlist, nodes, blobs, b, children[i]);
                     if (ret < 0)
                         return ret;
                 }
@@ -432,7 +451,7 @@ static int serialize_children(struct hmap *nlist,
                 const struct item *items = ngli_darray_data(&items_array);
                 for (size_t i = 0; i < ngli_darray_count(&items_array); i++) {
                     const struct item *item = &items[i];
-                    int ret = serialize(nlist, b, item->data);
+                    int ret = serialize(nlist, nodes, blobs, b, item->data);
                     if (ret < 0) {
                         ngli_darray_reset(&items_array);
                         return ret;
@@ -446,7 +465,7 @@ static int serialize_children(struct hmap *nlist,
                     break;
                 struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize(nlist, nodes, blobs, b, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -459,6 +478,8 @@ static int serialize_children(struct hmap *nlist,
 }
 
 static int serialize(struct hmap *nlist,
+                     struct darray *nodes,
+                     struct darray *blobs,
                      struct bstr *b,
                      const struct ngl_node *node)
 {
@@ -467,8 +488,8 @@ static int serialize(struct hmap *nlist,
 
     int ret;
 
-    if ((ret = serialize_children(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
-        (ret = serialize_children(nlist, b, node, node->opts, node->cls->params)) < 0)
+    if ((ret = serialize_children(nlist, nodes, blobs, b, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children(nlist, nodes, blobs, b, node, node->opts, node->cls->params)) < 0)
         return ret;
 
     const uint32_t tag = node->cls->id;
@@ -477,22 +498,22 @@ static int serialize(struct hmap *nlist,
                     tag >> 16 & 0xff,
                     tag >>  8 & 0xff,
                     tag       & 0xff);
-    if ((ret = serialize_options(nlist, b, node, node->opts, node->cls->params)) < 0 ||
-        (ret = serialize_options(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0)
+    if ((ret = serialize_options(nlist, blobs, b, node, node->opts, node->cls->params)) < 0 ||
+        (ret = serialize_options(nlist, blobs, b, node, (uint8_t *)node, ngli_base_node_params)) < 0)
         return ret;
 
     ngli_bstr_print(b, "\n");
 
-    return register_node(nlist, node);
+    return register_node(nlist, nodes, node);
 }
 
-char *ngli_scene_serialize(const struct ngl_scene *scene)
+static struct bstr *serialize_scene(const struct ngl_scene *scene, struct darray *nodes,
+                                    struct darray *blobs)
 {
-    char *s = NULL;
     struct hmap *nlist = ngli_hmap_create();
     struct bstr *b = ngli_bstr_create();
     if (!nlist || !b)
-        goto end;
+        goto fail;
 
     /* Write header */
     ngli_hmap_set_free(nlist, free_func, NULL);
@@ -507,12 +528,90 @@ char *ngli_scene_serialize(const struct ngl_scene *scene)
     ngli_bstr_printf(b, "# framerate=%d/%d\n", scene->framerate[0], scene->framerate[1]);
 
     /* Write nodes (1 line = 1 node) */
-    if (serialize(nlist, b, scene->root) < 0)
-        goto end;
-    s = ngli_bstr_strdup(b);
+    if (serialize(nlist, nodes, blobs, b, scene->root) < 0)
+        goto fail;
 
-end:
     ngli_hmap_freep(&nlist);
+    return b;
+
+fail:
+    ngli_hmap_freep(&nlist);
+    ngli_bstr_freep(&b);
+    return NULL;
+}
+
+char *ngli_scene_serialize(const struct ngl_scene *scene)
+{
+    struct bstr *b = serialize_scene(scene, NULL, NULL);
+    if (!b)
+        return NULL;
+    char *s = ngli_bstr_strdup(b);
     ngli_bstr_freep(&b);
     return s;
 }
+
+int ngli_scene_get_nodes(const struct ngl_scene *scene, struct darray *nodes)
+{
+    /* The data parameters are referenced as blobs to avoid their encoding */
+    struct darray blobs;
+    ngli_darray_init(&blobs, sizeof(struct serialize_blob), 0);
+    struct bstr *b = serialize_scene(scene, nodes, &blobs);
+    ngli_darray_reset(&blobs);
+    if (!b)
+        return NGL_ERROR_MEMORY;
+    ngli_bstr_freep(&b);
+    return 0;
+}
+
+void *ngli_scene_serialize_binary(const struct ngl_scene *scene, size_t *sizep)
+{
+    uint8_t *data = NULL;
+    struct darray blobs;
+    ngli_darray_init(&blobs, sizeof(struct serialize_blob), 0);
+
+    struct bstr *b = serialize_scene(scene, NULL, &blobs);
+    if (!b)
+        goto end;
+
+    const struct serialize_blob *blob_list = ngli_darray_data(&blobs);
+    const size_t nb_blobs = ngli_darray_count(&blobs);
+    const size_t nodes_offset = sizeof(struct serialize_header);
+    const size_t nodes_size = ngli_bstr_len(b);
+    const size_t blobs_offset = NGLI_ALIGN(nodes_offset + nodes_size, sizeof(uint64_t));
+
+    size_t size = blobs_offset + nb_blobs * sizeof(struct serialize_blob_entry);
+    for (size_t i = 0; i < nb_blobs; i++)
+        size = NGLI_ALIGN(size, SERIALIZE_BLOB_ALIGN) + blob_list[i].size;
+
+    data = ngli_calloc(1, size);
+    if (!data)
+        goto end;
+
+    const struct serialize_header header = {
+        .magic        = SERIALIZE_MAGIC,
+        .version      = SERIALIZE_VERSION,
+        .nodes_offset = nodes_offset,
+        .nodes_size   = nodes_size,
+        .blobs_offset = blobs_offset,
+        .nb_blobs     = nb_blobs,
+    };
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + nodes_offset, ngli_bstr_strptr(b), nodes_size);
+
+    /* Blob index followed by the raw payloads */
+    struct serialize_blob_entry *entries = (struct serialize_blob_entry *)(data + blobs_offset);
+    size_t offset = blobs_offset + nb_blobs * sizeof(*entries);
+    for (size_t i = 0; i < nb_blobs; i++) {
+        offset = NGLI_ALIGN(offset, SERIALIZE_BLOB_ALIGN);
+        entries[i].offset = offset;
+        entries[i].size   = blob_list[i].size;
+        memcpy(data + offset, blob_list[i].data, blob_list[i].size);
+        offset += blob_list[i].size;
+    }
+    *sizep = size;
+
+end:
+    ngli_bstr_freep(&b);
+    ngli_darray_reset(&blobs);
+    return data;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nopegl.h"
+
+/*
+ * Binary scene container
+ *
+ * The node table is the regular text serialization (header, metadata and 1
+ * line per node) except for the data parameters which are written as
+ * "key:@<blob index>" instead of being hex encoded inline. The raw payloads
+ * are stored in separate blob sections, each of them aligned so that they can
+ * be accessed directly from a memory mapping of the file.
+ *
+ * Layout:
+ *   struct serialize_header
+ *   node table (nodes_size bytes, not NUL terminated)
+ *   blob index (nb_blobs x struct serialize_blob_entry)
+ *   blobs (each starting at a SERIALIZE_BLOB_ALIGN boundary)
+ *
+ * All integers are stored in native byte order.
+ */
+#define SERIALIZE_MAGIC      NGLI_FOURCC('N','G','L','B')
+#define SERIALIZE_VERSION    1
+#define SERIALIZE_BLOB_ALIGN 64
+
+struct serialize_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t nodes_offset;
+    uint64_t nodes_size;
+    uint64_t blobs_offset;
+    uint64_t nb_blobs;
+};
+
+struct serialize_blob_entry {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct serialize_blob {
+    const uint8_t *data;
+    size_t size;
+};
+
+#endif
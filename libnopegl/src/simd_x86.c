@@ -73,3 +73,26 @@ void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 
     _mm_store_ps(dst, r);
 }
+
+void ngli_vec_lerp_sse(float *dst, const float *v1, const float *v2, float c, size_t n)
+{
+    const __m128 c0 = _mm_set1_ps(1.f - c);
+    const __m128 c1 = _mm_set1_ps(c);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a0 = _mm_loadu_ps(v1 + i);
+        __m128 a1 = _mm_loadu_ps(v1 + i + 4);
+        __m128 b0 = _mm_loadu_ps(v2 + i);
+        __m128 b1 = _mm_loadu_ps(v2 + i + 4);
+        _mm_storeu_ps(dst + i,     _mm_add_ps(_mm_mul_ps(a0, c0), _mm_mul_ps(b0, c1)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_mul_ps(a1, c0), _mm_mul_ps(b1, c1)));
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m128 a = _mm_loadu_ps(v1 + i);
+        __m128 b = _mm_loadu_ps(v2 + i);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(a, c0), _mm_mul_ps(b, c1)));
+    }
+    for (; i < n; i++)
+        dst[i] = NGLI_MIX_F32(v1[i], v2[i], c);
+}
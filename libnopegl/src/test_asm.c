@@ -95,5 +95,21 @@ int main(void)
         flt_check(v_diff, 4);
     }
 
+    /* Cover the vectorized loops as well as the scalar tail */
+    float v1[40], v2[40];
+    for (size_t i = 0; i < NGLI_ARRAY_NB(v1); i++) {
+        v1[i] = m1[i % 16] * (float)(i + 1);
+        v2[i] = m2[i % 16] - (float)i;
+    }
+    for (size_t n = 0; n <= NGLI_ARRAY_NB(v1); n++) {
+        printf(":: Testing vec lerp of %zu floats\n", n);
+
+        float v_ref[40], v_out[40], v_diff[40];
+        ngli_vec_lerp_c(v_ref, v1, v2, 0.37f, n);
+        ngli_vec_lerp(v_out, v1, v2, 0.37f, n);
+        flt_diff(v_diff, v_ref, v_out, n);
+        flt_check(v_diff, n);
+    }
+
     return 0;
 }
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "diskcache.h"
+#include "memory.h"
+#include "nopegl.h"
+#include "utils.h"
+
+#define NS "test_diskcache"
+
+/* Offset of the data size in the entry header */
+#define DATA_SIZE_OFFSET 16
+
+static const char key[] = "entry key";
+static const char other_key[] = "other key";
+static const char data[] = "entry data";
+
+static char *get_path(const char *dir)
+{
+    const uint32_t hash = ngli_crc32_mem((const uint8_t *)key, sizeof(key));
+    char *path = ngli_asprintf("%s/%s-%08x.bin", dir, NS, hash);
+    ngli_assert(path);
+    return path;
+}
+
+static void store_entry(const char *dir)
+{
+    ngli_assert(ngli_diskcache_store(dir, NS, key, sizeof(key), data, sizeof(data)) == 0);
+}
+
+static int load_entry(const char *dir, const void *k, size_t k_size)
+{
+    void *loaded = NULL;
+    size_t size = 0;
+    int ret = ngli_diskcache_load(dir, NS, k, k_size, &loaded, &size);
+    if (ret == 0) {
+        ngli_assert(size == sizeof(data));
+        ngli_assert(!memcmp(loaded, data, size));
+        ngli_free(loaded);
+    }
+    return ret;
+}
+
+static void set_data_size(const char *path, uint64_t data_size)
+{
+    FILE *fp = fopen(path, "r+b");
+    ngli_assert(fp);
+    ngli_assert(fseek(fp, DATA_SIZE_OFFSET, SEEK_SET) == 0);
+    ngli_assert(fwrite(&data_size, 1, sizeof(data_size), fp) == sizeof(data_size));
+    ngli_assert(fclose(fp) == 0);
+}
+
+static void truncate_entry(const char *path, size_t size)
+{
+    FILE *fp = fopen(path, "rb");
+    ngli_assert(fp);
+    char buf[256];
+    const size_t nb_read = fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+    ngli_assert(size < nb_read);
+
+    fp = fopen(path, "wb");
+    ngli_assert(fp);
+    ngli_assert(fwrite(buf, 1, size, fp) == size);
+    ngli_assert(fclose(fp) == 0);
+}
+
+int main(int ac, char **av)
+{
+    const char *dir = ac > 1 ? av[1] : ".";
+    char *path = get_path(dir);
+
+    /* Miss, store and hit */
+    remove(path);
+    ngli_assert(load_entry(dir, key, sizeof(key)) == NGL_ERROR_NOT_FOUND);
+    store_entry(dir);
+    ngli_assert(load_entry(dir, key, sizeof(key)) == 0);
+
+    /* Colliding file name with a different key */
+    ngli_assert(load_entry(dir, other_key, sizeof(other_key)) == NGL_ERROR_NOT_FOUND);
+
+    /* Corrupted data sizes must be a miss and must not be allocated */
+    const uint64_t data_sizes[] = {UINT64_MAX, SIZE_MAX, 1ULL << 40, sizeof(data) + 1, sizeof(data) - 1, 0};
+    for (size_t i = 0; i < NGLI_ARRAY_NB(data_sizes); i++) {
+        store_entry(dir);
+        set_data_size(path, data_sizes[i]);
+        ngli_assert(load_entry(dir, key, sizeof(key)) == NGL_ERROR_NOT_FOUND);
+    }
+
+    /* Truncated entries, in the header, the key and the data */
+    const size_t truncated_sizes[] = {0, DATA_SIZE_OFFSET, 24 + sizeof(key) / 2, 24 + sizeof(key) + 1};
+    for (size_t i = 0; i < NGLI_ARRAY_NB(truncated_sizes); i++) {
+        store_entry(dir);
+        truncate_entry(path, truncated_sizes[i]);
+        ngli_assert(load_entry(dir, key, sizeof(key)) == NGL_ERROR_NOT_FOUND);
+    }
+
+    /* The entry can be stored again after being corrupted */
+    store_entry(dir);
+    ngli_assert(load_entry(dir, key, sizeof(key)) == 0);
+
+    remove(path);
+    ngli_free(path);
+    return 0;
+}
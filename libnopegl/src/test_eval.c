@@ -22,6 +22,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "eval.h"
 #include "hmap.h"
@@ -74,6 +75,7 @@ static const struct test_expr expressions[] = {
     {1, "", 0.f},
     {1, "((3))", 3.f},
     {1, "(-(((-3)+(-4))+(1)))", 6.f},
+    {1, "(x+y)*(x+y) - (x+y)", 51.101556f},
     {1, "+tan(-sin(+cos(-pi)))", 1.1189396031849523f},
     {1, "--+-1", -1.f},
     {1, "-.777", -.777f},
@@ -108,6 +110,7 @@ static const struct test_expr expressions[] = {
     {1, "mod_t(-7.2, 5.3)", -1.9f},
     {1, "mod_t(7.2, -5.3)", 1.9f},
     {1, "mod_t(-7.2, -5.3)", -1.9f},
+    {1, "sin(x)*sin(x) + cos(x)*cos(x)", 1.f},
     {1, "smooth(1.3, 5.1, 6.4)", 0.568814f},
     {1, "smoothstep(1.3, 5.1, 6.4)", 1.f},
     {1, "smoothstep(x, -z, 1/2)", 0.501536f},
@@ -116,9 +119,54 @@ static const struct test_expr expressions[] = {
     {1, "z", 0.231f},
 };
 
-static const float vars_data[] = {1.234f, -7.9f, 0.231f};
+static float vars_data[] = {1.234f, -7.9f, 0.231f};
 
-static int test_expr(const struct hmap *vars, const struct test_expr *test_e)
+#define NB_VALUES 19
+static float vars_arrays[3][NB_VALUES];
+
+/* Evaluate the expression over arrays and compare against the scalar path */
+static int test_expr_n(const struct hmap *vars, const struct hmap *vars_n, const char *expr)
+{
+    int ret;
+    struct eval *e = ngli_eval_create();
+    struct eval *e_n = ngli_eval_create();
+    if (!e || !e_n) {
+        ret = -1;
+        goto end;
+    }
+
+    if ((ret = ngli_eval_init(e, expr, vars)) < 0 ||
+        (ret = ngli_eval_init(e_n, expr, vars_n)) < 0)
+        goto end;
+
+    float res_n[NB_VALUES];
+    ret = ngli_eval_run_n(e_n, res_n, NB_VALUES);
+    if (ret < 0)
+        goto end;
+
+    const float saved_data[] = {vars_data[0], vars_data[1], vars_data[2]};
+    for (size_t i = 0; i < NB_VALUES; i++) {
+        for (size_t j = 0; j < NGLI_ARRAY_NB(vars_data); j++)
+            vars_data[j] = vars_arrays[j][i];
+        float f;
+        ret = ngli_eval_run(e, &f);
+        if (ret < 0)
+            break;
+        if (memcmp(&f, &res_n[i], sizeof(f))) {
+            fprintf(stderr, "E: \"%s\" evaluates to %g but got %g at index %zu\n", expr, f, res_n[i], i);
+            ret = -1;
+            break;
+        }
+    }
+    memcpy(vars_data, saved_data, sizeof(saved_data));
+
+end:
+    ngli_eval_freep(&e_n);
+    ngli_eval_freep(&e);
+    return ret;
+}
+
+static int test_expr(const struct hmap *vars, const struct hmap *vars_n, const struct test_expr *test_e)
 {
     int ret = 0;
     struct eval *e = ngli_eval_create();
@@ -156,6 +204,10 @@ static int test_expr(const struct hmap *vars, const struct test_expr *test_e)
         goto end;
     }
 
+    ret = test_expr_n(vars, vars_n, expr);
+    if (ret < 0)
+        goto end;
+
     printf("[OK] \"%s = %g\"\n", expr, f);
 
 end:
@@ -166,20 +218,30 @@ end:
 int main(int ac, char **av)
 {
 
+    int ret = 1;
     struct hmap *vars = ngli_hmap_create();
-    if (!vars)
-        return 1;
+    struct hmap *vars_n = ngli_hmap_create();
+    if (!vars || !vars_n)
+        goto end;
 
-    int ret;
-    if ((ret = ngli_hmap_set(vars, "x", (void *)&vars_data[0])) < 0 ||
-        (ret = ngli_hmap_set(vars, "y", (void *)&vars_data[1])) < 0 ||
-        (ret = ngli_hmap_set(vars, "z", (void *)&vars_data[2])) < 0)
+    for (size_t i = 0; i < NB_VALUES; i++) {
+        vars_arrays[0][i] = vars_data[0] + (float)i * 0.37f;
+        vars_arrays[1][i] = vars_data[1] - (float)i * 1.1f;
+        vars_arrays[2][i] = vars_data[2] * (float)i;
+    }
+
+    if ((ret = ngli_hmap_set(vars, "x", &vars_data[0])) < 0 ||
+        (ret = ngli_hmap_set(vars, "y", &vars_data[1])) < 0 ||
+        (ret = ngli_hmap_set(vars, "z", &vars_data[2])) < 0 ||
+        (ret = ngli_hmap_set(vars_n, "x", vars_arrays[0])) < 0 ||
+        (ret = ngli_hmap_set(vars_n, "y", vars_arrays[1])) < 0 ||
+        (ret = ngli_hmap_set(vars_n, "z", vars_arrays[2])) < 0)
         goto end;
 
     size_t failed = 0;
     static const size_t nb_expr = NGLI_ARRAY_NB(expressions);
     for (size_t i = 0; i < nb_expr; i++)
-        failed += test_expr(vars, &expressions[i]) < 0;
+        failed += test_expr(vars, vars_n, &expressions[i]) < 0;
 
     if (failed) {
         fprintf(stderr, "%zu/%zu failed test(s)\n", failed, nb_expr);
@@ -189,6 +251,7 @@ int main(int ac, char **av)
     }
 
 end:
+    ngli_hmap_freep(&vars_n);
     ngli_hmap_freep(&vars);
     return ret;
 }
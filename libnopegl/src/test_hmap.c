@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #define HMAP_SIZE_NBIT 1
@@ -88,6 +90,90 @@ static int test_bucket_delete_reuse(void)
     return 0;
 }
 
+static int test_prehashed(void)
+{
+    struct hmap *hm = ngli_hmap_create();
+    if (!hm)
+        return -1;
+    for (size_t i = 0; i < NGLI_ARRAY_NB(kvs); i++) {
+        const uint64_t hash = ngli_hmap_hash_key(kvs[i].key);
+        ngli_assert(ngli_hmap_set_prehashed(hm, kvs[i].key, hash, (void *)kvs[i].val) == 0);
+        ngli_assert(ngli_hmap_get(hm, kvs[i].key) == kvs[i].val);
+    }
+    for (size_t i = 0; i < NGLI_ARRAY_NB(kvs); i++) {
+        const uint64_t hash = ngli_hmap_hash_key(kvs[i].key);
+        ngli_assert(ngli_hmap_get_prehashed(hm, kvs[i].key, hash) == kvs[i].val);
+    }
+
+    /* Caller provided hashes, all colliding */
+    struct hmap *hm_custom = ngli_hmap_create();
+    if (!hm_custom) {
+        ngli_hmap_freep(&hm);
+        return -1;
+    }
+    for (size_t i = 0; i < NGLI_ARRAY_NB(kvs); i++)
+        ngli_assert(ngli_hmap_set_prehashed(hm_custom, kvs[i].key, 0x1234, (void *)kvs[i].val) == 0);
+    for (size_t i = 0; i < NGLI_ARRAY_NB(kvs); i++)
+        ngli_assert(ngli_hmap_get_prehashed(hm_custom, kvs[i].key, 0x1234) == kvs[i].val);
+    check_order(hm_custom);
+
+    ngli_hmap_freep(&hm_custom);
+    ngli_hmap_freep(&hm);
+    return 0;
+}
+
+#define NB_STRESS_KEYS 1000
+
+/* Interleave many additions and deletions to exercise the slots reuse and rehashing */
+static int test_stress(void)
+{
+    struct hmap *hm = ngli_hmap_create();
+    if (!hm)
+        return -1;
+
+    char key[32];
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < NB_STRESS_KEYS; i++) {
+            snprintf(key, sizeof(key), "key%zu", i);
+            ngli_assert(ngli_hmap_set(hm, key, (void *)(uintptr_t)(i + 1)) == 0);
+        }
+        ngli_assert(ngli_hmap_count(hm) == NB_STRESS_KEYS);
+
+        /* Drop the odd keys */
+        for (size_t i = 1; i < NB_STRESS_KEYS; i += 2) {
+            snprintf(key, sizeof(key), "key%zu", i);
+            ngli_assert(ngli_hmap_set(hm, key, NULL) == 1);
+        }
+        ngli_assert(ngli_hmap_count(hm) == NB_STRESS_KEYS / 2);
+
+        for (size_t i = 0; i < NB_STRESS_KEYS; i++) {
+            snprintf(key, sizeof(key), "key%zu", i);
+            const uintptr_t expected = i & 1 ? 0 : i + 1;
+            ngli_assert((uintptr_t)ngli_hmap_get(hm, key) == expected);
+        }
+
+        /* Remaining entries must be iterated in insertion order */
+        size_t expected_id = 0;
+        const struct hmap_entry *e = NULL;
+        while ((e = ngli_hmap_next(hm, e))) {
+            ngli_assert((uintptr_t)e->data == expected_id + 1);
+            expected_id += 2;
+        }
+        ngli_assert(expected_id == NB_STRESS_KEYS);
+
+        /* Drop the even keys to start again from an empty map */
+        for (size_t i = 0; i < NB_STRESS_KEYS; i += 2) {
+            snprintf(key, sizeof(key), "key%zu", i);
+            ngli_assert(ngli_hmap_set(hm, key, NULL) == 1);
+        }
+        ngli_assert(ngli_hmap_count(hm) == 0);
+        ngli_assert(!ngli_hmap_next(hm, NULL));
+    }
+
+    ngli_hmap_freep(&hm);
+    return 0;
+}
+
 int main(void)
 {
     ngli_assert(ngli_crc32("codding") == ngli_crc32("gnu"));
@@ -96,6 +182,9 @@ int main(void)
     if (ret < 0)
         return 1;
 
+    if (test_prehashed() < 0 || test_stress() < 0)
+        return 1;
+
     for (int custom_alloc = 0; custom_alloc <= 1; custom_alloc++) {
         struct hmap *hm = ngli_hmap_create();
 
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "gpu_ctx.h"
+#include "memory.h"
+#include "pgcache.h"
+#include "utils.h"
+
+static int nb_builds;
+
+static struct program *program_create(struct gpu_ctx *gpu_ctx)
+{
+    struct program *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gpu_ctx = gpu_ctx;
+    return s;
+}
+
+static int program_init(struct program *s, const struct program_params *params)
+{
+    nb_builds++;
+    return 0;
+}
+
+static void program_freep(struct program **sp)
+{
+    ngli_freep(sp);
+}
+
+static const struct gpu_ctx_class test_gpu_ctx_class = {
+    .program_create = program_create,
+    .program_init   = program_init,
+    .program_freep  = program_freep,
+};
+
+static void check_bstr_hash(void)
+{
+    struct bstr *b = ngli_bstr_create();
+    ngli_assert(b);
+    ngli_assert(ngli_bstr_hash(b) == ngli_hash64_mem(NULL, 0));
+
+    ngli_bstr_print(b, "void main()\n");
+    ngli_bstr_printf(b, "{\n    gl_Position = vec4(%d.0);\n", 1);
+    ngli_assert(ngli_bstr_hash(b) == ngli_hash64_mem((const uint8_t *)ngli_bstr_strptr(b), ngli_bstr_len(b)));
+
+    /* Truncating and appending back the same content restores the hash */
+    const uint64_t hash = ngli_bstr_hash(b);
+    const size_t len = ngli_bstr_len(b);
+    ngli_assert(ngli_bstr_truncate(b, 4) == 0);
+    ngli_assert(ngli_bstr_hash(b) == ngli_hash64_mem((const uint8_t *)"void", 4));
+    ngli_bstr_printf(b, " main()\n{\n    gl_Position = vec4(%d.0);\n", 1);
+    ngli_assert(ngli_bstr_len(b) == len);
+    ngli_assert(ngli_bstr_hash(b) == hash);
+
+    ngli_bstr_clear(b);
+    ngli_assert(ngli_bstr_hash(b) == ngli_hash64_mem(NULL, 0));
+    ngli_bstr_freep(&b);
+}
+
+static void set_key(struct pgcache_key *key, int stage, const char *src)
+{
+    key->hash[stage] = ngli_hash64_mem((const uint8_t *)src, strlen(src));
+    key->size[stage] = strlen(src);
+}
+
+static struct program *get_graphics(struct pgcache *s, const char *vert, const char *frag)
+{
+    struct pgcache_key key = {0};
+    set_key(&key, NGLI_PROGRAM_SHADER_VERT, vert);
+    set_key(&key, NGLI_PROGRAM_SHADER_FRAG, frag);
+    const struct program_params params = {.vertex = vert, .fragment = frag};
+    struct program *program = NULL;
+    ngli_assert(ngli_pgcache_get_graphics_program(s, &program, &key, &params) == 0);
+    return program;
+}
+
+static void check_stats(const struct pgcache *s, size_t nb_hits, size_t nb_misses)
+{
+    size_t hits, misses;
+    ngli_pgcache_get_stats(s, &hits, &misses);
+    ngli_assert(hits == nb_hits && misses == nb_misses);
+    ngli_assert(nb_builds == (int)nb_misses);
+}
+
+int main(void)
+{
+    check_bstr_hash();
+
+    struct gpu_ctx gpu_ctx = {.cls = &test_gpu_ctx_class};
+    struct pgcache s = {0};
+    ngli_assert(ngli_pgcache_init(&s, &gpu_ctx) == 0);
+
+    /* Miss then hit */
+    struct program *p0 = get_graphics(&s, "vert0", "frag0");
+    ngli_assert(get_graphics(&s, "vert0", "frag0") == p0);
+    check_stats(&s, 1, 1);
+
+    /* Any stage change is a different program */
+    struct program *p1 = get_graphics(&s, "vert0", "frag1");
+    struct program *p2 = get_graphics(&s, "vert1", "frag0");
+    ngli_assert(p1 != p0 && p2 != p0 && p1 != p2);
+    check_stats(&s, 1, 3);
+
+    /* Compute programs do not collide with graphics ones */
+    struct pgcache_key comp_key = {0};
+    set_key(&comp_key, NGLI_PROGRAM_SHADER_COMP, "vert0");
+    const struct program_params comp_params = {.compute = "vert0"};
+    struct program *p3 = NULL;
+    ngli_assert(ngli_pgcache_get_compute_program(&s, &p3, &comp_key, &comp_params) == 0);
+    ngli_assert(p3 != p0);
+    check_stats(&s, 1, 4);
+
+    /*
+     * Forge a collision: same hashes as the first program but with different
+     * sources. The colliding program must be cached as well and both must be
+     * found back without being rebuilt.
+     */
+    struct pgcache_key key = {0};
+    set_key(&key, NGLI_PROGRAM_SHADER_VERT, "vert0");
+    set_key(&key, NGLI_PROGRAM_SHADER_FRAG, "frag0");
+    key.size[NGLI_PROGRAM_SHADER_FRAG] = strlen("frag0 ");
+    const struct program_params params = {.vertex = "vert0", .fragment = "frag0 "};
+    struct program *p4 = NULL;
+    ngli_assert(ngli_pgcache_get_graphics_program(&s, &p4, &key, &params) == 0);
+    ngli_assert(p4 != p0);
+    check_stats(&s, 1, 5);
+
+    struct program *program = NULL;
+    ngli_assert(ngli_pgcache_get_graphics_program(&s, &program, &key, &params) == 0);
+    ngli_assert(program == p4);
+    ngli_assert(get_graphics(&s, "vert0", "frag0") == p0);
+    check_stats(&s, 3, 5);
+
+    ngli_pgcache_reset(&s);
+    return 0;
+}
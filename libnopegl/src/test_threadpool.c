@@ -0,0 +1,89 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "memory.h"
+#include "nopegl.h"
+#include "threadpool.h"
+#include "utils.h"
+
+#define NB_JOBS 1000
+
+static int square_job(void *user_arg, size_t index)
+{
+    uint64_t *values = user_arg;
+    values[index] += (uint64_t)index * index;
+    return 0;
+}
+
+static int failing_job(void *user_arg, size_t index)
+{
+    const size_t *failing_index = user_arg;
+    return index == *failing_index ? NGL_ERROR_GENERIC : 0;
+}
+
+static void check_pool(size_t nb_threads)
+{
+    struct threadpool *pool = ngli_threadpool_create(nb_threads);
+    ngli_assert(pool);
+
+    uint64_t *values = ngli_calloc(NB_JOBS, sizeof(*values));
+    ngli_assert(values);
+
+    ngli_assert(ngli_threadpool_run(pool, square_job, values, 0) == 0);
+
+    /* Every job must be executed exactly once per batch */
+    for (size_t n = 1; n <= 3; n++) {
+        int ret = ngli_threadpool_run(pool, square_job, values, NB_JOBS);
+        ngli_assert(ret == 0);
+        for (size_t i = 0; i < NB_JOBS; i++) {
+            if (values[i] != n * i * i) {
+                fprintf(stderr, "[%zu threads] job %zu: got %" PRIu64 " instead of %zu\n",
+                        nb_threads, i, values[i], n * i * i);
+                exit(1);
+            }
+        }
+    }
+
+    const size_t failing_index = NB_JOBS / 3;
+    int ret = ngli_threadpool_run(pool, failing_job, (void *)&failing_index, NB_JOBS);
+    ngli_assert(ret == NGL_ERROR_GENERIC);
+
+    /* The pool must remain usable after a failure */
+    ret = ngli_threadpool_run(pool, square_job, values, NB_JOBS);
+    ngli_assert(ret == 0);
+
+    ngli_free(values);
+    ngli_threadpool_freep(&pool);
+    ngli_assert(!pool);
+}
+
+int main(void)
+{
+    ngli_assert(!ngli_threadpool_create(0));
+    for (size_t nb_threads = 1; nb_threads <= 8; nb_threads++)
+        check_pool(nb_threads);
+    return 0;
+}
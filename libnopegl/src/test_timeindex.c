@@ -0,0 +1,186 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "memory.h"
+#include "timeindex.h"
+#include "utils.h"
+
+#define NB_TIMES   50000
+#define NB_LOOKUPS 200000
+
+/* Reference implementation: the linear scan the time index replaces */
+static size_t linear_search(const int64_t *times, size_t nb_times, size_t start, int64_t t)
+{
+    size_t ret = SIZE_MAX;
+    for (size_t i = start; i < nb_times; i++) {
+        if (times[i] > t)
+            break;
+        ret = i;
+    }
+    if (ret == SIZE_MAX && start)
+        return linear_search(times, nb_times, 0, t);
+    return ret;
+}
+
+static uint32_t rand_state = 0x12345;
+
+static uint32_t rand_u32(void)
+{
+    /* xorshift32, deterministic across platforms */
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static void check_lookups(const int64_t *times, size_t nb_times)
+{
+    const int64_t max_t = nb_times ? times[nb_times - 1] + 10 : 10;
+    for (size_t hint = 0; hint <= nb_times + 1; hint++) {
+        for (int64_t t = -2; t <= max_t; t++) {
+            const size_t ref = linear_search(times, nb_times, 0, t);
+            const size_t ret = ngli_timeindex_search_i64(times, nb_times, hint, t);
+            if (ret != ref) {
+                fprintf(stderr, "nb_times=%zu hint=%zu t=%" PRId64 ": got %zu instead of %zu\n",
+                        nb_times, hint, t, ret, ref);
+                exit(1);
+            }
+        }
+    }
+}
+
+static void check_small_sequences(void)
+{
+    /* Exhaustive check on short sequences, including duplicated times */
+    int64_t times[16];
+    for (size_t n = 0; n <= NGLI_ARRAY_NB(times); n++) {
+        for (int round = 0; round < 20; round++) {
+            int64_t t = rand_u32() % 3;
+            for (size_t i = 0; i < n; i++) {
+                times[i] = t;
+                t += rand_u32() % 3;
+            }
+            check_lookups(times, n);
+        }
+    }
+
+    const double ftimes[] = {0.0, 0.5, 0.5, 1.0, 3.0};
+    ngli_assert(ngli_timeindex_search_f64(ftimes, 5, 4, -0.1) == SIZE_MAX);
+    ngli_assert(ngli_timeindex_search_f64(ftimes, 5, 0, 0.5) == 2);
+    ngli_assert(ngli_timeindex_search_f64(ftimes, 5, 4, 0.7) == 2);
+    ngli_assert(ngli_timeindex_search_f64(ftimes, 5, 1, 10.0) == 4);
+    for (size_t hint = 0; hint <= 5; hint++)
+        ngli_assert(ngli_timeindex_search_f64(ftimes, 5, hint, NAN) == SIZE_MAX);
+}
+
+enum {
+    PATTERN_FORWARD,
+    PATTERN_REVERSE,
+    PATTERN_RANDOM,
+};
+
+static const char * const pattern_names[] = {
+    [PATTERN_FORWARD] = "forward play",
+    [PATTERN_REVERSE] = "reverse play",
+    [PATTERN_RANDOM]  = "random seeks",
+};
+
+static int64_t *get_lookup_times(int pattern, int64_t max_t)
+{
+    int64_t *lookups = ngli_calloc(NB_LOOKUPS, sizeof(*lookups));
+    ngli_assert(lookups);
+    for (size_t i = 0; i < NB_LOOKUPS; i++) {
+        switch (pattern) {
+        case PATTERN_FORWARD: lookups[i] = max_t * i / NB_LOOKUPS;                  break;
+        case PATTERN_REVERSE: lookups[i] = max_t * (NB_LOOKUPS - 1 - i) / NB_LOOKUPS; break;
+        case PATTERN_RANDOM:  lookups[i] = rand_u32() % max_t;                       break;
+        }
+    }
+    return lookups;
+}
+
+static void bench(const int64_t *times, size_t nb_times, int pattern)
+{
+    const int64_t max_t = times[nb_times - 1];
+    int64_t *lookups = get_lookup_times(pattern, max_t);
+
+    /* The linear scan is quadratic on random seeks: only time a subset */
+    const size_t nb_linear = pattern == PATTERN_FORWARD ? NB_LOOKUPS : NB_LOOKUPS / 100;
+
+    size_t *linear_results = ngli_calloc(nb_linear, sizeof(*linear_results));
+    size_t *index_results = ngli_calloc(NB_LOOKUPS, sizeof(*index_results));
+    ngli_assert(linear_results && index_results);
+
+    size_t hint = 0;
+    int64_t start = ngli_gettime_relative();
+    for (size_t i = 0; i < nb_linear; i++) {
+        const size_t ret = linear_search(times, nb_times, hint, lookups[i]);
+        linear_results[i] = ret;
+        hint = ret == SIZE_MAX ? 0 : ret;
+    }
+    const int64_t linear_time = ngli_gettime_relative() - start;
+
+    hint = 0;
+    start = ngli_gettime_relative();
+    for (size_t i = 0; i < NB_LOOKUPS; i++) {
+        const size_t ret = ngli_timeindex_search_i64(times, nb_times, hint, lookups[i]);
+        index_results[i] = ret;
+        hint = ret == SIZE_MAX ? 0 : ret;
+    }
+    const int64_t index_time = ngli_gettime_relative() - start;
+
+    for (size_t i = 0; i < nb_linear; i++)
+        ngli_assert(linear_results[i] == index_results[i]);
+
+    printf("%-12s linear: %8.1fns/lookup, time index: %6.1fns/lookup\n", pattern_names[pattern],
+           (double)linear_time * 1000. / (double)nb_linear, (double)index_time * 1000. / NB_LOOKUPS);
+
+    ngli_free(index_results);
+    ngli_free(linear_results);
+    ngli_free(lookups);
+}
+
+int main(void)
+{
+    check_small_sequences();
+
+    int64_t *times = ngli_calloc(NB_TIMES, sizeof(*times));
+    ngli_assert(times);
+    int64_t t = 0;
+    for (size_t i = 0; i < NB_TIMES; i++) {
+        times[i] = t;
+        t += 1 + rand_u32() % 40000;
+    }
+
+    printf("%d timestamps, %d lookups\n", NB_TIMES, NB_LOOKUPS);
+    bench(times, NB_TIMES, PATTERN_FORWARD);
+    bench(times, NB_TIMES, PATTERN_REVERSE);
+    bench(times, NB_TIMES, PATTERN_RANDOM);
+
+    ngli_free(times);
+    return 0;
+}
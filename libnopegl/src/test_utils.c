@@ -40,6 +40,10 @@ int main(void)
         buf[i] = (char)(0xff - i);
     ngli_assert(ngli_crc32(buf) == 0x5473AA4D);
 
+    ngli_assert(ngli_hash64_mem(NULL, 0) == 0xcbf29ce484222325);
+    ngli_assert(ngli_hash64_mem((const uint8_t *)"a", 1) == 0xaf63dc4c8601ec8c);
+    ngli_assert(ngli_hash64_mem((const uint8_t *)"foobar", 6) == 0x85944171f73967e8);
+
 #define X "x\n"
 #define S "foo\nbar\nhello\nworld\nbla\nxxx\nyyy\n"
     test_numbered_line(0x2d7f40af, S S S S S S S S);
@@ -130,6 +130,10 @@ int ngli_text_init(struct text *s, const struct text_config *cfg)
         return NGL_ERROR_MEMORY;
 
     s->cls = cfg->font_files ? &ngli_text_external : &ngli_text_builtin;
+    if (s->config.distance_field && s->cls == &ngli_text_builtin) {
+        LOG(WARNING, "distance field rendering requires external fonts, falling back on bitmaps");
+        s->config.distance_field = 0;
+    }
     if (s->cls->priv_size) {
         s->priv_data = ngli_calloc(1, s->cls->priv_size);
         if (!s->priv_data)
@@ -458,10 +462,10 @@ int ngli_text_set_string(struct text *s, const char *str)
             .w = NGLI_I26D6_TO_F32(chr_internal->w) / (float)s->width,
             .h = NGLI_I26D6_TO_F32(chr_internal->h) / (float)s->height,
             .atlas_coords = {
-                (float)chr_internal->atlas_coords[0] / (float)s->atlas_texture->params.width,
-                (float)chr_internal->atlas_coords[1] / (float)s->atlas_texture->params.height,
-                (float)chr_internal->atlas_coords[2] / (float)s->atlas_texture->params.width,
-                (float)chr_internal->atlas_coords[3] / (float)s->atlas_texture->params.height,
+                (float)chr_internal->atlas_coords[0],
+                (float)chr_internal->atlas_coords[1],
+                (float)chr_internal->atlas_coords[2],
+                (float)chr_internal->atlas_coords[3],
             },
         };
 
@@ -575,6 +579,13 @@ int ngli_text_set_time(struct text *s, double t)
     return 0;
 }
 
+struct texture *ngli_text_get_atlas_texture(struct text *s)
+{
+    if (s->cls->flags & NGLI_TEXT_FLAG_MUTABLE_ATLAS)
+        s->atlas_texture = s->cls->get_atlas_texture(s);
+    return s->atlas_texture;
+}
+
 void ngli_text_freep(struct text **sp)
 {
     struct text *s = *sp;
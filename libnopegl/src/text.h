@@ -65,7 +65,7 @@ struct char_info_internal {
 /* Exposed by the text API */
 struct char_info {
     float x, y, w, h;
-    float atlas_coords[4];
+    float atlas_coords[4]; // pixel atlas coordinates, normalized by the shader
 };
 
 /* User-requested defaults for all the characters */
@@ -80,6 +80,7 @@ struct text_config {
     enum text_valign valign;
     enum text_halign halign;
     enum writing_mode writing_mode;
+    int distance_field; // glyphs are signed distance fields instead of coverage bitmaps
     struct ngl_node **effect_nodes;
     size_t nb_effect_nodes;
     struct text_effects_defaults defaults;
@@ -87,12 +88,13 @@ struct text_config {
 
 struct text;
 
-#define NGLI_TEXT_FLAG_MUTABLE_ATLAS (1 << 0) // whether set_string() can change the atlas texture or not
+#define NGLI_TEXT_FLAG_MUTABLE_ATLAS (1 << 0) // whether the atlas texture can change after init or not
 
 /* structure reserved for internal implementations */
 struct text_cls {
     int (*init)(struct text *text);
     int (*set_string)(struct text *text, const char *str, struct darray *chars_dst);
+    struct texture *(*get_atlas_texture)(struct text *text); // only required with NGLI_TEXT_FLAG_MUTABLE_ATLAS
     void (*reset)(struct text *text);
     size_t priv_size;
     uint32_t flags; // combination of NGLI_TEXT_FLAG_*
@@ -144,6 +146,13 @@ int ngli_text_set_string(struct text *s, const char *str);
 
 int ngli_text_set_time(struct text *s, double t);
 
+/*
+ * Return the current atlas texture, which may change outside of
+ * ngli_text_set_string() when the class has the NGLI_TEXT_FLAG_MUTABLE_ATLAS
+ * flag (for example, when another text grows a shared atlas)
+ */
+struct texture *ngli_text_get_atlas_texture(struct text *s);
+
 void ngli_text_freep(struct text **sp);
 
 #endif
@@ -26,12 +26,15 @@
 #include <hb-ft.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_MODULE_H
 #include <fribidi.h>
 #endif
 
 #include "atlas.h"
 #include "darray.h"
+#include "glyphcache.h"
 #include "hmap.h"
+#include "internal.h"
 #include "log.h"
 #include "memory.h"
 #include "nopegl.h"
@@ -43,9 +46,24 @@ struct text_external {
     FT_Library ft_library;
     struct darray ft_faces; // FT_Face (hidden pointer)
     struct darray hb_fonts; // hb_font_t*
-    struct atlas *atlas;
+    struct darray face_keys; // char *, glyph cache key prefix of each face
+    struct darray glyphs; // struct glyphcache_entry *, glyphs referenced by the current string
+    struct glyphcache *glyphcache;
 };
 
+#define PT_SIZE 54 // nominal glyph size in points
+#define RES_DPI 96 // horizontal and vertical resolution in dpi
+
+/*
+ * Distance fields are interpolated by the GPU so they can be rasterized at a
+ * much smaller size while remaining sharp at any scale. The spread is the
+ * maximum distance (in pixels) encoded around the outlines.
+ */
+#define SDF_PT_SIZE 32
+#define SDF_SPREAD  8
+
+#define HAVE_FT_SDF (FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11))
+
 static int load_font(struct text *text, const char *font_file)
 {
     struct text_external *s = text->priv_data;
@@ -70,11 +88,11 @@ static int load_font(struct text *text, const char *font_file)
         return NGL_ERROR_MEMORY;
     }
 
-    const int32_t pt_size = 54;
+    const int32_t pt_size = text->config.distance_field ? SDF_PT_SIZE : PT_SIZE;
     const FT_F26Dot6 chr_w = NGLI_I32_TO_I26D6(pt_size); // nominal width in 26.6
     const FT_F26Dot6 chr_h = NGLI_I32_TO_I26D6(pt_size); // nominal height in 26.6
-    const FT_UInt h_res = 96; // horizontal resolution in dpi
-    const FT_UInt v_res = 96; // vertical resolution in dpi
+    const FT_UInt h_res = RES_DPI; // horizontal resolution in dpi
+    const FT_UInt v_res = RES_DPI; // vertical resolution in dpi
     ft_error = FT_Set_Char_Size(ft_face, chr_w, chr_h, h_res, v_res);
     if (ft_error) {
         LOG(ERROR, "unable to set char size to %d points in %ux%u DPI", pt_size, h_res, v_res);
@@ -90,6 +108,47 @@ static int load_font(struct text *text, const char *font_file)
         return NGL_ERROR_MEMORY;
     }
 
+    /*
+     * The rasterized glyphs are shared with every other Text node through the
+     * context glyph cache, so they are identified by the font face and size
+     * instead of the index of the face in this text instance
+     */
+    char *face_key = ngli_asprintf("%s:%d:%d@%d%s", font_file, 0, pt_size, RES_DPI,
+                                   text->config.distance_field ? ":sdf" : "");
+    if (!face_key)
+        return NGL_ERROR_MEMORY;
+    if (!ngli_darray_push(&s->face_keys, &face_key)) {
+        ngli_free(face_key);
+        return NGL_ERROR_MEMORY;
+    }
+
+    return 0;
+}
+
+/*
+ * Coverage bitmaps and distance fields are stored in different caches since
+ * the latter need to be linearly interpolated when magnified
+ */
+static int glyphcache_create(struct ngl_ctx *ctx, int distance_field, struct glyphcache **glyphcachep)
+{
+    struct glyphcache **cachep = distance_field ? &ctx->sdf_glyphcache : &ctx->glyphcache;
+    if (*cachep) {
+        *glyphcachep = *cachep;
+        return 0;
+    }
+
+    *cachep = ngli_glyphcache_create(ctx);
+    if (!*cachep)
+        return NGL_ERROR_MEMORY;
+
+    const int mag_filter = distance_field ? NGLI_FILTER_LINEAR : NGLI_FILTER_NEAREST;
+    int ret = ngli_glyphcache_init(*cachep, mag_filter);
+    if (ret < 0) {
+        ngli_glyphcache_freep(cachep);
+        return ret;
+    }
+
+    *glyphcachep = *cachep;
     return 0;
 }
 
@@ -100,6 +159,20 @@ static int text_external_init(struct text *text)
 
     ngli_darray_init(&s->ft_faces, sizeof(FT_Face), 0);
     ngli_darray_init(&s->hb_fonts, sizeof(hb_font_t *), 0);
+    ngli_darray_init(&s->face_keys, sizeof(char *), 0);
+    ngli_darray_init(&s->glyphs, sizeof(struct glyphcache_entry *), 0);
+
+#if !HAVE_FT_SDF
+    if (text->config.distance_field) {
+        LOG(ERROR, "distance field rendering requires FreeType 2.11 or later");
+        return NGL_ERROR_UNSUPPORTED;
+    }
+#endif
+
+    ret = glyphcache_create(text->ctx, text->config.distance_field, &s->glyphcache);
+    if (ret < 0)
+        return ret;
+    text->atlas_texture = ngli_glyphcache_get_texture(s->glyphcache);
 
     FT_Error ft_error = FT_Init_FreeType(&s->ft_library);
     if (ft_error) {
@@ -107,6 +180,17 @@ static int text_external_init(struct text *text)
         return NGL_ERROR_EXTERNAL;
     }
 
+#if HAVE_FT_SDF
+    if (text->config.distance_field) {
+        const FT_Int spread = SDF_SPREAD;
+        ft_error = FT_Property_Set(s->ft_library, "bsdf", "spread", &spread);
+        if (ft_error) {
+            LOG(ERROR, "unable to set the distance field spread");
+            return NGL_ERROR_EXTERNAL;
+        }
+    }
+#endif
+
     /* Duplicate the font files specifications so that we can inject '\0' into it */
     char *font_files = ngli_strdup(text->config.font_files);
     if (!font_files)
@@ -131,24 +215,6 @@ end:
     return ret;
 }
 
-struct glyph {
-    int32_t atlas_id; // index in the atlas texture
-    int32_t width, height; // in 26.6
-    int32_t bearing_x, bearing_y; // in 26.6
-};
-
-static void free_glyph(void *user_arg, void *data)
-{
-    struct glyph *glyph = data;
-    ngli_freep(&glyph);
-}
-
-static struct glyph *create_glyph(void)
-{
-    struct glyph *glyph = ngli_calloc(1, sizeof(*glyph));
-    return glyph;
-}
-
 static const char *hex = "0123456789abcdef";
 
 /* Compute a unique glyph identifier string using the face and glyph IDs */
@@ -181,6 +247,85 @@ struct text_run {
     const hb_glyph_position_t *glyph_positions;
 };
 
+static struct glyphcache_entry *get_glyph(struct text *text, size_t face_id, hb_codepoint_t glyph_id, int *ret)
+{
+    struct text_external *s = text->priv_data;
+    struct glyphcache *glyphcache = s->glyphcache;
+
+    char * const *face_keys = ngli_darray_data(&s->face_keys);
+    char *key = ngli_asprintf("%s-%x", face_keys[face_id], glyph_id);
+    if (!key) {
+        *ret = NGL_ERROR_MEMORY;
+        return NULL;
+    }
+
+    struct glyphcache_entry *entry = ngli_glyphcache_get(glyphcache, key);
+    if (entry)
+        goto end;
+
+    /*
+     * Harfbuzz seems to use NO_HINTING as well, so we may want to stay
+     * aligned with it.
+     */
+    const FT_Face *ft_faces = ngli_darray_data(&s->ft_faces);
+    const FT_Face ft_face = ft_faces[face_id];
+    FT_Error ft_error = FT_Load_Glyph(ft_face, glyph_id, FT_LOAD_DEFAULT | FT_LOAD_NO_HINTING);
+    if (ft_error) {
+        /*
+         * We do not use the "U+XXXX" notation in the format string
+         * because it does not necessarily correspond to the Unicode
+         * codepoint (we are post-shaping so this is a font specific
+         * character code).
+         */
+        LOG(ERROR, "unable to load glyph id %u", glyph_id);
+        *ret = NGL_ERROR_EXTERNAL;
+        goto end;
+    }
+
+    const FT_GlyphSlot slot = ft_face->glyph;
+    ft_error = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
+#if HAVE_FT_SDF
+    /*
+     * The distance field is computed from the rasterized bitmap ("bsdf"
+     * renderer) rather than from the outlines ("sdf" renderer) which produces
+     * artifacts where the contours overlap, as is common in variable fonts
+     */
+    if (!ft_error && text->config.distance_field)
+        ft_error = FT_Render_Glyph(slot, FT_RENDER_MODE_SDF);
+#endif
+    if (ft_error) {
+        LOG(ERROR, "unable to render glyph id %u", glyph_id);
+        *ret = NGL_ERROR_EXTERNAL;
+        goto end;
+    }
+
+    /* Register rasterized bitmap into the glyph cache atlas */
+    const struct bitmap bitmap = {
+        .buffer  = slot->bitmap.buffer,
+        .stride  = slot->bitmap.pitch,
+        .width   = slot->bitmap.width,
+        .height  = slot->bitmap.rows,
+    };
+    const int32_t bearing_x = NGLI_I32_TO_I26D6(slot->bitmap_left);
+    const int32_t bearing_y = NGLI_I32_TO_I26D6(slot->bitmap_top - bitmap.height);
+    *ret = ngli_glyphcache_add(glyphcache, key, &bitmap, bearing_x, bearing_y, &entry);
+    if (*ret < 0)
+        entry = NULL;
+
+end:
+    ngli_free(key);
+    return entry;
+}
+
+static void release_glyphs(struct text *text)
+{
+    struct text_external *s = text->priv_data;
+    struct glyphcache_entry **glyphs = ngli_darray_data(&s->glyphs);
+    for (size_t i = 0; i < ngli_darray_count(&s->glyphs); i++)
+        ngli_glyphcache_release(s->glyphcache, glyphs[i]);
+    ngli_darray_clear(&s->glyphs);
+}
+
 static int build_glyph_index(struct text *text, struct hmap *glyph_index, struct darray *runs_array)
 {
     struct text_external *s = text->priv_data;
@@ -191,8 +336,6 @@ static int build_glyph_index(struct text *text, struct hmap *glyph_index, struct
         if (run->face_id == SIZE_MAX)
             continue;
 
-        const FT_Face *ft_faces = ngli_darray_data(&s->ft_faces);
-        const FT_Face ft_face = ft_faces[run->face_id];
         const size_t nb_glyphs = hb_buffer_get_length(run->buffer);
         const hb_glyph_info_t *glyph_infos = run->glyph_infos;
 
@@ -207,55 +350,21 @@ static int build_glyph_index(struct text *text, struct hmap *glyph_index, struct
             if (ngli_hmap_get(glyph_index, glyph_uid))
                 continue;
 
-            /*
-             * Harfbuzz seems to use NO_HINTING as well, so we may want to stay
-             * aligned with it.
-             */
-            FT_Error ft_error = FT_Load_Glyph(ft_face, glyph_id, FT_LOAD_DEFAULT | FT_LOAD_NO_HINTING);
-            if (ft_error) {
-                /*
-                 * We do not use the "U+XXXX" notation in the format string
-                 * because it does not necessarily correspond to the Unicode
-                 * codepoint (we are post-shaping so this is a font specific
-                 * character code).
-                 */
-                LOG(ERROR, "unable to load glyph id %u", glyph_id);
-                return NGL_ERROR_EXTERNAL;
-            }
-
-            const FT_GlyphSlot slot = ft_face->glyph;
-            ft_error = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
-            if (ft_error) {
-                LOG(ERROR, "unable to render glyph id %u", glyph_id);
-                return NGL_ERROR_EXTERNAL;
-            }
-
-            /* Register rasterized bitmap into the texture atlas */
-            const struct bitmap bitmap = {
-                .buffer  = slot->bitmap.buffer,
-                .stride  = slot->bitmap.pitch,
-                .width   = slot->bitmap.width,
-                .height  = slot->bitmap.rows,
-            };
-            int32_t atlas_id;
-            int ret = ngli_atlas_add_bitmap(s->atlas, &bitmap, &atlas_id);
-            if (ret < 0)
+            /* Only the glyphs missing from the glyph cache are rasterized */
+            int ret = 0;
+            struct glyphcache_entry *glyph = get_glyph(text, run->face_id, glyph_id, &ret);
+            if (!glyph)
                 return ret;
 
-            /* Save the rasterized glyph in the index */
-            struct glyph *glyph = create_glyph();
-            if (!glyph)
+            /* Keep a reference on the glyph until the next string update */
+            if (!ngli_darray_push(&s->glyphs, &glyph)) {
+                ngli_glyphcache_release(s->glyphcache, glyph);
                 return NGL_ERROR_MEMORY;
-            glyph->atlas_id  = atlas_id;
-            glyph->width     = NGLI_I32_TO_I26D6(bitmap.width);
-            glyph->height    = NGLI_I32_TO_I26D6(bitmap.height);
-            glyph->bearing_x = NGLI_I32_TO_I26D6(slot->bitmap_left);
-            glyph->bearing_y = NGLI_I32_TO_I26D6(slot->bitmap_top - bitmap.height);
+            }
+
             ret = ngli_hmap_set(glyph_index, glyph_uid, glyph);
-            if (ret < 0) {
-                free_glyph(NULL, glyph);
+            if (ret < 0)
                 return ret;
-            }
         }
     }
 
@@ -630,14 +739,14 @@ static int register_chars(struct text *text, const char *str, struct darray *cha
 
             const hb_codepoint_t glyph_id = run->glyph_infos[j].codepoint;
             const char glyph_uid[] = GLYPH_UID_STRING(run->face_id, glyph_id);
-            const struct glyph *glyph = ngli_hmap_get(glyph_index, glyph_uid);
+            const struct glyphcache_entry *glyph = ngli_hmap_get(glyph_index, glyph_uid);
             if (glyph) {
                 chr.tags |= NGLI_TEXT_CHAR_TAG_GLYPH;
                 chr.x = x_cur + glyph->bearing_x + pos->x_offset;
                 chr.y = y_cur + glyph->bearing_y + pos->y_offset;
                 chr.w = glyph->width;
                 chr.h = glyph->height;
-                ngli_atlas_get_bitmap_coords(s->atlas, glyph->atlas_id, chr.atlas_coords);
+                memcpy(chr.atlas_coords, glyph->coords, sizeof(chr.atlas_coords));
             }
 
             if (!ngli_darray_push(chars_dst, &chr))
@@ -658,37 +767,28 @@ static int text_external_set_string(struct text *text, const char *str, struct d
     struct darray runs_array;
     ngli_darray_init(&runs_array, sizeof(struct text_run), 0);
 
-    /* Re-entrance reset */
-    ngli_atlas_freep(&s->atlas);
+    /*
+     * Re-entrance reset: the glyphs of the previous string remain in the
+     * glyph cache (until they get evicted), so the glyphs in common with the
+     * new string are not rasterized nor uploaded again
+     */
+    release_glyphs(text);
 
     int ret = build_text_runs(text, str, &runs_array);
     if (ret < 0)
         goto end;
 
-    s->atlas = ngli_atlas_create(text->ctx);
-    if (!s->atlas) {
-        ret = NGL_ERROR_MEMORY;
-        goto end;
-    }
-
-    ret = ngli_atlas_init(s->atlas);
-    if (ret < 0)
-        goto end;
-
     glyph_index = ngli_hmap_create();
     if (!glyph_index) {
         ret = NGL_ERROR_MEMORY;
         goto end;
     }
-    ngli_hmap_set_free(glyph_index, free_glyph, NULL);
     ret = build_glyph_index(text, glyph_index, &runs_array);
     if (ret < 0)
         goto end;
 
-    ret = ngli_atlas_finalize(s->atlas);
-    if (ret < 0)
-        goto end;
-    text->atlas_texture = ngli_atlas_get_texture(s->atlas);
+    /* The atlas texture may have been replaced if it had to grow */
+    text->atlas_texture = ngli_glyphcache_get_texture(s->glyphcache);
 
     ret = register_chars(text, str, chars_dst, &runs_array, glyph_index);
     if (ret < 0)
@@ -700,10 +800,25 @@ end:
     return ret;
 }
 
+static struct texture *text_external_get_atlas_texture(struct text *text)
+{
+    struct text_external *s = text->priv_data;
+    return ngli_glyphcache_get_texture(s->glyphcache);
+}
+
 static void text_external_reset(struct text *text)
 {
     struct text_external *s = text->priv_data;
 
+    if (s->glyphcache)
+        release_glyphs(text);
+    ngli_darray_reset(&s->glyphs);
+
+    char **face_keys = ngli_darray_data(&s->face_keys);
+    for (size_t i = 0; i < ngli_darray_count(&s->face_keys); i++)
+        ngli_free(face_keys[i]);
+    ngli_darray_reset(&s->face_keys);
+
     struct hb_font_t **hb_fonts = ngli_darray_data(&s->hb_fonts);
     for (size_t i = 0; i < ngli_darray_count(&s->hb_fonts); i++)
         hb_font_destroy(hb_fonts[i]);
@@ -715,16 +830,15 @@ static void text_external_reset(struct text *text)
     ngli_darray_reset(&s->ft_faces);
 
     FT_Done_FreeType(s->ft_library);
-
-    ngli_atlas_freep(&s->atlas);
 }
 
 const struct text_cls ngli_text_external = {
-    .priv_size       = sizeof(struct text_external),
-    .init            = text_external_init,
-    .set_string      = text_external_set_string,
-    .reset           = text_external_reset,
-    .flags           = NGLI_TEXT_FLAG_MUTABLE_ATLAS,
+    .priv_size         = sizeof(struct text_external),
+    .init              = text_external_init,
+    .set_string        = text_external_set_string,
+    .get_atlas_texture = text_external_get_atlas_texture,
+    .reset             = text_external_reset,
+    .flags             = NGLI_TEXT_FLAG_MUTABLE_ATLAS,
 };
 
 #else
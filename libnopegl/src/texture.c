@@ -37,6 +37,17 @@ int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize)
     return s->gpu_ctx->cls->texture_upload(s, data, linesize);
 }
 
+int ngli_texture_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                               int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    ngli_assert(s->params.type == NGLI_TEXTURE_TYPE_2D);
+    ngli_assert(x >= 0 && y >= 0 && width >= 0 && height >= 0);
+    ngli_assert(x + width <= s->params.width && y + height <= s->params.height);
+    if (!width || !height)
+        return 0;
+    return s->gpu_ctx->cls->texture_upload_region(s, data, linesize, x, y, width, height);
+}
+
 int ngli_texture_generate_mipmap(struct texture *s)
 {
     return s->gpu_ctx->cls->texture_generate_mipmap(s);
@@ -96,6 +96,13 @@ int ngli_texture_init(struct texture *s,
                       const struct texture_params *params);
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize);
+
+/*
+ * Update the (x, y, width, height) area of the first level of a 2D texture.
+ * The linesize is expressed in pixels (0 means width).
+ */
+int ngli_texture_upload_region(struct texture *s, const uint8_t *data, int linesize,
+                               int32_t x, int32_t y, int32_t width, int32_t height);
 int ngli_texture_generate_mipmap(struct texture *s);
 
 void ngli_texture_freep(struct texture **sp);
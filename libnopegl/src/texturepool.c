@@ -0,0 +1,126 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "darray.h"
+#include "log.h"
+#include "memory.h"
+#include "nopegl.h"
+#include "texturepool.h"
+#include "utils.h"
+
+struct entry {
+    struct texture_params params;
+    size_t index;
+    struct texture *texture;
+    size_t refcount;
+};
+
+struct texturepool {
+    struct gpu_ctx *gpu_ctx;
+    struct darray entries; // struct entry
+};
+
+struct texturepool *ngli_texturepool_create(struct gpu_ctx *gpu_ctx)
+{
+    struct texturepool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->entries, sizeof(struct entry), 0);
+    return s;
+}
+
+int ngli_texturepool_get(struct texturepool *s, const struct texture_params *params, size_t index,
+                         struct texture **texturep)
+{
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        if (entry->index == index && !memcmp(&entry->params, params, sizeof(*params))) {
+            entry->refcount++;
+            *texturep = entry->texture;
+            return 0;
+        }
+    }
+
+    struct texture *texture = ngli_texture_create(s->gpu_ctx);
+    if (!texture)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_texture_init(texture, params);
+    if (ret < 0) {
+        ngli_texture_freep(&texture);
+        return ret;
+    }
+
+    const struct entry entry = {
+        .params   = *params,
+        .index    = index,
+        .texture  = texture,
+        .refcount = 1,
+    };
+    if (!ngli_darray_push(&s->entries, &entry)) {
+        ngli_texture_freep(&texture);
+        return NGL_ERROR_MEMORY;
+    }
+
+    LOG(DEBUG, "allocate transient %dx%d texture (format=%d samples=%d index=%zu)",
+        params->width, params->height, params->format, params->samples, index);
+
+    *texturep = texture;
+    return 0;
+}
+
+void ngli_texturepool_release(struct texturepool *s, struct texture **texturep)
+{
+    struct texture *texture = *texturep;
+    if (!texture)
+        return;
+
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        if (entry->texture != texture)
+            continue;
+        ngli_assert(entry->refcount > 0);
+        if (--entry->refcount == 0) {
+            ngli_texture_freep(&entry->texture);
+            ngli_darray_remove(&s->entries, i);
+        }
+        *texturep = NULL;
+        return;
+    }
+    ngli_assert(0);
+}
+
+void ngli_texturepool_freep(struct texturepool **sp)
+{
+    struct texturepool *s = *sp;
+    if (!s)
+        return;
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (size_t i = 0; i < ngli_darray_count(&s->entries); i++)
+        ngli_texture_freep(&entries[i].texture);
+    ngli_darray_reset(&s->entries);
+    ngli_freep(sp);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TEXTUREPOOL_H
+#define TEXTUREPOOL_H
+
+#include <stddef.h>
+
+#include "texture.h"
+
+/*
+ * Pool of transient textures, typically attachments which content does not
+ * survive the render pass they are used in (such as intermediate depth or
+ * multisampled buffers). Since the render passes are executed one after the
+ * other, these textures are never alive at the same time and can be aliased:
+ * requesting a texture with the same parameters and the same index returns
+ * the same texture. Within a render pass, each attachment must use a
+ * different index to get its own texture.
+ *
+ * The textures are reference counted and destroyed when their last user
+ * releases them.
+ */
+
+struct texturepool;
+
+struct texturepool *ngli_texturepool_create(struct gpu_ctx *gpu_ctx);
+int ngli_texturepool_get(struct texturepool *s, const struct texture_params *params, size_t index,
+                         struct texture **texturep);
+void ngli_texturepool_release(struct texturepool *s, struct texture **texturep);
+void ngli_texturepool_freep(struct texturepool **sp);
+
+#endif
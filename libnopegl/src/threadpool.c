@@ -0,0 +1,174 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "log.h"
+#include "memory.h"
+#include "nopegl.h"
+#include "pthread_compat.h"
+#include "threadpool.h"
+#include "utils.h"
+
+struct threadpool {
+    pthread_t *threads;
+    size_t nb_threads;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond_job;
+    pthread_cond_t cond_done;
+
+    threadpool_job_func job_func;
+    void *user_arg;
+    size_t nb_jobs;
+    size_t next_job;
+    size_t nb_jobs_done;
+    int ret;
+    int stop;
+};
+
+/* Must be called with the lock held, which is released during the job execution */
+static void run_next_job(struct threadpool *s)
+{
+    const size_t index = s->next_job++;
+    pthread_mutex_unlock(&s->lock);
+
+    const int ret = s->job_func(s->user_arg, index);
+
+    pthread_mutex_lock(&s->lock);
+    if (ret < 0 && s->ret >= 0)
+        s->ret = ret;
+    if (++s->nb_jobs_done == s->nb_jobs)
+        pthread_cond_signal(&s->cond_done);
+}
+
+static void *worker_thread(void *arg)
+{
+    struct threadpool *s = arg;
+
+    ngli_thread_set_name("ngl-pool");
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->stop && s->next_job == s->nb_jobs)
+            pthread_cond_wait(&s->cond_job, &s->lock);
+        if (s->stop)
+            break;
+        run_next_job(s);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+static void stop_workers(struct threadpool *s, size_t nb_workers)
+{
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->cond_job);
+    pthread_mutex_unlock(&s->lock);
+
+    for (size_t i = 0; i < nb_workers; i++)
+        pthread_join(s->threads[i], NULL);
+}
+
+struct threadpool *ngli_threadpool_create(size_t nb_threads)
+{
+    if (!nb_threads)
+        return NULL;
+
+    struct threadpool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->nb_threads = nb_threads - 1;
+    s->threads = ngli_calloc(NGLI_MAX(s->nb_threads, 1), sizeof(*s->threads));
+    if (!s->threads) {
+        ngli_free(s);
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->cond_job, NULL) ||
+        pthread_cond_init(&s->cond_done, NULL)) {
+        pthread_cond_destroy(&s->cond_job);
+        pthread_cond_destroy(&s->cond_done);
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s->threads);
+        ngli_free(s);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < s->nb_threads; i++) {
+        if (pthread_create(&s->threads[i], NULL, worker_thread, s)) {
+            LOG(ERROR, "could not create thread pool worker %zu/%zu", i + 1, s->nb_threads);
+            stop_workers(s, i);
+            s->nb_threads = 0;
+            ngli_threadpool_freep(&s);
+            return NULL;
+        }
+    }
+
+    return s;
+}
+
+int ngli_threadpool_run(struct threadpool *s, threadpool_job_func job_func, void *user_arg, size_t nb_jobs)
+{
+    if (!nb_jobs)
+        return 0;
+
+    pthread_mutex_lock(&s->lock);
+
+    s->job_func = job_func;
+    s->user_arg = user_arg;
+    s->nb_jobs = nb_jobs;
+    s->next_job = 0;
+    s->nb_jobs_done = 0;
+    s->ret = 0;
+    pthread_cond_broadcast(&s->cond_job);
+
+    while (s->next_job < s->nb_jobs)
+        run_next_job(s);
+    while (s->nb_jobs_done < s->nb_jobs)
+        pthread_cond_wait(&s->cond_done, &s->lock);
+
+    const int ret = s->ret;
+    s->job_func = NULL;
+    s->user_arg = NULL;
+    s->nb_jobs = s->next_job = 0;
+
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
+void ngli_threadpool_freep(struct threadpool **sp)
+{
+    struct threadpool *s = *sp;
+    if (!s)
+        return;
+
+    stop_workers(s, s->nb_threads);
+
+    pthread_cond_destroy(&s->cond_job);
+    pthread_cond_destroy(&s->cond_done);
+    pthread_mutex_destroy(&s->lock);
+    ngli_free(s->threads);
+    ngli_freep(sp);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stddef.h>
+
+/*
+ * Fixed size pool of threads executing batches of independent jobs.
+ *
+ * The thread submitting a batch participates in its execution and only
+ * returns once every job of the batch is completed. Jobs are picked one by one
+ * from a shared counter so that a thread done with a cheap job immediately
+ * moves on to the next one, which balances the load between jobs of uneven
+ * cost.
+ */
+
+typedef int (*threadpool_job_func)(void *user_arg, size_t index);
+
+struct threadpool;
+
+/*
+ * Create a pool where nb_threads is the total number of threads running the
+ * jobs, including the calling one.
+ */
+struct threadpool *ngli_threadpool_create(size_t nb_threads);
+
+/*
+ * Execute job_func(user_arg, i) for every i in [0, nb_jobs[ and wait for
+ * completion. Return the first error raised by a job, if any.
+ */
+int ngli_threadpool_run(struct threadpool *s, threadpool_job_func job_func, void *user_arg, size_t nb_jobs);
+
+void ngli_threadpool_freep(struct threadpool **sp);
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "timeindex.h"
+
+size_t ngli_timeindex_search_f64(const double *times, size_t nb_times, size_t hint, double t)
+{
+#define GET_TIME(i) times[i]
+    size_t ret;
+    NGLI_TIMEINDEX_SEARCH(ret, GET_TIME, nb_times, hint, t);
+    return ret;
+}
+
+size_t ngli_timeindex_search_i64(const int64_t *times, size_t nb_times, size_t hint, int64_t t)
+{
+    size_t ret;
+    NGLI_TIMEINDEX_SEARCH(ret, GET_TIME, nb_times, hint, t);
+    return ret;
+#undef GET_TIME
+}
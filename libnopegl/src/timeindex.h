@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 Nope Project
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lookup in a monotonically increasing sequence of times.
+ *
+ * The result is the index of the last time lower or equal to t, or SIZE_MAX
+ * if t is before the first time or is NaN. The lookup starts from a hint
+ * index, typically the result of the previous lookup: the neighbourhood of the
+ * hint is probed first with an exponential (galloping) search which is then
+ * refined with a binary search. Playing forward or backward is O(1) while a
+ * random seek is O(log(distance to the hint)).
+ *
+ * NGLI_TIMEINDEX_SEARCH() is the generic implementation where get_time(i) is
+ * an expression evaluating to the i-th time; it is meant for sequences which
+ * are not stored as plain arrays (such as the times of keyframe nodes).
+ */
+#define NGLI_TIMEINDEX_SEARCH(ret, get_time, nb_times, hint, t) do {            \
+    const size_t nb_ = (nb_times);                                              \
+    if (!nb_ || !((t) >= get_time(0))) { /* also catches t=NaN */               \
+        (ret) = SIZE_MAX;                                                       \
+        break;                                                                  \
+    }                                                                           \
+                                                                                \
+    /* Find lo and hi such as time(lo) <= t < time(hi) (hi=nb: +inf) */         \
+    size_t lo_, hi_, step_ = 1;                                                 \
+    const size_t hint_ = (hint) < nb_ ? (hint) : nb_ - 1;                       \
+    if (get_time(hint_) <= (t)) {                                               \
+        lo_ = hint_;                                                            \
+        hi_ = lo_ + 1;                                                          \
+        while (hi_ < nb_ && get_time(hi_) <= (t)) {                             \
+            lo_ = hi_;                                                          \
+            step_ *= 2;                                                         \
+            hi_ = step_ < nb_ - lo_ ? lo_ + step_ : nb_;                        \
+        }                                                                       \
+    } else {                                                                    \
+        /* hint > 0 since time(0) <= t < time(hint) */                          \
+        hi_ = hint_;                                                            \
+        lo_ = hi_ - 1;                                                          \
+        while (get_time(lo_) > (t)) {                                           \
+            hi_ = lo_;                                                          \
+            step_ *= 2;                                                         \
+            lo_ = step_ < hi_ ? hi_ - step_ : 0;                                \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    while (hi_ - lo_ > 1) {                                                     \
+        const size_t mid_ = lo_ + (hi_ - lo_) / 2;                              \
+        if (get_time(mid_) <= (t))                                              \
+            lo_ = mid_;                                                         \
+        else                                                                    \
+            hi_ = mid_;                                                         \
+    }                                                                           \
+    (ret) = lo_;                                                                \
+} while (0)
+
+size_t ngli_timeindex_search_f64(const double *times, size_t nb_times, size_t hint, double t);
+size_t ngli_timeindex_search_i64(const int64_t *times, size_t nb_times, size_t hint, int64_t t);
+
+#endif
@@ -82,3 +82,18 @@ void ngli_transform_draw(struct ngl_node *node)
     ngli_node_draw(child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
+
+int ngli_transform_record(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct transform *s = node->priv_data;
+
+    int ret = ngli_drawlist_push_transform(drawlist, node, s->matrix);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_node_record(s->child, drawlist);
+    if (ret < 0)
+        return ret;
+
+    return ngli_drawlist_pop(drawlist);
+}
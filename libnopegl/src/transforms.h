@@ -27,5 +27,6 @@
 int ngli_transform_chain_check(const struct ngl_node *node);
 void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix);
 void ngli_transform_draw(struct ngl_node *node);
+int ngli_transform_record(struct ngl_node *node, struct drawlist *drawlist);
 
 #endif
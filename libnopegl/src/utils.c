@@ -168,6 +168,21 @@ uint32_t ngli_crc32_mem(const uint8_t *buf, size_t size)
     return ~crc;
 }
 
+/* 64-bit FNV-1a */
+uint64_t ngli_hash64_update(uint64_t hash, const uint8_t *buf, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        hash ^= buf[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+uint64_t ngli_hash64_mem(const uint8_t *buf, size_t size)
+{
+    return ngli_hash64_update(NGLI_HASH64_INIT, buf, size);
+}
+
 void ngli_thread_set_name(const char *name)
 {
 #if defined(__APPLE__)
@@ -257,10 +272,20 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
 {
     struct ngl_config tmp = *src;
 
+    tmp.backend_config = NULL;
+    tmp.hud_export_filename = NULL;
+    tmp.cache_dir = NULL;
+
     if (src->hud_export_filename) {
         tmp.hud_export_filename = ngli_strdup(src->hud_export_filename);
         if (!tmp.hud_export_filename)
-            return NGL_ERROR_MEMORY;
+            goto fail_memory;
+    }
+
+    if (src->cache_dir) {
+        tmp.cache_dir = ngli_strdup(src->cache_dir);
+        if (!tmp.cache_dir)
+            goto fail_memory;
     }
 
     if (src->backend_config) {
@@ -268,12 +293,10 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
             src->backend == NGL_BACKEND_OPENGLES) {
             const size_t size = sizeof(struct ngl_config_gl);
             tmp.backend_config = ngli_memdup(src->backend_config, size);
-            if (!tmp.backend_config) {
-                ngli_freep(&tmp.hud_export_filename);
-                return NGL_ERROR_MEMORY;
-            }
+            if (!tmp.backend_config)
+                goto fail_memory;
         } else {
-            ngli_freep(&tmp.hud_export_filename);
+            ngli_config_reset(&tmp);
             LOG(ERROR, "backend_config %p is not supported by backend %d",
                 src->backend_config, src->backend);
             return NGL_ERROR_UNSUPPORTED;
@@ -283,11 +306,16 @@ int ngli_config_copy(struct ngl_config *dst, const struct ngl_config *src)
     *dst = tmp;
 
     return 0;
+
+fail_memory:
+    ngli_config_reset(&tmp);
+    return NGL_ERROR_MEMORY;
 }
 
 void ngli_config_reset(struct ngl_config *config)
 {
     ngli_freep(&config->backend_config);
     ngli_freep(&config->hud_export_filename);
+    ngli_freep(&config->cache_dir);
     memset(config, 0, sizeof(*config));
 }
@@ -111,11 +111,15 @@
 
 #define NGLI_HAS_ALL_FLAGS(a, b) (((a) & (b)) == (b))
 
+#define NGLI_HASH64_INIT 0xcbf29ce484222325
+
 char *ngli_strdup(const char *s);
 int64_t ngli_gettime_relative(void);
 char *ngli_asprintf(const char *fmt, ...) ngli_printf_format(1, 2);
 uint32_t ngli_crc32(const char *s);
 uint32_t ngli_crc32_mem(const uint8_t *s, size_t size);
+uint64_t ngli_hash64_update(uint64_t hash, const uint8_t *s, size_t size);
+uint64_t ngli_hash64_mem(const uint8_t *s, size_t size);
 void ngli_thread_set_name(const char *name);
 int ngli_get_filesize(const char *name, int64_t *size);
 char *ngli_numbered_lines(const char *s);
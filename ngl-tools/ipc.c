@@ -83,6 +83,11 @@ int ipc_pkt_add_qtag_scene(struct ipc_pkt *pkt, const char *scene)
     return pack(pkt, IPC_SCENE, scene, strlen(scene) + 1);
 }
 
+int ipc_pkt_add_qtag_scene_patch(struct ipc_pkt *pkt, const char *patch)
+{
+    return pack(pkt, IPC_SCENE_PATCH, patch, strlen(patch) + 1);
+}
+
 int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename)
 {
     return pack(pkt, IPC_FILE, filename, strlen(filename) + 1);
@@ -31,6 +31,7 @@
 
 enum ipc_tag {
     IPC_SCENE        = IPC_U32('s','c','n','e'),
+    IPC_SCENE_PATCH  = IPC_U32('s','p','c','h'),
     IPC_FILE         = IPC_U32('f','i','l','e'),
     IPC_FILEPART     = IPC_U32('f','p','r','t'),
     IPC_FILEEND      = IPC_U32('f','e','n','d'),
@@ -51,6 +52,7 @@ void ipc_pkt_freep(struct ipc_pkt **pktp);
 
 /* Query tags */
 int ipc_pkt_add_qtag_scene(struct ipc_pkt *pkt, const char *scene);
+int ipc_pkt_add_qtag_scene_patch(struct ipc_pkt *pkt, const char *patch);
 int ipc_pkt_add_qtag_file(struct ipc_pkt *pkt, const char *filename);
 int ipc_pkt_add_qtag_filepart(struct ipc_pkt *pkt, const uint8_t *chunk, size_t chunk_size);
 int ipc_pkt_add_qtag_clearcolor(struct ipc_pkt *pkt, const float *clearcolor);
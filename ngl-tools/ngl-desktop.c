@@ -156,6 +156,14 @@ static int handle_tag_scene(const uint8_t *data, int size)
     return send_player_signal(PLAYER_SIGNAL_SCENE, scene, size);
 }
 
+static int handle_tag_scene_patch(const uint8_t *data, int size)
+{
+    if (size < 1 || data[size - 1] != 0) // check if string is nul-terminated
+        return NGL_ERROR_INVALID_DATA;
+    const char *patch = (const char *)data;
+    return send_player_signal(PLAYER_SIGNAL_SCENE_PATCH, patch, size);
+}
+
 static int file_exists(const char *filename)
 {
     FILE *file = fopen(filename, "r");
@@ -339,6 +347,7 @@ static int handle_commands(struct ctx *s, int fd)
             int ret;
             switch (tag) {
             case IPC_SCENE:        ret = handle_tag_scene(data, size);        break;
+            case IPC_SCENE_PATCH:  ret = handle_tag_scene_patch(data, size);  break;
             case IPC_FILE:         ret = handle_tag_file(s, data, size);      break;
             case IPC_FILEPART:     ret = handle_tag_filepart(s, data, size);  break;
             case IPC_CLEARCOLOR:   ret = handle_tag_clearcolor(data, size);   break;
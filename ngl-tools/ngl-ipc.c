@@ -50,6 +50,7 @@ struct ctx {
     const char *host;
     const char *port;
     const char *scene;
+    const char *scene_patch;
     int show_info;
     const char *uploadfile;
     float clear_color[4];
@@ -69,6 +70,7 @@ static const struct opt options[] = {
     {"-x", "--host",          OPT_TYPE_STR,      .offset=OFFSET(host)},
     {"-p", "--port",          OPT_TYPE_STR,      .offset=OFFSET(port)},
     {"-f", "--scene",         OPT_TYPE_STR,      .offset=OFFSET(scene)},
+    {"-P", "--scene-patch",   OPT_TYPE_STR,      .offset=OFFSET(scene_patch)},
     {"-?", "--info",          OPT_TYPE_TOGGLE,   .offset=OFFSET(show_info)},
     {"-u", "--uploadfile",    OPT_TYPE_STR,      .offset=OFFSET(uploadfile)},
     {"-c", "--clearcolor",    OPT_TYPE_COLOR,    .offset=OFFSET(clear_color)},
@@ -114,6 +116,16 @@ static int craft_packet(struct ctx *s, struct ipc_pkt *pkt)
             return ret;
     }
 
+    if (s->scene_patch) {
+        char *patch = get_text_file_content(strcmp(s->scene_patch, "-") ? s->scene_patch : NULL);
+        if (!patch)
+            return -1;
+        int ret = ipc_pkt_add_qtag_scene_patch(pkt, patch);
+        free(patch);
+        if (ret < 0)
+            return ret;
+    }
+
     if (s->uploadfile) {
         char name[512];
         const size_t name_len = strcspn(s->uploadfile, "=");
@@ -44,21 +44,43 @@
 
 static struct ngl_scene *get_scene(const char *filename)
 {
-    char *buf = get_text_file_content(filename);
-    if (!buf)
-        return NULL;
     struct ngl_scene *scene = ngl_scene_create();
-    if (!scene) {
-        free(buf);
+    if (!scene)
         return NULL;
+
+    int ret;
+    if (filename) {
+        ret = ngl_scene_init_from_file(scene, filename);
+    } else {
+        char *buf = get_text_file_content(NULL);
+        if (!buf) {
+            ngl_scene_freep(&scene);
+            return NULL;
+        }
+        ret = ngl_scene_init_from_str(scene, buf);
+        free(buf);
     }
-    int ret = ngl_scene_init_from_str(scene, buf);
-    free(buf);
     if (ret < 0)
         ngl_scene_freep(&scene);
     return scene;
 }
 
+static int write_capture(struct ngl_ctx *ctx, int fd, uint64_t ticket, size_t size)
+{
+    const uint8_t *data;
+    int ret = ngl_capture_acquire(ctx, ticket, &data);
+    if (ret < 0)
+        return ret;
+
+    const size_t n = write(fd, data, size);
+    if (n != size) {
+        fprintf(stderr, "unable to write capture buffer to output\n");
+        return NGL_ERROR_IO;
+    }
+
+    return 0;
+}
+
 struct range {
     float start;
     float duration;
@@ -112,6 +134,7 @@ static const struct opt options[] = {
     {"-z", "--swap_interval", OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
     {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-k", "--cache_dir",     OPT_TYPE_STR,      .offset=OFFSET(cfg.cache_dir)},
 };
 
 int main(int argc, char *argv[])
@@ -160,6 +183,12 @@ int main(int argc, char *argv[])
     uint8_t *capture_buffer = NULL;
     const size_t capture_buffer_size = 4 * s.cfg.width * s.cfg.height;
 
+    /*
+     * Offscreen captures are pipelined: frame k is written to the output
+     * while frame k+1 is being rendered
+     */
+    const int async_capture = s.output && s.cfg.offscreen;
+
     struct ngl_scene *scene = get_scene(s.input);
     if (!scene) {
         ret = EXIT_FAILURE;
@@ -182,9 +211,11 @@ int main(int argc, char *argv[])
                 goto end;
             }
         }
-        capture_buffer = calloc(1, capture_buffer_size);
-        if (!capture_buffer)
-            goto end;
+        if (!async_capture) {
+            capture_buffer = calloc(1, capture_buffer_size);
+            if (!capture_buffer)
+                goto end;
+        }
     }
 
     ctx = ngl_create();
@@ -217,23 +248,41 @@ int main(int argc, char *argv[])
 
     for (size_t i = 0; i < s.nb_ranges; i++) {
         size_t k = 0;
+        uint64_t ticket = 0;
         const struct range *r = &s.ranges[i];
-        const float t0 = r->start;
-        const float t1 = r->start + r->duration;
+        const double t0 = r->start;
+        const double t1 = r->start + r->duration;
+        const double dt = 1. / r->freq;
+
+        /* Let the nodes work ahead (such as decoding the upcoming media frames) */
+        ret = ngl_hint_timeline(ctx, t0, dt, (int32_t)(r->duration * r->freq) + 1);
+        if (ret < 0)
+            goto end;
 
         const int64_t start = gettime_relative();
 
         for (;;) {
-            const float t = t0 + (float)k / (float)r->freq;
+            const double t = t0 + k * dt;
             if (t >= t1)
                 break;
             if (s.debug)
                 printf("draw @ t=%f [range %zu/%zu: %g-%g @ %dHz]\n",
                        t, i + 1, s.nb_ranges, t0, t1, r->freq);
-            ret = ngl_draw(ctx, t);
-            if (ret < 0) {
-                fprintf(stderr, "Unable to draw @ t=%g\n", t);
-                goto end;
+            if (async_capture) {
+                const uint64_t prev_ticket = ticket;
+                ret = ngl_draw_async(ctx, t, &ticket);
+                if (ret < 0) {
+                    fprintf(stderr, "Unable to draw @ t=%g\n", t);
+                    goto end;
+                }
+                if (k > 0 && (ret = write_capture(ctx, fd, prev_ticket, capture_buffer_size)) < 0)
+                    goto end;
+            } else {
+                ret = ngl_draw(ctx, t);
+                if (ret < 0) {
+                    fprintf(stderr, "Unable to draw @ t=%g\n", t);
+                    goto end;
+                }
             }
             if (capture_buffer) {
                 const size_t n = write(fd, capture_buffer, capture_buffer_size);
@@ -251,6 +300,9 @@ int main(int argc, char *argv[])
             k++;
         }
 
+        if (async_capture && k > 0 && (ret = write_capture(ctx, fd, ticket, capture_buffer_size)) < 0)
+            goto end;
+
         const double tdiff = (double)(gettime_relative() - start) / 1000000.;
         printf("Rendered %zu frames in %g (FPS=%g)\n", k, tdiff, (double)k / tdiff);
     }
@@ -54,36 +54,45 @@ int main(int argc, char *argv[])
 {
     int ret = 0;
 
-    if (argc != 4) {
-        fprintf(stderr, "Usage: %s <module> <scene_func> <output.ngl>\n", argv[0]);
+    const int binary = argc == 5 && !strcmp(argv[1], "-b");
+    if (argc != 4 && !binary) {
+        fprintf(stderr, "Usage: %s [-b] <module> <scene_func> <output.ngl>\n", argv[0]);
         return 0;
     }
+    argv += binary;
 
     FILE *of = open_ofile(argv[3]);
     if (!of)
         return EXIT_FAILURE;
 
+    void *serialized_scene = NULL;
     struct ngl_scene *scene = python_get_scene(argv[1], argv[2]);
     if (!scene) {
         ret = EXIT_FAILURE;
         goto end;
     }
 
-    char *serialized_scene = ngl_scene_serialize(scene);
+    size_t size;
+    if (binary) {
+        serialized_scene = ngl_scene_serialize_binary(scene, &size);
+    } else {
+        serialized_scene = ngl_scene_serialize(scene);
+        size = serialized_scene ? strlen(serialized_scene) : 0;
+    }
     ngl_scene_freep(&scene);
     if (!serialized_scene) {
         ret = EXIT_FAILURE;
         goto end;
     }
 
-    const size_t slen = strlen(serialized_scene);
-    const size_t n = fwrite(serialized_scene, 1, slen, of);
-    if (n != slen) {
+    const size_t n = fwrite(serialized_scene, 1, size, of);
+    if (n != size) {
         ret = EXIT_FAILURE;
         goto end;
     }
 
 end:
+    free(serialized_scene);
     if (of)
         fclose(of);
 
@@ -415,16 +415,30 @@ static int set_aspect_ratio(struct player *p, const int32_t *aspect)
     return 0;
 }
 
+static int update_scene_metadata(struct player *p, const struct ngl_scene *scene)
+{
+    int ret;
+    if ((ret = set_duration(p, scene->duration)) < 0 ||
+        (ret = set_framerate(p, scene->framerate)) < 0 ||
+        (ret = set_aspect_ratio(p, scene->aspect_ratio)) < 0)
+        return ret;
+    return 0;
+}
+
 static int set_scene(struct player *p, struct ngl_scene *scene)
 {
     int ret;
 
     if (p->enable_ui) {
+        struct ngl_node *root = scene->root;
         scene->root = add_progress_bar(p, scene);
-        if (!scene->root)
+        if (!scene->root) {
+            scene->root = root;
             return NGL_ERROR_MEMORY;
+        }
         ret = ngl_set_scene(p->ngl, scene);
         ngl_node_unrefp(&scene->root);
+        scene->root = root;
     } else {
         ret = ngl_set_scene(p->ngl, scene);
     }
@@ -434,12 +448,7 @@ static int set_scene(struct player *p, struct ngl_scene *scene)
         p->pgbar_text_node     = NULL;
     }
 
-    if ((ret = set_duration(p, scene->duration)) < 0 ||
-        (ret = set_framerate(p, scene->framerate)) < 0 ||
-        (ret = set_aspect_ratio(p, scene->aspect_ratio)) < 0)
-        return ret;
-
-    return 0;
+    return update_scene_metadata(p, scene);
 }
 
 int player_init(struct player *p, const char *win_title, struct ngl_scene *scene,
@@ -522,6 +531,7 @@ void player_uninit(struct player *p)
             free(event.user.data1);
 
     ngl_freep(&p->ngl);
+    ngl_scene_freep(&p->scene);
     SDL_DestroyWindow(p->window);
     SDL_Quit();
 }
@@ -535,11 +545,70 @@ static int handle_scene(struct player *p, const void *data)
     if (ret < 0)
         goto end;
     ret = set_scene(p, scene);
+    if (ret < 0)
+        goto end;
+    ngl_scene_freep(&p->scene);
+    p->scene = scene;
+    return 0;
+end:
+    ngl_scene_freep(&scene);
+    return ret;
+}
+
+static int apply_patch_on_copy(struct player *p, const void *data)
+{
+    char *str = ngl_scene_serialize(p->scene);
+    if (!str)
+        return NGL_ERROR_MEMORY;
+
+    struct ngl_scene *scene = ngl_scene_create();
+    if (!scene) {
+        free(str);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = ngl_scene_init_from_str(scene, str);
+    free(str);
+    if (ret < 0)
+        goto end;
+    ret = ngl_scene_apply_patch(scene, data);
+    if (ret < 0)
+        goto end;
+    ret = set_scene(p, scene);
+    if (ret < 0)
+        goto end;
+    ngl_scene_freep(&p->scene);
+    p->scene = scene;
+    return 0;
 end:
     ngl_scene_freep(&scene);
     return ret;
 }
 
+static int handle_scene_patch(struct player *p, const void *data)
+{
+    if (!p->scene || !p->scene->root) {
+        fprintf(stderr, "no scene to apply the patch on\n");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    int ret = ngl_scene_apply_patch(p->scene, data);
+    if (ret == NGL_ERROR_INVALID_USAGE) {
+        /*
+         * The patch contains changes which can not be applied live, such as
+         * a change in the structure of the graph, and it has been rejected
+         * as a whole. It is applied on a copy of the scene, which is not set
+         * on the context, and which replaces the current scene only on
+         * success. The programs are preserved by the context program cache.
+         */
+        return apply_patch_on_copy(p, data);
+    }
+    if (ret < 0)
+        return ret;
+
+    return update_scene_metadata(p, p->scene);
+}
+
 static int handle_clearcolor(struct player *p, const void *data)
 {
     memcpy(p->ngl_config.clear_color, data, sizeof(p->ngl_config.clear_color));
@@ -572,6 +641,7 @@ typedef int (*handle_func)(struct player *p, const void *data);
 
 static const handle_func handle_map[] = {
     [PLAYER_SIGNAL_SCENE]        = handle_scene,
+    [PLAYER_SIGNAL_SCENE_PATCH]  = handle_scene_patch,
     [PLAYER_SIGNAL_CLEARCOLOR]   = handle_clearcolor,
     [PLAYER_SIGNAL_SAMPLES]      = handle_samples,
     [PLAYER_SIGNAL_RECONFIGURE]  = handle_reconfigure,
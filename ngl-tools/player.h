@@ -34,6 +34,7 @@
  */
 enum player_signal {
     PLAYER_SIGNAL_SCENE,
+    PLAYER_SIGNAL_SCENE_PATCH,
     PLAYER_SIGNAL_CLEARCOLOR,
     PLAYER_SIGNAL_SAMPLES,
     PLAYER_SIGNAL_RECONFIGURE,
@@ -51,6 +52,7 @@ struct player {
     int32_t framerate[2];
 
     struct ngl_ctx *ngl;
+    struct ngl_scene *scene; /* last scene received through IPC, target of the patches */
     struct ngl_config ngl_config;
     int64_t clock_off;
     int64_t frame_ts;
@@ -21,7 +21,8 @@
 #
 
 from cpython cimport array
-from libc.stdint cimport int32_t, uint8_t, uint32_t, uintptr_t
+from cpython.bytes cimport PyBytes_FromStringAndSize
+from libc.stdint cimport int32_t, uint8_t, uint32_t, uint64_t, uintptr_t
 from libc.stdlib cimport calloc, free
 from libc.string cimport memset
 
@@ -122,7 +123,10 @@ cdef extern from "nopegl.h":
     ngl_scene *ngl_scene_create()
     int ngl_scene_init_from_node(ngl_scene *s, ngl_node *root)
     int ngl_scene_init_from_str(ngl_scene *s, const char *str)
+    int ngl_scene_init_from_file(ngl_scene *s, const char *filename)
+    int ngl_scene_apply_patch(ngl_scene *s, const char *patch)
     char *ngl_scene_serialize(const ngl_scene *scene)
+    void *ngl_scene_serialize_binary(const ngl_scene *scene, size_t *sizep)
     char *ngl_scene_dot(const ngl_scene *scene)
     void ngl_scene_freep(ngl_scene **sp)
 
@@ -148,11 +152,14 @@ cdef extern from "nopegl.h":
         float clear_color[4]
         void *capture_buffer
         int capture_buffer_type
+        int nb_capture_slots
         int hud
         int hud_measure_window
         int hud_refresh_rate[2]
         const char *hud_export_filename
         int hud_scale
+        const char *cache_dir
+        int nb_update_threads
 
     cdef union ngl_livectl_data:
         float f[4]
@@ -178,6 +185,9 @@ cdef extern from "nopegl.h":
     int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer)
     int ngl_set_scene(ngl_ctx *s, ngl_scene *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_draw_async(ngl_ctx *s, double t, uint64_t *ticketp) nogil
+    int ngl_capture_acquire(ngl_ctx *s, uint64_t ticket, const uint8_t **bufp) nogil
+    int ngl_hint_timeline(ngl_ctx *s, double t0, double dt, int32_t nb_frames)
     char *ngl_dot(ngl_ctx *s, double t) nogil
     int ngl_livectls_get(ngl_scene *scene, size_t *nb_livectlsp, ngl_livectl **livectlsp)
     void ngl_livectls_freep(ngl_livectl **livectlsp)
@@ -555,9 +565,34 @@ cdef class Scene:
         scene.root = _Node(ctx=<uintptr_t>scenep.root)
         return scene
 
+    @classmethod
+    def from_file(cls, const char *filename):
+        scene = cls()
+        cdef uintptr_t sptr = scene.cptr
+        cdef ngl_scene *scenep = <ngl_scene *>sptr
+        cdef int ret = ngl_scene_init_from_file(scenep, filename)
+        if ret < 0:
+            raise Exception(f"unable to load scene from {filename}")
+        scene.root = _Node(ctx=<uintptr_t>scenep.root)
+        return scene
+
+    def apply_patch(self, const char *patch):
+        return ngl_scene_apply_patch(self.ctx, patch)
+
     def serialize(self):
         return _ret_pystr(ngl_scene_serialize(self.ctx))
 
+    def serialize_binary(self):
+        cdef size_t size = 0
+        cdef char *data = <char *>ngl_scene_serialize_binary(self.ctx, &size)
+        if data == NULL:
+            raise MemoryError()
+        try:
+            ret = data[:size]
+        finally:
+            free(data)
+        return ret
+
     def dot(self):
         return _ret_pystr(ngl_scene_dot(self.ctx))
 
@@ -622,11 +657,14 @@ cdef class Config:
         clear_color,
         capture_buffer,
         capture_buffer_type,
+        nb_capture_slots,
         hud,
         hud_measure_window,
         hud_refresh_rate,
         hud_export_filename,
         hud_scale,
+        cache_dir,
+        nb_update_threads,
     ):
         self.config.platform = platform.value
         self.config.backend = backend.value
@@ -649,6 +687,7 @@ cdef class Config:
         if capture_buffer is not None:
             self.config.capture_buffer = <uint8_t *>capture_buffer
         self.config.capture_buffer_type = capture_buffer_type
+        self.config.nb_capture_slots = nb_capture_slots
         self.config.hud = hud
         self.config.hud_measure_window = hud_measure_window
         self.config.hud_refresh_rate[0] = hud_refresh_rate[0]
@@ -656,6 +695,9 @@ cdef class Config:
         if hud_export_filename is not None:
             self.config.hud_export_filename = hud_export_filename
         self.config.hud_scale = hud_scale
+        if cache_dir is not None:
+            self.config.cache_dir = cache_dir
+        self.config.nb_update_threads = nb_update_threads
 
     @property
     def cptr(self):
@@ -665,6 +707,7 @@ cdef class Config:
 cdef class Context:
     cdef ngl_ctx *ctx
     cdef object capture_buffer
+    cdef size_t capture_size
 
     def __cinit__(self):
         self.ctx = ngl_create()
@@ -675,6 +718,7 @@ cdef class Context:
         self.capture_buffer = py_config.capture_buffer
         cdef uintptr_t ptr = py_config.cptr
         cdef ngl_config *configp = <ngl_config *>ptr
+        self.capture_size = configp.width * configp.height * 4
         return ngl_configure(self.ctx, configp)
 
     def resize(self, width, height, viewport=None):
@@ -705,6 +749,23 @@ cdef class Context:
             ret = ngl_draw(self.ctx, t)
         return ret
 
+    def draw_async(self, double t):
+        cdef uint64_t ticket = 0
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t, &ticket)
+        return ret, ticket
+
+    def capture_acquire(self, uint64_t ticket):
+        cdef const uint8_t *buf = NULL
+        with nogil:
+            ret = ngl_capture_acquire(self.ctx, ticket, &buf)
+        if ret < 0:
+            return ret, None
+        return ret, bytearray(PyBytes_FromStringAndSize(<const char *>buf, self.capture_size))
+
+    def hint_timeline(self, double t0, double dt, int32_t nb_frames):
+        return ngl_hint_timeline(self.ctx, t0, dt, nb_frames)
+
     def dot(self, double t):
         cdef char *s
         with nogil:
@@ -114,11 +114,14 @@ class Config(_ngl.Config):
         clear_color: Tuple[float, float, float, float] = (0.0, 0.0, 0.0, 1.0),
         capture_buffer: Optional[bytearray] = None,
         # capture_buffer_type: int = 0,
+        nb_capture_slots: int = 0,
         hud: bool = False,
         hud_measure_window: int = 0,
         hud_refresh_rate: Tuple[int, int] = (0, 0),
         hud_export_filename: Optional[str] = None,
         hud_scale: int = 0,
+        cache_dir: Optional[str] = None,
+        nb_update_threads: int = 0,
     ):
         self.capture_buffer = capture_buffer
         super().__init__(
@@ -137,11 +140,14 @@ class Config(_ngl.Config):
             clear_color,
             capture_buffer,
             0,
+            nb_capture_slots,
             hud,
             hud_measure_window,
             hud_refresh_rate,
             hud_export_filename,
             hud_scale,
+            cache_dir,
+            nb_update_threads,
         )
 
 
@@ -222,9 +228,19 @@ class Scene(_ngl.Scene):
     def from_string(cls, s: str):
         return super().from_string(s)
 
+    @classmethod
+    def from_file(cls, filename: str):
+        return super().from_file(filename)
+
+    def apply_patch(self, patch: str) -> int:
+        return super().apply_patch(patch)
+
     def serialize(self) -> str:
         return super().serialize()
 
+    def serialize_binary(self) -> bytes:
+        return super().serialize_binary()
+
     def dot(self) -> str:
         return super().dot()
 
@@ -250,6 +266,15 @@ class Context(_ngl.Context):
     def draw(self, t: float) -> int:
         return super().draw(t)
 
+    def draw_async(self, t: float) -> Tuple[int, int]:
+        return super().draw_async(t)
+
+    def capture_acquire(self, ticket: int) -> Tuple[int, Optional[bytearray]]:
+        return super().capture_acquire(ticket)
+
+    def hint_timeline(self, t0: float, dt: float, nb_frames: int) -> int:
+        return super().hint_timeline(t0, dt, nb_frames)
+
     def dot(self, t: float) -> Optional[str]:
         return super().dot(t)
 
@@ -19,6 +19,7 @@
 # under the License.
 #
 
+import array
 import atexit
 import csv
 import locale
@@ -26,11 +27,13 @@ import math
 import os
 import pprint
 import random
+import struct
+import subprocess
 import tempfile
 from collections import namedtuple
 from pathlib import Path
 
-from pynopegl_utils.misc import get_backend
+from pynopegl_utils.misc import SceneCfg, get_backend
 from pynopegl_utils.toolbox.grid import autogrid_simple
 
 import pynopegl as ngl
@@ -135,6 +138,65 @@ def api_capture_buffer(width=16, height=16):
     del ctx
 
 
+def _get_capture_async_scene():
+    animkf = [
+        ngl.AnimKeyFrameVec3(0, (1, 0, 0)),
+        ngl.AnimKeyFrameVec3(1, (0, 1, 0)),
+        ngl.AnimKeyFrameVec3(2, (0, 0, 1)),
+    ]
+    return ngl.Scene.from_params(ngl.RenderColor(color=ngl.AnimatedVec3(animkf)), duration=2)
+
+
+def api_capture_async(width=16, height=16, nb_capture_slots=3):
+    times = [i / 4 for i in range(9)]
+
+    # Reference captures, made synchronously
+    ctx = ngl.Context()
+    capture_buffer = bytearray(width * height * 4)
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+    assert ctx.set_scene(_get_capture_async_scene()) == 0
+    refs = []
+    for t in times:
+        assert ctx.draw(t) == 0
+        refs.append(bytes(capture_buffer))
+    del ctx
+
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, nb_capture_slots=nb_capture_slots)
+    )
+    assert ret == 0
+    assert ctx.set_scene(_get_capture_async_scene()) == 0
+
+    # Keep as many frames in flight as there are slots before acquiring them
+    tickets = []
+    for i, t in enumerate(times):
+        ret, ticket = ctx.draw_async(t)
+        assert ret == 0
+        tickets.append(ticket)
+        if i >= nb_capture_slots - 1:
+            acquired_id = i - nb_capture_slots + 1
+            ret, data = ctx.capture_acquire(tickets[acquired_id])
+            assert ret == 0
+            assert data == refs[acquired_id], acquired_id
+    assert tickets == list(range(tickets[0], tickets[0] + len(times)))
+
+    # The last tickets are still available, in any order
+    for i in reversed(range(len(times) - nb_capture_slots, len(times))):
+        ret, data = ctx.capture_acquire(tickets[i])
+        assert ret == 0
+        assert data == refs[i]
+
+    # Stale ticket (its slot has been re-used) and ticket not returned yet
+    for ticket in (tickets[-nb_capture_slots - 1], tickets[-1] + 1):
+        ret, data = ctx.capture_acquire(ticket)
+        assert _ret_to_fourcc(ret) == "Earg"  # Invalid argument
+        assert data is None
+
+
 def api_ctx_ownership():
     ctx = ngl.Context()
     ctx2 = ngl.Context()
@@ -290,6 +352,115 @@ def api_media_sharing_failure():
     assert _ret_to_fourcc(ctx.set_scene(scene)) == "Eusg"  # Usage error
 
 
+def _render_media_frames(times, prefetch_frames=0, hint=None, time_anim=None, width=16, height=16):
+    m0 = SceneCfg().medias[0]
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+    m = ngl.Media(m0.filename, prefetch_frames=prefetch_frames, time_anim=time_anim)
+    scene = ngl.Scene.from_params(ngl.RenderTexture(ngl.Texture2D(data_src=m)), duration=m0.duration)
+    assert ctx.set_scene(scene) == 0
+    if hint is not None:
+        assert ctx.hint_timeline(*hint) == 0
+    frames = []
+    for t in times:
+        capture_buffer = bytearray(width * height * 4)
+        assert ctx.set_capture_buffer(capture_buffer) == 0
+        assert ctx.draw(t) == 0
+        frames.append(capture_buffer)
+    del ctx
+    return frames
+
+
+def _check_media_prefetch(hint_offset=None, time_anim=None, t0=0.5, dt=1 / 60, nb_frames=30):
+    """
+    Compare the frames drawn with Media.prefetch_frames against the ones
+    drawn synchronously. The hint, if any, is shifted by hint_offset from the
+    actual draw times so that it is only honored when the offset is 0.
+    """
+    times = [t0 + i * dt for i in range(nb_frames)]
+    hint = None if hint_offset is None else (t0 + hint_offset, dt, nb_frames)
+    ref_frames = _render_media_frames(times, time_anim=time_anim)
+    out_frames = _render_media_frames(times, prefetch_frames=3, hint=hint, time_anim=time_anim)
+    for i, (ref_frame, out_frame) in enumerate(zip(ref_frames, out_frames)):
+        assert ref_frame == out_frame, f"frame {i} at t={times[i]} differs from the non-prefetched output"
+
+
+def api_media_prefetch():
+    _check_media_prefetch(hint_offset=0)
+
+
+def api_media_prefetch_no_hint():
+    _check_media_prefetch()
+
+
+def api_media_prefetch_mismatched_hint():
+    _check_media_prefetch(hint_offset=1 / 120)
+
+
+def api_media_prefetch_remapped():
+    animkf = [
+        ngl.AnimKeyFrameFloat(0, 0.25),
+        ngl.AnimKeyFrameFloat(1, 2.25),
+    ]
+    _check_media_prefetch(hint_offset=0, time_anim=ngl.AnimatedTime(animkf))
+
+
+def _get_hdr_media(transfer, size):
+    """Generate a 10-bit BT.2020 clip using the specified transfer characteristic"""
+    fd, path = tempfile.mkstemp(suffix=".mkv", prefix="ngl-test-hdr-")
+    os.close(fd)
+    atexit.register(lambda: os.remove(path))
+    # fmt: off
+    cmd = [
+        "ffmpeg", "-nostdin", "-y",
+        "-f", "lavfi", "-i", f"testsrc2=size={size}x{size}:duration=1:rate=25",
+        "-vf", "format=yuv420p10le",
+        "-color_primaries", "bt2020", "-color_trc", transfer, "-colorspace", "bt2020nc", "-color_range", "tv",
+        "-c:v", "ffv1", path,
+    ]
+    # fmt: on
+    subprocess.run(cmd, check=True, capture_output=True)
+    return path
+
+
+def _render_hdr_frame(filename, direct_rendering, size):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=size, height=size, backend=_backend))
+    assert ret == 0
+    texture = ngl.Texture2D(data_src=ngl.Media(filename), direct_rendering=direct_rendering)
+    scene = ngl.Scene.from_params(ngl.RenderTexture(texture))
+    assert ctx.set_scene(scene) == 0
+    capture_buffer = bytearray(size * size * 4)
+    assert ctx.set_capture_buffer(capture_buffer) == 0
+    assert ctx.draw(0) == 0
+    del ctx
+    return capture_buffer
+
+
+def _check_hdr_tonemapping(transfer, size=64):
+    """
+    Compare the HDR to SDR conversion fused into ngl_texvideo() against the
+    intermediate hwconv pass used when direct rendering is disabled. The
+    frame is rendered at its native size so that both paths sample the
+    planes at the same positions.
+    """
+    filename = _get_hdr_media(transfer, size)
+    fused = _render_hdr_frame(filename, True, size)
+    hwconv = _render_hdr_frame(filename, False, size)
+    assert len(set(fused)) > 2, "tone mapped frame has no content"
+    diff = max(abs(a - b) for a, b in zip(fused, hwconv))
+    assert diff <= 1, f"fused tone mapping differs from hwconv by {diff}"
+
+
+def api_media_hdr_pq():
+    _check_hdr_tonemapping("smpte2084")
+
+
+def api_media_hdr_hlg():
+    _check_hdr_tonemapping("arib-std-b67")
+
+
 def api_denied_node_live_change(width=320, height=240):
     ctx = ngl.Context()
     ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
@@ -412,6 +583,67 @@ def api_shader_init_fail(width=320, height=240):
     assert ctx.draw(0) == 0
 
 
+def _get_buffer_filename_scene(filename, writable):
+    vertex = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+}
+"""
+    fragment = """
+void main()
+{
+    ngl_out_color = vec4(data[0], data[1], data[2], 1.0);
+}
+"""
+    program = ngl.Program(vertex=vertex, fragment=fragment)
+    if writable:
+        program.update_properties(data=ngl.ResourceProps(writable=True))
+    render = ngl.Render(ngl.Quad(), program)
+    render.update_frag_resources(data=ngl.BufferFloat(filename=filename))
+    return ngl.Scene.from_params(render)
+
+
+def api_buffer_filename_read_only(width=16, height=16):
+    fd, path = tempfile.mkstemp(suffix=".bin", prefix="ngl-test-buffer-")
+    os.write(fd, struct.pack("3f", 1.0, 0.5, 0.0))
+    os.close(fd)
+    atexit.register(lambda: os.remove(path))
+
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+
+    # The file mapping is read-only: a writable usage must be rejected
+    assert ctx.set_scene(_get_buffer_filename_scene(path, writable=True)) != 0
+    assert ctx.set_scene(_get_buffer_filename_scene(path, writable=False)) == 0
+    assert ctx.draw(0) == 0
+
+
+def api_gpu_interpolation_cpu_usage(width=16, height=16):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+
+    def get_animated_buffer():
+        animkf = [
+            ngl.AnimKeyFrameBuffer(0, array.array("f", [0, 0, 0, 1])),
+            ngl.AnimKeyFrameBuffer(1, array.array("f", [1, 1, 1, 1])),
+        ]
+        return ngl.AnimatedBufferVec4(animkf, gpu_interpolation=True)
+
+    # The CPU data of a GPU interpolated buffer is never updated: any CPU
+    # usage of it must be rejected
+    texture = ngl.Texture2D(width=1, height=1, data_src=get_animated_buffer())
+    assert ctx.set_scene(ngl.Scene.from_params(ngl.RenderTexture(texture))) != 0
+    block = ngl.Block(fields=[get_animated_buffer()])
+    render = ngl.Render(ngl.Quad(), ngl.Program(vertex="void main() {}", fragment="void main() {}"))
+    render.update_frag_resources(data=block)
+    assert ctx.set_scene(ngl.Scene.from_params(render)) != 0
+    assert ctx.set_scene(_get_scene()) == 0
+    assert ctx.draw(0) == 0
+
+
 def _create_trf(scene, start, end, prefetch_time=None):
     trf = ngl.TimeRangeFilter(scene, start, end)
     if prefetch_time is not None:
@@ -502,6 +734,161 @@ def api_dot(width=320, height=240):
     assert ctx.dot(1.0) is not None
 
 
+def _f32_str(v):
+    # Same encoding as the serializer: hexadecimal exponent and mantissa
+    i = struct.unpack("<I", struct.pack("<f", v))[0]
+    sign = "-" if i >> 31 else ""
+    return f"{sign}{i >> 23 & 0xFF:X}z{i & 0x7FFFFF:X}"
+
+
+def _f64_str(v):
+    i = struct.unpack("<Q", struct.pack("<d", v))[0]
+    sign = "-" if i >> 63 else ""
+    return f"{sign}{i >> 52 & 0x7FF:X}Z{i & 0xFFFFFFFFFFFFF:X}"
+
+
+def _vec_str(v):
+    return ",".join(_f32_str(x) for x in v)
+
+
+def _get_patch(scene, *lines):
+    header = scene.serialize().decode("ascii").split("\n", 1)[0]
+    return "\n".join((header,) + lines) + "\n"
+
+
+def _get_patch_ctx(width=16, height=16):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+    capture_buffer = bytearray(width * height * 4)
+    assert ctx.set_capture_buffer(capture_buffer) == 0
+    return ctx, capture_buffer
+
+
+def api_scene_patch_live():
+    """
+    Live change parameters and metadata of a scene set on a context
+    """
+    ctx, capture_buffer = _get_patch_ctx()
+    render = ngl.RenderColor(color=(1, 0, 0))
+    scene = ngl.Scene.from_params(ngl.Group(children=(render,)), duration=2)
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+    assert capture_buffer[:4] == bytearray((255, 0, 0, 255))
+
+    # Nodes are addressed relatively to the end of the serialized scene: 0 is
+    # the root group and 1 the render
+    patch = _get_patch(scene, f"# duration={_f64_str(3)}", f"=1 color:{_vec_str((0, 1, 0))} opacity:{_f32_str(1)}")
+    assert scene.apply_patch(patch) == 0
+    assert scene.duration == 3
+    assert ctx.draw(0) == 0
+    assert capture_buffer[:4] == bytearray((0, 255, 0, 255))
+
+
+def api_scene_patch_new_node():
+    """
+    Declare new nodes in a patch and reference them
+    """
+    scene = ngl.Scene.from_params(ngl.Group(children=(ngl.RenderColor(color=(1, 0, 0)),)))
+
+    # The new nodes are appended after the scene nodes. Like in a serialized
+    # scene, a node line references the previous node with 1, while 0 is the
+    # last declared node in a "=<id>" line.
+    patch = _get_patch(
+        scene,
+        f"Rclr color:{_vec_str((0, 0, 1))}",
+        f"Tmov child:1 vector:{_vec_str((0.5, 0, 0))}",
+        "=2 children:0",
+    )
+    assert scene.apply_patch(patch) == 0
+
+    expected = ngl.Scene.from_params(
+        ngl.Group(children=(ngl.Translate(ngl.RenderColor(color=(0, 0, 1)), (0.5, 0, 0)),))
+    )
+    assert scene.serialize() == expected.serialize()
+
+    ctx, capture_buffer = _get_patch_ctx()
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+    assert capture_buffer[-4:] == bytearray((0, 0, 255, 255))
+
+
+def api_scene_patch_relative_ids():
+    """
+    Address every node of a scene with a relative id
+    """
+    colors = ((1, 0, 0), (0, 1, 0), (0, 0, 1))
+
+    def get_scene(colors):
+        return ngl.Scene.from_params(ngl.Group(children=[ngl.RenderColor(color=c) for c in colors]))
+
+    scene = get_scene(colors)
+
+    # The scene nodes are serialized in the children order, followed by the
+    # root: the last child has id 1 and the first one id 3
+    new_colors = ((1, 1, 0), (0, 1, 1), (1, 0, 1))
+    patch = _get_patch(scene, *(f"={3 - i} color:{_vec_str(c)}" for i, c in enumerate(new_colors)))
+    assert scene.apply_patch(patch) == 0
+    assert scene.serialize() == get_scene(new_colors).serialize()
+
+    # A declared node shifts the ids of the scene nodes by one
+    patch = _get_patch(scene, f"Rclr color:{_vec_str((1, 1, 1))}", f"=4 color:{_vec_str(colors[0])}")
+    assert scene.apply_patch(patch) == 0
+    assert scene.serialize() == get_scene(colors[:1] + new_colors[1:]).serialize()
+
+
+def api_scene_patch_structural_change():
+    """
+    A structural change is rejected on a scene set on a context, and can be
+    applied once the scene is unset
+    """
+    ctx, capture_buffer = _get_patch_ctx()
+    scene = ngl.Scene.from_params(ngl.Group(children=(ngl.RenderColor(color=(1, 0, 0)),)))
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+
+    # The live color change preceding the structural change is not applied either
+    patch = _get_patch(scene, f"Rclr color:{_vec_str((0, 0, 1))}", f"=2 color:{_vec_str((0, 1, 0))}", "=1 children:0")
+    assert _ret_to_fourcc(scene.apply_patch(patch)) == "Eusg"  # Usage error
+    assert ctx.draw(0) == 0
+    assert capture_buffer[:4] == bytearray((255, 0, 0, 255))
+
+    assert ctx.set_scene(None) == 0
+    assert scene.apply_patch(patch) == 0
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+    assert capture_buffer[:4] == bytearray((0, 0, 255, 255))
+
+
+def api_scene_patch_malformed():
+    """
+    Malformed patches are rejected without modifying the scene
+    """
+    scene = ngl.Scene.from_params(ngl.Group(children=(ngl.RenderColor(color=(1, 0, 0)),)))
+    serialized = scene.serialize()
+    color = _vec_str((0, 1, 0))
+    patches = (
+        "",
+        f"=1 color:{color}\n",
+        f"# Nope.GL v0.0.0\n=1 color:{color}\n",
+        _get_patch(scene, "# duration"),
+        _get_patch(scene, f"=2 color:{color}"),
+        _get_patch(scene, f"=z color:{color}"),
+        _get_patch(scene, f"=1 nope:{color}"),
+        _get_patch(scene, "Rc"),
+        _get_patch(scene, f"Nope color:{color}"),
+        # Valid changes followed by an invalid one must not be applied either
+        _get_patch(scene, f"=1 color:{color}", f"=1 nope:{color}"),
+        _get_patch(scene, f"# duration={_f64_str(5)}", f"=1 color:{color}", "=1 color:nope"),
+    )
+    for patch in patches:
+        assert scene.apply_patch(patch) < 0, patch
+        assert scene.serialize() == serialized
+
+    # A patch needs a scene with a root
+    assert _ret_to_fourcc(ngl.Scene().apply_patch(_get_patch(scene))) == "Eusg"  # Usage error
+
+
 def api_probing():
     """
     Exercise the probing APIs; the result is platform/hardware specific so
@@ -20,6 +20,7 @@
 #
 
 import array
+import textwrap
 
 from pynopegl_utils.misc import SceneCfg, scene
 from pynopegl_utils.tests.cmp_cuepoints import test_cuepoints
@@ -272,3 +273,112 @@ def rtt_clear_attachment_with_timeranges(cfg: SceneCfg):
     render = ngl.RenderTexture(texture)
 
     return ngl.Group(children=(rtt, render))
+
+
+@test_cuepoints(width=32, height=32, points={"C": (0, 0)}, nb_keyframes=3, tolerance=1)
+@scene()
+def rtt_static(cfg: SceneCfg):
+    cfg.duration = 3
+    cfg.aspect_ratio = (1, 1)
+
+    # Nothing in the RTT branch depends on the time: it is rendered once and
+    # its content must be preserved in the following frames
+    texture = ngl.Texture2D(width=16, height=16)
+    rtt = ngl.RenderToTexture(ngl.RenderColor(COLORS.orange), [texture])
+    return ngl.Group(children=(rtt, ngl.RenderTexture(texture)))
+
+
+@test_cuepoints(width=32, height=32, points={"left": (-0.5, 0), "right": (0.5, 0)}, nb_keyframes=3, tolerance=1)
+@scene()
+def rtt_static_shared_target(cfg: SceneCfg):
+    cfg.duration = 3
+    cfg.aspect_ratio = (1, 1)
+
+    # Two static RTTs rendering into the same texture: each of them overwrites
+    # the content of the other, so they both have to render again every frame
+    texture = ngl.Texture2D(width=16, height=16)
+    rtt0 = ngl.RenderToTexture(ngl.RenderColor(COLORS.red), [texture])
+    rtt1 = ngl.RenderToTexture(ngl.RenderColor(COLORS.green), [texture])
+
+    quad0 = ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0))
+    quad1 = ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0))
+    render0 = ngl.RenderTexture(texture, geometry=quad0)
+    render1 = ngl.RenderTexture(texture, geometry=quad1)
+
+    return ngl.Group(children=(rtt0, render0, rtt1, render1))
+
+
+def _get_rtt_static_live_change_function():
+    colors = [COLORS.red, COLORS.red, COLORS.blue, COLORS.blue]
+    render = ngl.RenderColor(colors[0])
+
+    def keyframes_callback(t_id):
+        render.set_color(*colors[t_id])
+
+    @test_cuepoints(
+        width=32,
+        height=32,
+        points={"C": (0, 0)},
+        nb_keyframes=len(colors),
+        keyframes_callback=keyframes_callback,
+        tolerance=1,
+        exercise_serialization=False,
+    )
+    @scene()
+    def scene_func(cfg: SceneCfg):
+        cfg.duration = len(colors)
+        cfg.aspect_ratio = (1, 1)
+
+        # The RTT branch is static but a live change must trigger a new render
+        texture = ngl.Texture2D(width=16, height=16)
+        rtt = ngl.RenderToTexture(render, [texture])
+        return ngl.Group(children=(rtt, ngl.RenderTexture(texture)))
+
+    return scene_func
+
+
+rtt_static_live_change = _get_rtt_static_live_change_function()
+
+
+_RTT_MEDIA_VERT = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    media_uv = (media_coord_matrix * vec4(ngl_uvcoord, 0.0, 1.0)).xy;
+    rtt_uv = (rtt_coord_matrix * vec4(ngl_uvcoord, 0.0, 1.0)).xy;
+}
+"""
+
+
+_RTT_MEDIA_FRAG = """
+void main()
+{
+    vec3 media_color = ngl_texvideo(media, media_uv).rgb;
+    vec3 rtt_color = ngl_texvideo(rtt, rtt_uv).rgb;
+    bool match = all(lessThan(abs(media_color - rtt_color), vec3(0.05)));
+    ngl_out_color = match ? vec4(0.0, 1.0, 0.0, 1.0) : vec4(1.0, 0.0, 0.0, 1.0);
+}
+"""
+
+
+@test_cuepoints(points={f"P{i}": (i / 5 * 2 - 1 + 0.2, 0) for i in range(5)}, nb_keyframes=5, tolerance=1)
+@scene()
+def rtt_media(cfg: SceneCfg):
+    m0 = cfg.medias[0]
+    cfg.duration = m0.duration
+    cfg.aspect_ratio = (m0.width, m0.height)
+
+    # The RTT branch only depends on the time through the media: its content
+    # must follow the video, which is compared with the media sampled directly
+    media = ngl.Media(m0.filename)
+    media_texture = ngl.Texture2D(data_src=media)
+    rtt_texture = ngl.Texture2D(width=m0.width, height=m0.height)
+    rtt = ngl.RenderToTexture(ngl.RenderTexture(media_texture), [rtt_texture])
+
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=textwrap.dedent(_RTT_MEDIA_VERT), fragment=textwrap.dedent(_RTT_MEDIA_FRAG))
+    program.update_vert_out_vars(media_uv=ngl.IOVec2(), rtt_uv=ngl.IOVec2())
+    render = ngl.Render(quad, program)
+    render.update_frag_resources(media=media_texture, rtt=rtt_texture)
+
+    return ngl.Group(children=(rtt, render))
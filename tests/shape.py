@@ -37,23 +37,19 @@ import pynopegl as ngl
 @scene()
 def shape_precision_iovar(cfg: SceneCfg):
     cfg.aspect_ratio = (1, 1)
-    vert = textwrap.dedent(
-        """\
+    vert = textwrap.dedent("""\
         void main()
         {
             ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
             color = vec4((ngl_out_pos.xy + 1.0) * .5, 1.0 - (ngl_out_pos.x + 1.0) * .5 - (ngl_out_pos.y + 1.0) * .5, 1.0);
         }
-        """
-    )
-    frag = textwrap.dedent(
-        """\
+        """)
+    frag = textwrap.dedent("""\
         void main()
         {
             ngl_out_color = color;
         }
-        """
-    )
+        """)
     program = ngl.Program(vertex=vert, fragment=frag)
     program.update_vert_out_vars(color=ngl.IOVec4(precision_out="high", precision_in="low"))
     geometry = ngl.Quad(corner=(-1, -1, 0), width=(2, 0, 0), height=(0, 2, 0))
@@ -230,28 +226,82 @@ def _get_morphing_coordinates(rng, n, x_off, y_off):
     return coords
 
 
-@test_fingerprint(nb_keyframes=8, tolerance=1)
-@scene(n=scene.Range(range=[2, 50]))
-def shape_morphing(cfg: SceneCfg, n=6):
-    cfg.duration = 5.0
-    vertices_tl = _get_morphing_coordinates(cfg.rng, n, -1, 0)
-    vertices_tr = _get_morphing_coordinates(cfg.rng, n, 0, 0)
-    vertices_bl = _get_morphing_coordinates(cfg.rng, n, -1, -1)
-    vertices_br = _get_morphing_coordinates(cfg.rng, n, 0, -1)
-
-    vertices_animkf = []
-    for i, coords in enumerate(zip(vertices_tl, vertices_tr, vertices_bl, vertices_br)):
-        flat_coords = list(itertools.chain(*coords))
-        coords_array = array.array("f", flat_coords)
-        vertices_animkf.append(ngl.AnimKeyFrameBuffer(i * cfg.duration / (n - 1), coords_array))
-    vertices = ngl.AnimatedBufferVec3(vertices_animkf)
-
-    geom = ngl.Geometry(vertices)
-    geom.set_topology("triangle_strip")
-    p = ngl.Program(vertex=cfg.get_vert("color"), fragment=cfg.get_frag("color"))
-    render = ngl.Render(geom, p)
-    render.update_frag_resources(color=ngl.UniformVec3(COLORS.cyan), opacity=ngl.UniformFloat(1))
-    return render
+def _get_morphing_function(gpu_interpolation=False):
+    @test_fingerprint(nb_keyframes=8, tolerance=1)
+    @scene(n=scene.Range(range=[2, 50]))
+    def morphing(cfg: SceneCfg, n=6):
+        cfg.duration = 5.0
+        vertices_tl = _get_morphing_coordinates(cfg.rng, n, -1, 0)
+        vertices_tr = _get_morphing_coordinates(cfg.rng, n, 0, 0)
+        vertices_bl = _get_morphing_coordinates(cfg.rng, n, -1, -1)
+        vertices_br = _get_morphing_coordinates(cfg.rng, n, 0, -1)
+
+        vertices_animkf = []
+        for i, coords in enumerate(zip(vertices_tl, vertices_tr, vertices_bl, vertices_br)):
+            flat_coords = list(itertools.chain(*coords))
+            coords_array = array.array("f", flat_coords)
+            vertices_animkf.append(ngl.AnimKeyFrameBuffer(i * cfg.duration / (n - 1), coords_array))
+        vertices = ngl.AnimatedBufferVec3(vertices_animkf, gpu_interpolation=gpu_interpolation)
+
+        geom = ngl.Geometry(vertices)
+        geom.set_topology("triangle_strip")
+        p = ngl.Program(vertex=cfg.get_vert("color"), fragment=cfg.get_frag("color"))
+        render = ngl.Render(geom, p)
+        render.update_frag_resources(color=ngl.UniformVec3(COLORS.cyan), opacity=ngl.UniformFloat(1))
+        return render
+
+    return morphing
+
+
+# The GPU interpolated variants must match the CPU ones (same references)
+shape_morphing = _get_morphing_function()
+shape_morphing_gpu = _get_morphing_function(gpu_interpolation=True)
+
+
+_ANIMATED_UVCOORDS_VERT = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    intensity = ngl_uvcoord;
+}
+"""
+
+_ANIMATED_UVCOORDS_FRAG = """
+void main()
+{
+    ngl_out_color = vec4(color * intensity, 1.0);
+}
+"""
+
+
+def _get_animated_uvcoords_function(gpu_interpolation=False):
+    @test_fingerprint(nb_keyframes=8, tolerance=1)
+    @scene()
+    def animated_uvcoords(cfg: SceneCfg):
+        cfg.duration = 4.0
+        cfg.aspect_ratio = (1, 1)
+
+        # One float per vertex of the quad, interpolated between the key frames
+        nb_kf = 4
+        uvcoords_animkf = []
+        for i in range(nb_kf):
+            uvcoords = array.array("f", [cfg.rng.uniform(0, 1) for _ in range(4)])
+            uvcoords_animkf.append(ngl.AnimKeyFrameBuffer(i * cfg.duration / (nb_kf - 1), uvcoords))
+        uvcoords = ngl.AnimatedBufferFloat(uvcoords_animkf, gpu_interpolation=gpu_interpolation)
+
+        vertices = ngl.BufferVec3(data=array.array("f", [-1, -1, 0, 1, -1, 0, -1, 1, 0, 1, 1, 0]))
+        geometry = ngl.Geometry(vertices, uvcoords=uvcoords, topology="triangle_strip")
+        program = ngl.Program(vertex=_ANIMATED_UVCOORDS_VERT, fragment=_ANIMATED_UVCOORDS_FRAG)
+        program.update_vert_out_vars(intensity=ngl.IOFloat())
+        render = ngl.Render(geometry, program)
+        render.update_frag_resources(color=ngl.UniformVec3(COLORS.orange))
+        return render
+
+    return animated_uvcoords
+
+
+shape_animated_uvcoords = _get_animated_uvcoords_function()
+shape_animated_uvcoords_gpu = _get_animated_uvcoords_function(gpu_interpolation=True)
 
 
 def _get_cropboard_function(set_indices=False):
@@ -142,3 +142,24 @@ def text_vertical_japanese(cfg: SceneCfg):
         font_files=_JAPANESE_FONT.as_posix(),
         aspect_ratio=cfg.aspect_ratio,
     )
+
+
+def _get_distance_field_function(scale):
+    @test_fingerprint(tolerance=1)
+    @scene()
+    def distance_field(cfg: SceneCfg):
+        text = ngl.Text(
+            text="Nope",
+            font_files=_LATIN_FONT.as_posix(),
+            distance_field=True,
+            aspect_ratio=cfg.aspect_ratio,
+        )
+        # The glyphs are rasterized once and magnified by the transform: the
+        # edges must remain sharp at any scale
+        return ngl.Scale(text, factors=(scale, scale, 1))
+
+    return distance_field
+
+
+text_distance_field = _get_distance_field_function(1)
+text_distance_field_magnified = _get_distance_field_function(4)
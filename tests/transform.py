@@ -20,8 +20,10 @@
 #
 
 import array
+import textwrap
 
 from pynopegl_utils.misc import SceneCfg, scene
+from pynopegl_utils.tests.cmp_cuepoints import test_cuepoints
 from pynopegl_utils.tests.cmp_fingerprint import test_fingerprint
 from pynopegl_utils.toolbox.colors import COLORS
 from pynopegl_utils.toolbox.shapes import equilateral_triangle_coords
@@ -337,3 +339,86 @@ def transform_smoothpath(cfg: SceneCfg):
     ]
 
     return ngl.Translate(shape, vector=ngl.AnimatedPath(anim_kf, path))
+
+
+def _get_batch_children(cfg: SceneCfg):
+    quad = ngl.Quad((-0.2, -0.2, 0), (0.4, 0, 0), (0, 0.4, 0))
+    circle = ngl.Circle(radius=0.2)
+    texture0 = ngl.Texture2D(
+        width=2, height=2, data_src=ngl.BufferUBVec4(data=array.array("B", [255, 0, 0, 255, 0, 255, 0, 255] * 2))
+    )
+    texture1 = ngl.Texture2D(
+        width=2, height=2, data_src=ngl.BufferUBVec4(data=array.array("B", [0, 0, 255, 255, 255, 255, 0, 255] * 2))
+    )
+    angle = ngl.AnimatedFloat([ngl.AnimKeyFrameFloat(0, 0), ngl.AnimKeyFrameFloat(cfg.duration, 360)])
+
+    return [
+        # Compatible RenderColor leaves behind transform chains
+        ngl.Translate(ngl.RenderColor(COLORS.red, geometry=quad), vector=(0, 0.5, 0)),
+        ngl.Translate(ngl.Scale(ngl.RenderColor(COLORS.green, geometry=quad), factors=(1.5, 0.5, 1)), (0, -0.5, 0)),
+        ngl.Translate(ngl.Rotate(ngl.RenderColor(COLORS.blue, geometry=quad), angle=angle), vector=(-0.5, -0.5, 0)),
+        # Different geometry: breaks the run
+        ngl.Translate(ngl.RenderColor(COLORS.white, geometry=circle), vector=(0.5, -0.5, 0)),
+        # Different blending: runs on its own
+        ngl.Translate(
+            ngl.RenderColor(COLORS.orange, opacity=0.5, blending="src_over", geometry=quad), vector=(0.3, -0.3, 0)
+        ),
+        # Not a batchable leaf
+        ngl.Translate(ngl.RenderGradient(geometry=quad), vector=(-0.3, 0.3, 0)),
+        # Compatible RenderTexture leaves sharing the same texture
+        ngl.Translate(ngl.RenderTexture(texture0, geometry=quad), vector=(-0.5, 0.5, 0)),
+        ngl.Translate(ngl.Rotate(ngl.RenderTexture(texture0, geometry=quad), angle=angle), vector=(-0.5, 0, 0)),
+        # Different texture: starts a new run
+        ngl.Translate(ngl.RenderTexture(texture1, geometry=quad), vector=(0.5, 0.5, 0)),
+        ngl.Translate(ngl.Skew(ngl.RenderTexture(texture1, geometry=quad), angles=(20, 0, 0)), vector=(0.5, 0, 0)),
+    ]
+
+
+_BATCH_CMP_SIZE = 32
+
+_BATCH_CMP_VERT = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+}
+"""
+
+_BATCH_CMP_FRAG = f"""
+void main()
+{{
+    /* Every fragment compares the two textures entirely */
+    bool match = true;
+    for (int y = 0; y < {_BATCH_CMP_SIZE}; y++) {{
+        for (int x = 0; x < {_BATCH_CMP_SIZE}; x++) {{
+            vec2 uv = (vec2(float(x), float(y)) + 0.5) / {_BATCH_CMP_SIZE}.0;
+            vec4 diff = abs(ngl_tex2d(batched, uv) - ngl_tex2d(unbatched, uv));
+            match = match && all(lessThan(diff, vec4(0.01)));
+        }}
+    }}
+    ngl_out_color = match ? vec4(0.0, 1.0, 0.0, 1.0) : vec4(1.0, 0.0, 0.0, 1.0);
+}}
+"""
+
+
+@test_cuepoints(width=16, height=16, points={"match": (-0.5, 0), "content": (0.5, 0.5)}, nb_keyframes=4, tolerance=1)
+@scene()
+def transform_group_batch(cfg: SceneCfg):
+    cfg.duration = 4
+    cfg.aspect_ratio = (1, 1)
+
+    # The same children are rendered with and without batching, each in their
+    # own texture, which are then compared texel by texel
+    size = _BATCH_CMP_SIZE
+    batched = ngl.Texture2D(width=size, height=size, min_filter="nearest", mag_filter="nearest")
+    unbatched = ngl.Texture2D(width=size, height=size, min_filter="nearest", mag_filter="nearest")
+    rtt_batched = ngl.RenderToTexture(ngl.Group(children=_get_batch_children(cfg), batch=True), [batched])
+    rtt_unbatched = ngl.RenderToTexture(ngl.Group(children=_get_batch_children(cfg), batch=False), [unbatched])
+
+    # Left: comparison result, right: the batched rendering, to make sure the
+    # comparison is not made between two empty textures
+    program = ngl.Program(vertex=textwrap.dedent(_BATCH_CMP_VERT), fragment=textwrap.dedent(_BATCH_CMP_FRAG))
+    compare = ngl.Render(ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0)), program)
+    compare.update_frag_resources(batched=batched, unbatched=unbatched)
+    render = ngl.RenderTexture(batched, geometry=ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0)))
+
+    return ngl.Group(children=(rtt_batched, rtt_unbatched, compare, render))